@@ -0,0 +1,182 @@
+//  Copyright (c) 2010-2026 Ritchie Brannan
+//  License: MIT (see LICENSE file in repository root)
+//
+//  SuiteUTF
+//
+//  File:   utf8_decode_bench.cpp
+//  Author: Ritchie Brannan
+//  Date:   16 Oct 26
+//  
+//  Description:
+//  
+//      Benchmark of the per-code-point UTF8 decoders on mixed corpora.
+//  
+//      Four 4MB corpora (ASCII+CJK+emoji, ASCII+Cyrillic+kana+emoji, CJK+emoji and pure ASCII) are decoded one code-point
+//      at a time by:
+//  
+//          branching   the byte-at-a-time decoder getUTF8() used before the state machine (kept here for comparison)
+//          getUTF8     utf::std::getUTF8() (the table-driven state machine)
+//          UTF8st      toolkit::codec<UTF_SUB_TYPE::UTF8st>::get()
+//          handler     the UTF8st IUTFTK handler get() (virtual dispatch)
+//  
+//      The best of 5 runs is reported in milliseconds.
+//  
+//      Build (with the library sources):
+//  
+//          g++ -std=c++17 -O2 -Iinclude bench/utf8_decode_bench.cpp src/utf_toolkit.cpp src/utf_std.cpp src/utf_simd.cpp
+//              src/unicode_utilities.cpp src/unicode_classification.cpp -pthread
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "utf_toolkit.h"
+
+using unicode::unicode_t;
+using unicode::utf::utf_text;
+using namespace unicode::utf::toolkit;
+
+// ==== corpus generation ====
+
+static uint32_t nextRandom(uint32_t& seed, const uint32_t range) noexcept
+{
+    seed = ((seed * 1664525u) + 1013904223u);
+    return ((seed >> 8) % range);
+}
+
+static unicode_t pick(uint32_t& seed, const uint32_t corpus) noexcept
+{
+    const uint32_t roll = nextRandom(seed, 10);
+    switch (corpus)
+    {
+        case(0):    return static_cast<unicode_t>((roll < 4) ? (0x20u + nextRandom(seed, 0x5fu)) : ((roll < 8) ? (0x4e00u + nextRandom(seed, 0x5000u)) : (0x1f600u + nextRandom(seed, 0x50u))));
+        case(1):    return static_cast<unicode_t>((roll < 3) ? (0x20u + nextRandom(seed, 0x5fu)) : ((roll < 5) ? (0x0400u + nextRandom(seed, 0x100u)) : ((roll < 8) ? (0x3040u + nextRandom(seed, 0x60u)) : (0x1f300u + nextRandom(seed, 0x300u)))));
+        case(2):    return static_cast<unicode_t>((roll < 7) ? (0x4e00u + nextRandom(seed, 0x5000u)) : (0x1f300u + nextRandom(seed, 0x300u)));
+        default:    return static_cast<unicode_t>(0x20u + nextRandom(seed, 0x5fu));
+    }
+}
+
+static ::std::vector<uint8_t> generate(const uint32_t corpus, const uint32_t size)
+{
+    ::std::vector<uint8_t> text(size + 8);
+    uint32_t seed = (corpus + 1);
+    uint32_t offset = 0;
+    while (offset < size)
+    {
+        uint32_t bytes = 0;
+        static_cast<void>(unicode::utf::std::setUTF8(&text[offset], 4, pick(seed, corpus), bytes));
+        offset += bytes;
+    }
+    text.resize(offset);
+    return text;
+}
+
+// ==== byte-at-a-time decoder (getUTF8() before the state machine) ====
+
+static bool branchingUTF8(const uint8_t* const buffer, const uint32_t size, unicode_t& unicode, uint32_t& bytes, const bool) noexcept
+{
+    bytes = 1;
+    uint8_t byte = buffer[0];
+    unicode = byte;
+    if (static_cast<uint8_t>(byte + 8) <= 0xc7u)
+    {   //  1 byte or a byte that cannot start a sequence
+        return (byte <= 0x7fu);
+    }
+    uint32_t length = ((byte <= 0xdfu) ? 2 : ((byte <= 0xefu) ? 3 : 4));
+    if (size < length)
+    {
+        return false;
+    }
+    uint32_t value = (byte & (0x7fu >> length));
+    for (uint32_t index = 1; index < length; ++index)
+    {
+        byte = buffer[index];
+        if ((byte & 0xc0u) != 0x80u)
+        {
+            return false;
+        }
+        value = ((value << 6) + (byte & 0x3fu));
+    }
+    static const uint32_t minimum[5] = { 0, 0, 0x00000080u, 0x00000800u, 0x00010000u };
+    if ((value < minimum[length]) || (value > 0x0010ffffu) || ((value & 0xfffff800u) == 0x0000d800u))
+    {
+        return false;
+    }
+    bytes = length;
+    unicode = static_cast<unicode_t>(value);
+    return true;
+}
+
+// ==== timing ====
+
+using quick_decoder = bool (*)(const uint8_t* const, const uint32_t, unicode_t&, uint32_t&, const bool);
+
+static uint32_t decodeQuick(const ::std::vector<uint8_t>& text, const quick_decoder volatile& selected) noexcept
+{   //  both quick decoders are called through the same (volatile) pointer so neither is inlined into the loop
+    const quick_decoder decode = selected;
+    const uint32_t size = static_cast<uint32_t>(text.size());
+    uint32_t sum = 0;
+    unicode_t unicode;
+    uint32_t bytes;
+    for (uint32_t offset = 0; offset < size; offset += bytes)
+    {
+        static_cast<void>(decode(&text[offset], (size - offset), unicode, bytes, false));
+        sum += static_cast<uint32_t>(unicode);
+    }
+    return sum;
+}
+
+template<typename decode_t>
+static double measure(const ::std::vector<uint8_t>& text, decode_t decode, uint32_t& checksum)
+{   //  returns the best of 5 runs in milliseconds
+    double best = 0.0;
+    for (uint32_t run = 0; run < 5; ++run)
+    {
+        const auto start = ::std::chrono::steady_clock::now();
+        checksum = decode(text);
+        const double elapsed = ::std::chrono::duration<double, ::std::milli>(::std::chrono::steady_clock::now() - start).count();
+        best = (((run == 0) || (elapsed < best)) ? elapsed : best);
+    }
+    return best;
+}
+
+int main()
+{
+    static const char* const names[4] = { "ASCII+CJK+emoji", "ASCII+Cyrillic+kana+emoji", "CJK+emoji", "ASCII" };
+    const IUTFTK& handler = IUTFTK::getHandler(UTF_SUB_TYPE::UTF8st);
+    ::printf("%-28s %10s %10s %10s %10s\n", "corpus (4MB)", "branching", "getUTF8", "UTF8st", "handler");
+    for (uint32_t corpus = 0; corpus < 4; ++corpus)
+    {
+        ::std::vector<uint8_t> text = generate(corpus, (4u << 20));
+        const uint32_t size = static_cast<uint32_t>(text.size());
+        uint32_t checksums[4];
+        const quick_decoder volatile branchingDecoder = branchingUTF8;
+        const quick_decoder volatile quickDecoder = unicode::utf::std::getUTF8;
+        const double branching = measure(text, [&branchingDecoder](const ::std::vector<uint8_t>& text) { return decodeQuick(text, branchingDecoder); }, checksums[0]);
+        const double quick = measure(text, [&quickDecoder](const ::std::vector<uint8_t>& text) { return decodeQuick(text, quickDecoder); }, checksums[1]);
+        const double codec_get = measure(text, [size](const ::std::vector<uint8_t>& text) {
+            uint32_t sum = 0;
+            unicode_t unicode;
+            uint32_t bytes;
+            utf_text scan = { size, 0, const_cast<uint8_t*>(text.data()) };
+            for (; scan.offset < size; scan.offset += bytes)
+            {
+                static_cast<void>(codec<UTF_SUB_TYPE::UTF8st>::get(scan, unicode, bytes));
+                sum += static_cast<uint32_t>(unicode);
+            }
+            return sum; }, checksums[2]);
+        const double virtual_get = measure(text, [size, &handler](const ::std::vector<uint8_t>& text) {
+            uint32_t sum = 0;
+            unicode_t unicode;
+            uint32_t bytes;
+            utf_text scan = { size, 0, const_cast<uint8_t*>(text.data()) };
+            for (; scan.offset < size; scan.offset += bytes)
+            {
+                static_cast<void>(handler.get(scan, unicode, bytes));
+                sum += static_cast<uint32_t>(unicode);
+            }
+            return sum; }, checksums[3]);
+        const bool same = ((checksums[0] == checksums[1]) && (checksums[0] == checksums[2]) && (checksums[0] == checksums[3]));
+        ::printf("%-28s %10.1f %10.1f %10.1f %10.1f%s\n", names[corpus], branching, quick, codec_get, virtual_get, (same ? "" : "  (decoders disagree)"));
+    }
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include "utf_std.h"
 #include "utf_toolkit.h"
 #include "utf_helpers.h"
+#include "utf_simd.h"
 #include "text_hash.h"
 
 #endif  //  #ifndef __SUITE_UTF_INCLUDED__
@@ -0,0 +1,272 @@
+//  Copyright (c) 2010-2026 Ritchie Brannan
+//  License: MIT (see LICENSE file in repository root)
+//
+//  SuiteUTF
+//  Original design 20102016; maintained and extended 20242025.
+//  Copyright (c) 20102025 Ritchie Brannan.
+//  MIT License. See LICENSE.txt. Project history: docs/History.md.
+//
+//  File:   utf_simd.h
+//  Author: Ritchie Brannan
+//  Date:   11 July 16
+//  
+//  Description:
+//  
+//      Block based (SIMD) bulk UTF kernels.
+//  
+//  Notes:
+//  
+//      The kernels process blocks of 64 bytes per iteration using SSE4.2, AVX2 or AVX-512 (selected at run-time from
+//      the capabilities of the CPU) with a portable 64-bit word-at-a-time (SWAR) fallback for everything else.
+//  
+//      The CPU is queried once and every bulk kernel is called through the function table of the selected tier. The
+//      tier can be forced for testing and benchmarking with setTier() or the SUITE_UTF_SIMD_TIER environment variable.
+//  
+//      The kernels produce exactly the same results as the equivalent loops over the quick functions in utf_std.h.
+//      When a block fails a vector test the scalar code takes over from the start of the affected sequence, so a
+//      failure is always reported at the same offset as the scalar functions would report it.
+//  
+//      Most users will not need to interact with this header directly, the kernels are used by the bulk functions in
+//      utf_std.h and utf_toolkit.h.
+
+#pragma once
+
+#ifndef __UTF_SIMD_INCLUDED__
+#define __UTF_SIMD_INCLUDED__
+
+#include "unicode_type.h"
+
+namespace unicode
+{
+
+namespace utf
+{
+
+namespace simd
+{
+
+// ==== CPU feature flags ====
+
+constexpr uint32_t FEATURE_SSE42      = 0x00000001u;    //  SSSE3, SSE4.1, SSE4.2 and POPCNT
+constexpr uint32_t FEATURE_AVX2       = 0x00000002u;    //  AVX2 with OS support for the YMM state
+constexpr uint32_t FEATURE_AVX512     = 0x00000004u;    //  AVX-512 F and BW with OS support for the ZMM state
+constexpr uint32_t FEATURE_AVX512VBMI = 0x00000008u;    //  AVX-512 VBMI (only reported with FEATURE_AVX512)
+constexpr uint32_t FEATURE_BMI2       = 0x00000010u;    //  BMI2
+
+/// bulk kernel tier enumeration (each tier requires the features of the tiers below it)
+enum class SIMD_TIER : int32_t
+{
+    Scalar = 0,     //  portable 64-bit word-at-a-time (SWAR) kernels
+    SSE42  = 1,     //  SSE4.2 kernels (FEATURE_SSE42)
+    AVX2   = 2,     //  AVX2 kernels (FEATURE_AVX2)
+    AVX512 = 3,     //  AVX-512 kernels (FEATURE_AVX512, 64-bit builds only)
+    COUNT  = 4      //  count of tiers
+};
+
+// ==== CPU feature dispatch ====
+
+/// returns the FEATURE_* flags of the running CPU
+uint32_t getFeatures() noexcept;
+
+/// returns the best kernel tier supported by both the running CPU and the build
+SIMD_TIER getBestTier() noexcept;
+
+/// returns the kernel tier used by the bulk kernels
+SIMD_TIER getTier() noexcept;
+
+/// forces the kernel tier used by the bulk kernels (intended for testing and benchmarking)
+///
+///     The tier is clamped to getBestTier() and the tier now in use is returned, SIMD_TIER::COUNT restores the best tier.
+///     The initial tier is getBestTier() unless the SUITE_UTF_SIMD_TIER environment variable is set to scalar, sse42,
+///     avx2 or avx512 (also clamped). Calls already running when the tier changes complete on the tier they started with.
+///
+SIMD_TIER setTier(const SIMD_TIER tier) noexcept;
+
+/// returns the name of a kernel tier ("scalar", "sse42", "avx2" or "avx512") or "unknown"
+const char* getTierName(const SIMD_TIER tier) noexcept;
+
+// ==== bulk UTF8 validation kernel ====
+
+/// returns the byte length of the leading span of the buffer that decodes without failure using getUTF8()
+///
+///     The return value is the offset of the first sequence rejected by getUTF8(..., use_java) or size if there is none.
+///
+uint32_t validSpanUTF8(const uint8_t* const buffer, const uint32_t size, const bool use_java = false) noexcept;
+
+// ==== bulk UTF8 to UTF16 conversion kernel ====
+
+/// converts UTF8 to little or big endian UTF16, stopping at the first sequence that fails getUTF8() or does not fit
+///
+///     The return value is the number of source bytes consumed and 'written' is the number of bytes written to dst.
+///     Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertUTF8toUTF16(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_java = false) noexcept;
+
+// ==== bulk UTF16 to UTF8 conversion kernel ====
+
+/// converts little or big endian UTF16 to UTF8, stopping at the first sequence that fails getUTF16() or does not fit
+///
+///     The return value is the number of source bytes consumed and 'written' is the number of bytes written to dst.
+///     Unpaired surrogates are rejected exactly as getUTF16le() and getUTF16be() reject them and use_java selects the
+///     2 byte encoding of NULL as setUTF8() does. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertUTF16toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_java = false) noexcept;
+
+// ==== bulk CP1252 to UTF8 conversion kernel ====
+
+/// converts Windows code-page 1252 to UTF8, stopping at the first byte that fails getCP1252() or does not fit
+///
+///     ASCII runs are copied a block at a time and 0x80 to 0xff are converted through a table of pre-encoded sequences.
+///     strict rejects the undefined bytes (0x81, 0x8d, 0x8f, 0x90 and 0x9d) as CP1252Strictness::StrictUndefined does,
+///     otherwise they are converted to the C1 controls with the same values (CP1252Strictness::WindowsCompatible). use_java
+///     selects the 2 byte encoding of NULL as setUTF8() does. The return value is the number of source bytes consumed and
+///     'written' is the number of bytes written to dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertCP1252toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool strict = true, const bool use_java = false) noexcept;
+
+// ==== bulk UTF8 to CP1252 conversion kernel ====
+
+/// converts UTF8 to Windows code-page 1252, stopping at the first sequence that fails getUTF8(), is not in CP1252 or does not fit
+///
+///     ASCII runs are copied a block at a time and the code-points above 0xff are found through a reverse lookup table.
+///     strict rejects the C1 controls of the undefined bytes as setCP1252() does (CP1252Strictness::StrictUndefined),
+///     otherwise they are converted to the bytes with the same values. The return value is the number of source bytes
+///     consumed and 'written' is the number of bytes written to dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertUTF8toCP1252(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool strict = true, const bool use_java = false) noexcept;
+
+// ==== bulk ISO-8859-1 and ASCII conversion kernels ====
+// ==== note: use_ascii restricts the bytes to 0x00 to 0x7f as getBYTE() and setBYTE() do ====
+// ==== note: the block stores are only made where dstSize leaves space for the whole store, nothing is written at or beyond dst + dstSize ====
+
+/// converts ISO-8859-1 (or ASCII) to UTF8, stopping at the first byte that fails getBYTE() or does not fit
+///
+///     0x80 to 0xff are expanded to 2 byte sequences a block at a time and use_java selects the 2 byte encoding of NULL as
+///     setUTF8() does. The return value is the number of source bytes consumed (the offset of the first byte that cannot
+///     be converted) and 'written' is the number of bytes written to dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertBYTEtoUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_ascii = false, const bool use_java = false) noexcept;
+
+/// converts UTF8 to ISO-8859-1 (or ASCII), stopping at the first sequence that fails getUTF8(), fails setBYTE() or does not fit
+///
+///     The 2 byte sequences of 0x80 to 0xff are narrowed a block at a time. The return value is the number of source bytes
+///     consumed (the offset of the first sequence that cannot be converted) and 'written' is the number of bytes written to
+///     dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertUTF8toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_ascii = false, const bool use_java = false) noexcept;
+
+/// converts ISO-8859-1 (or ASCII) to little or big endian UTF16 by zero extension, stopping at the first byte that fails getBYTE() or does not fit
+///
+///     The return value is the number of source bytes consumed and 'written' is the number of bytes written to dst.
+///
+uint32_t convertBYTEtoUTF16(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_ascii = false) noexcept;
+
+/// converts little or big endian UTF16 to ISO-8859-1 (or ASCII) by narrowing, stopping at the first code-unit above 0xff (0x7f) or that does not fit
+///
+///     The return value is the number of source bytes consumed (the offset of the first code-unit that cannot be converted)
+///     and 'written' is the number of bytes written to dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertUTF16toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_ascii = false) noexcept;
+
+// ==== bulk CESU8 and Java style UTF8 conversion kernels ====
+// ==== note: use_cesu selects CESU8 surrogate pairs for supplementary code-points and use_java the 2 byte encoding of NULL ====
+
+/// converts CESU8 and/or Java style UTF8 (modified UTF8 if both flags are set) to UTF8, stopping at the first sequence that
+/// cannot be converted or does not fit
+///
+///     A high surrogate immediately followed by a low surrogate (3 byte forms, as backUTF8() pairs them) is re-encoded as a 4 byte
+///     sequence and {0xc0, 0x80} as NULL. Unpaired surrogates and the longer surrogate forms stop the conversion. The spans between
+///     them are validated by the UTF8 validation kernel and copied as they are. The output is never longer than the input, so dst
+///     may be src to convert in place. The return value is the number of source bytes consumed and 'written' is the number of
+///     bytes written to dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertMUTF8toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_cesu = true, const bool use_java = true) noexcept;
+
+/// converts UTF8 to CESU8 and/or Java style UTF8 (modified UTF8 if both flags are set), stopping at the first sequence that fails
+/// getUTF8() or does not fit
+///
+///     4 byte sequences are re-encoded as surrogate pairs and NULL as {0xc0, 0x80}. The spans between them are validated by the
+///     UTF8 validation kernel and copied as they are. The return value is the number of source bytes consumed and 'written' is
+///     the number of bytes written to dst. Bytes in dst beyond 'written' may have been overwritten.
+///
+uint32_t convertUTF8toMUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_cesu = true, const bool use_java = true) noexcept;
+
+// ==== bulk code-point counting kernels ====
+
+/// returns the number of bytes in the buffer that are not UTF8 continuation bytes (0x80 to 0xbf)
+uint32_t countUTF8(const uint8_t* const buffer, const uint32_t size) noexcept;
+
+/// returns the number of UTF16 code-units in the buffer less the number of high surrogates followed by a low surrogate
+uint32_t countUTF16(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+
+// ==== bulk conversion size calculation kernels ====
+// ==== note: the results match the strsize*from*() loops over the quick functions ====
+
+/// returns the UTF16 size of UTF8 (2 bytes for each byte that is not a continuation byte and 2 more for each 0xf0 to 0xff)
+///
+///     The result is only meaningful for a buffer that is valid, typically the span returned by validSpanUTF8().
+///
+uint32_t sizeUTF16fromUTF8(const uint8_t* const buffer, const uint32_t size) noexcept;
+
+/// returns the UTF8 size of UTF16 (unpaired surrogates are skipped as getUTF16le() and getUTF16be() reject them)
+uint32_t sizeUTF8fromUTF16(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java = false) noexcept;
+
+/// returns the UTF8 size of UTF32 (values rejected by getUTF32le() and getUTF32be() are skipped)
+uint32_t sizeUTF8fromUTF32(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java = false) noexcept;
+
+/// returns the UTF16 size of UTF32 (values rejected by getUTF32le() and getUTF32be() are skipped)
+uint32_t sizeUTF16fromUTF32(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+
+// ==== null terminator scanning kernels ====
+// ==== note: the scans read whole aligned blocks that contain part of the string, so they never cross into a page that does not ====
+
+/// returns the byte offset of the first null (0) byte
+uint32_t findNullUTF8(const uint8_t* const buffer) noexcept;
+
+/// returns the byte offset of the first null (0) 16-bit code-unit
+uint32_t findNullUTF16(const uint8_t* const buffer) noexcept;
+
+/// returns the byte offset of the first null (0) 32-bit code-unit
+uint32_t findNullUTF32(const uint8_t* const buffer) noexcept;
+
+/// returns the number of bytes before the first null (0) byte that are not UTF8 continuation bytes and sets 'bytes' to its offset
+uint32_t countNullUTF8(const uint8_t* const buffer, uint32_t& bytes) noexcept;
+
+// ==== line break scanning kernel ====
+
+/// returns the byte offset of the first carriage return (0x0d) or line-feed (0x0a) byte or size if there is none
+uint32_t findLineBreakUTF8(const uint8_t* const buffer, const uint32_t size) noexcept;
+
+// ==== line terminator candidate scanning kernels ====
+// ==== note: the code-points before a candidate are neither line terminators nor NULL, non-characters, supplementary code-points or surrogates ====
+
+/// returns the byte offset of the first byte that may start a line terminator, NULL, non-character or supplementary code-point or size
+///
+///     The candidates are 0x00, 0x0a to 0x0d, {0xc2, 0x85}, {0xe2, 0x80, 0xa8 or 0xa9}, {0xef, 0xb7 or 0xbf} and 0xf0 to 0xff. The bytes
+///     before the candidate are not validated, validSpanUTF8() of the bytes before the candidate gives the span that decodes cleanly.
+///
+uint32_t findLineCandidateUTF8(const uint8_t* const buffer, const uint32_t size) noexcept;
+
+/// returns the byte offset of the first byte that is 0x00, 0x0a to 0x0d or 0x80 to 0xff, or size if there is none
+uint32_t findLineCandidateBYTE(const uint8_t* const buffer, const uint32_t size) noexcept;
+
+/// returns the byte offset of the first UTF16 code-unit that is 0x0000, 0x000a to 0x000d, 0x0085, 0x2028, 0x2029 or 0xd800 to 0xffff
+///
+///     If there is none the offset of the end of the last whole code-unit is returned.
+///
+uint32_t findLineCandidateUTF16(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+
+/// returns the byte offset of the first UTF32 code-unit that is 0x00000000, 0x0000000a to 0x0000000d, 0x00000085, 0x00002028, 0x00002029 or
+/// 0x0000d800 and above
+///
+///     If there is none the offset of the end of the last whole code-unit is returned.
+///
+uint32_t findLineCandidateUTF32(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+
+};  //  namespace simd
+
+};  //  namespace utf
+
+};  //  namespace unicode
+
+#endif  //  #ifndef __UTF_SIMD_INCLUDED__
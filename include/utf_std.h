@@ -107,6 +107,197 @@ enum class UTF_OTHER_TYPE : int32_t
 /// 
 UTF_TYPE identifyUTF(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes) noexcept;
 
+namespace internal
+{
+
+/// table driven UTF8 decoding state machine
+/// 
+///     The byte values are grouped into 12 classes and a sequence is decoded by stepping through the states with one
+///     look-up per byte. The tables are generated at compile time by makeUTF8_DFA(). The state values are pre-multiplied
+///     by the class count so that each step is a single look-up of states[state + class].
+/// 
+///     The state machine accepts exactly the well formed UTF8 accepted by getUTF8(..., false): no overlong encodings, no
+///     encoded surrogates and nothing above U+10FFFF.
+/// 
+struct utf8_dfa
+{
+    //  byte classes
+    static constexpr uint32_t Ascii     = 0;    //  0x00-0x7f
+    static constexpr uint32_t Cont0     = 1;    //  0x80-0x8f
+    static constexpr uint32_t Cont1     = 2;    //  0x90-0x9f
+    static constexpr uint32_t Cont2     = 3;    //  0xa0-0xbf
+    static constexpr uint32_t Lead2     = 4;    //  0xc2-0xdf
+    static constexpr uint32_t LeadE0    = 5;    //  0xe0 (second byte 0xa0-0xbf)
+    static constexpr uint32_t Lead3     = 6;    //  0xe1-0xec and 0xee-0xef
+    static constexpr uint32_t LeadED    = 7;    //  0xed (second byte 0x80-0x9f)
+    static constexpr uint32_t LeadF0    = 8;    //  0xf0 (second byte 0x90-0xbf)
+    static constexpr uint32_t Lead4     = 9;    //  0xf1-0xf3
+    static constexpr uint32_t LeadF4    = 10;   //  0xf4 (second byte 0x80-0x8f)
+    static constexpr uint32_t Illegal   = 11;   //  0xc0-0xc1 and 0xf5-0xff
+    static constexpr uint32_t Classes   = 12;
+
+    //  states (pre-multiplied by the class count)
+    static constexpr uint32_t Accept    = (0 * Classes);
+    static constexpr uint32_t Reject    = (1 * Classes);
+    static constexpr uint32_t Need1     = (2 * Classes);
+    static constexpr uint32_t Need2     = (3 * Classes);
+    static constexpr uint32_t Need3     = (4 * Classes);
+    static constexpr uint32_t NeedE0    = (5 * Classes);
+    static constexpr uint32_t NeedED    = (6 * Classes);
+    static constexpr uint32_t NeedF0    = (7 * Classes);
+    static constexpr uint32_t NeedF4    = (8 * Classes);
+    static constexpr uint32_t Start     = (9 * Classes);
+    static constexpr uint32_t States    = (10 * Classes);
+
+    uint8_t classes[256];       //! byte class of each byte value
+    uint8_t masks[Classes];     //! payload mask of each lead byte class (0 for classes that cannot lead)
+    uint8_t lengths[Classes];   //! sequence length of each lead byte class (0 for classes that cannot lead)
+    uint8_t states[States];     //! next state indexed by (state + class)
+};
+
+/// generates the UTF8 decoding state machine tables
+constexpr utf8_dfa makeUTF8_DFA() noexcept
+{
+    utf8_dfa dfa = {};
+    for (uint32_t byte = 0; byte < 256; ++byte)
+    {
+        uint32_t type = utf8_dfa::Illegal;
+        if (byte <= 0x7fu)
+        {
+            type = utf8_dfa::Ascii;
+        }
+        else if (byte <= 0x8fu)
+        {
+            type = utf8_dfa::Cont0;
+        }
+        else if (byte <= 0x9fu)
+        {
+            type = utf8_dfa::Cont1;
+        }
+        else if (byte <= 0xbfu)
+        {
+            type = utf8_dfa::Cont2;
+        }
+        else if ((byte >= 0xc2u) && (byte <= 0xdfu))
+        {
+            type = utf8_dfa::Lead2;
+        }
+        else if (byte == 0xe0u)
+        {
+            type = utf8_dfa::LeadE0;
+        }
+        else if (byte == 0xedu)
+        {
+            type = utf8_dfa::LeadED;
+        }
+        else if ((byte >= 0xe1u) && (byte <= 0xefu))
+        {
+            type = utf8_dfa::Lead3;
+        }
+        else if (byte == 0xf0u)
+        {
+            type = utf8_dfa::LeadF0;
+        }
+        else if ((byte >= 0xf1u) && (byte <= 0xf3u))
+        {
+            type = utf8_dfa::Lead4;
+        }
+        else if (byte == 0xf4u)
+        {
+            type = utf8_dfa::LeadF4;
+        }
+        dfa.classes[byte] = static_cast<uint8_t>(type);
+    }
+    dfa.masks[utf8_dfa::Ascii] = 0x7fu;
+    dfa.masks[utf8_dfa::Lead2] = 0x1fu;
+    dfa.masks[utf8_dfa::LeadE0] = dfa.masks[utf8_dfa::Lead3] = dfa.masks[utf8_dfa::LeadED] = 0x0fu;
+    dfa.masks[utf8_dfa::LeadF0] = dfa.masks[utf8_dfa::Lead4] = dfa.masks[utf8_dfa::LeadF4] = 0x07u;
+    dfa.lengths[utf8_dfa::Ascii] = 1;
+    dfa.lengths[utf8_dfa::Lead2] = 2;
+    dfa.lengths[utf8_dfa::LeadE0] = dfa.lengths[utf8_dfa::Lead3] = dfa.lengths[utf8_dfa::LeadED] = 3;
+    dfa.lengths[utf8_dfa::LeadF0] = dfa.lengths[utf8_dfa::Lead4] = dfa.lengths[utf8_dfa::LeadF4] = 4;
+    for (uint32_t index = 0; index < utf8_dfa::States; ++index)
+    {   //  everything not listed below is rejected and the accept state absorbs the bytes that follow a sequence
+        dfa.states[index] = static_cast<uint8_t>((index < utf8_dfa::Reject) ? utf8_dfa::Accept : utf8_dfa::Reject);
+    }
+    dfa.states[utf8_dfa::Start + utf8_dfa::Ascii] = utf8_dfa::Accept;
+    dfa.states[utf8_dfa::Start + utf8_dfa::Lead2] = utf8_dfa::Need1;
+    dfa.states[utf8_dfa::Start + utf8_dfa::LeadE0] = utf8_dfa::NeedE0;
+    dfa.states[utf8_dfa::Start + utf8_dfa::Lead3] = utf8_dfa::Need2;
+    dfa.states[utf8_dfa::Start + utf8_dfa::LeadED] = utf8_dfa::NeedED;
+    dfa.states[utf8_dfa::Start + utf8_dfa::LeadF0] = utf8_dfa::NeedF0;
+    dfa.states[utf8_dfa::Start + utf8_dfa::Lead4] = utf8_dfa::Need3;
+    dfa.states[utf8_dfa::Start + utf8_dfa::LeadF4] = utf8_dfa::NeedF4;
+    for (uint32_t type = utf8_dfa::Cont0; type <= utf8_dfa::Cont2; ++type)
+    {
+        dfa.states[utf8_dfa::Need1 + type] = utf8_dfa::Accept;
+        dfa.states[utf8_dfa::Need2 + type] = utf8_dfa::Need1;
+        dfa.states[utf8_dfa::Need3 + type] = utf8_dfa::Need2;
+    }
+    dfa.states[utf8_dfa::NeedE0 + utf8_dfa::Cont2] = utf8_dfa::Need1;
+    dfa.states[utf8_dfa::NeedED + utf8_dfa::Cont0] = utf8_dfa::Need1;
+    dfa.states[utf8_dfa::NeedED + utf8_dfa::Cont1] = utf8_dfa::Need1;
+    dfa.states[utf8_dfa::NeedF0 + utf8_dfa::Cont1] = utf8_dfa::Need2;
+    dfa.states[utf8_dfa::NeedF0 + utf8_dfa::Cont2] = utf8_dfa::Need2;
+    dfa.states[utf8_dfa::NeedF4 + utf8_dfa::Cont0] = utf8_dfa::Need2;
+    return dfa;
+}
+
+/// UTF8 decoding state machine tables
+inline constexpr utf8_dfa dfaUTF8 = makeUTF8_DFA();
+
+/// steps the UTF8 decoding state machine through the 4 bytes at source
+/// 
+///     All 4 bytes are stepped through for every sequence (the accept state absorbs the bytes that follow a sequence) so
+///     the result is computed without branches. The unicode and bytes values are only meaningful if the function returns
+///     true.
+/// 
+inline [[nodiscard]] bool stepDFA_UTF8(const uint8_t* const source, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    const uint32_t lead = dfaUTF8.classes[source[0]];
+    uint32_t state = dfaUTF8.states[utf8_dfa::Start + lead];
+    state = dfaUTF8.states[state + dfaUTF8.classes[source[1]]];
+    state = dfaUTF8.states[state + dfaUTF8.classes[source[2]]];
+    state = dfaUTF8.states[state + dfaUTF8.classes[source[3]]];
+    const uint32_t length = dfaUTF8.lengths[lead];
+    const uint32_t value = ((static_cast<uint32_t>(source[0] & dfaUTF8.masks[lead]) << 18) | (static_cast<uint32_t>(source[1] & 0x3fu) << 12) | (static_cast<uint32_t>(source[2] & 0x3fu) << 6) | static_cast<uint32_t>(source[3] & 0x3fu));
+    unicode = static_cast<unicode_t>(value >> ((24 - (length * 6)) & 31));
+    bytes = length;
+    return (state == utf8_dfa::Accept);
+}
+
+/// decodes a single well formed UTF8 sequence using the state machine
+/// 
+///     ASCII is decoded directly: in ASCII runs the test is always predicted and it keeps the byte count independent of
+///     the table look-ups. Every other sequence goes through stepDFA_UTF8() with no per-length branching. Buffers shorter
+///     than 4 bytes are padded with 0x00 which rejects a truncated sequence.
+/// 
+///     The buffer must not be NULL and the size must not be 0.
+///     The unicode and bytes values are only meaningful if the function returns true, callers fall back to their own
+///     decoding to classify a failure.
+/// 
+inline [[nodiscard]] bool decodeDFA_UTF8(const uint8_t* const buffer, const uint32_t size, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    if (buffer[0] <= 0x7fu)
+    {   //  1 byte (7 bits: 0x00-0x7f)
+        unicode = static_cast<unicode_t>(buffer[0]);
+        bytes = 1;
+        return true;
+    }
+    if (size >= 4)
+    {
+        return stepDFA_UTF8(buffer, unicode, bytes);
+    }
+    uint8_t padded[4] = { 0, 0, 0, 0 };
+    for (uint32_t index = 0; index < size; ++index)
+    {
+        padded[index] = buffer[index];
+    }
+    return stepDFA_UTF8(padded, unicode, bytes);
+}
+
+};  //  namespace internal
+
 namespace std
 {
 
@@ -183,6 +374,47 @@ uint32_t strsizeUTF16fromUTF8(const uint8_t* const buffer, const uint32_t size,
 uint32_t strsizeUTF16fromUTF32le(const uint8_t* const buffer, const uint32_t size) noexcept;
 uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer, const uint32_t size) noexcept;
 
+// ==== quick UTF fixed buffer size bulk validation functions ====
+// ==== note: the 'bytes' output parameter is the offset of the first sequence that fails to decode (or size if none fail) ====
+[[nodiscard]] bool validateUTF8(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes, const bool use_java = false) noexcept;
+
+// ==== quick UTF fixed buffer size bulk format conversion functions ====
+// ==== note: conversion stops at the first sequence that fails to decode or does not fit, 'consumed' is the source offset of that sequence ====
+// ==== note: bytes in the destination buffer beyond the 'written' count may have been overwritten ====
+[[nodiscard]] bool convertUTF8toUTF16le(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertUTF8toUTF16be(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertUTF16leToUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertUTF16beToUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertCP1252toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool strict = true, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertUTF8toCP1252(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool strict = true, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertBYTEtoUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii = false, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertUTF8toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii = false, const bool use_java = false) noexcept;
+[[nodiscard]] bool convertBYTEtoUTF16le(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii = false) noexcept;
+[[nodiscard]] bool convertBYTEtoUTF16be(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii = false) noexcept;
+[[nodiscard]] bool convertUTF16leToBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii = false) noexcept;
+[[nodiscard]] bool convertUTF16beToBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii = false) noexcept;
+[[nodiscard]] bool convertMUTF8toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_cesu = true, const bool use_java = true) noexcept;
+[[nodiscard]] bool convertUTF8toMUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_cesu = true, const bool use_java = true) noexcept;
+
+// ==== quick UTF fixed buffer size bulk decode and encode functions ====
+// ==== note: decoding stops at the first sequence that fails to decode or when 'capacity' code-points have been decoded ====
+// ==== note: encoding stops at the first code-point that fails to encode or does not fit ====
+// ==== note: 'count' is the number of code-points decoded or encoded and 'bytes' is the offset of the sequence where processing stopped ====
+[[nodiscard]] bool decodeBlockBYTE(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, const bool use_ascii = false) noexcept;
+[[nodiscard]] bool decodeBlockCP1252(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool decodeBlockUTF8(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, const bool use_java = false) noexcept;
+[[nodiscard]] bool decodeBlockUTF16le(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool decodeBlockUTF16be(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool decodeBlockUTF32le(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool decodeBlockUTF32be(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool encodeBlockBYTE(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_ascii = false) noexcept;
+[[nodiscard]] bool encodeBlockCP1252(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool encodeBlockUTF8(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_java = false) noexcept;
+[[nodiscard]] bool encodeBlockUTF16le(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool encodeBlockUTF16be(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool encodeBlockUTF32le(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept;
+[[nodiscard]] bool encodeBlockUTF32be(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept;
+
 /// quick UTF abstracted functions interface with utility functions
 struct IUTF
 {
@@ -204,6 +436,10 @@ public:
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept = 0;
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept = 0;
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept = 0;
+    //  virtual bulk functions (the defaults read or write the buffer one code-point at a time):
+    virtual [[nodiscard]] bool  validate(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes) const noexcept;
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept;
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept;
     //  non-virtual utility functions:
     [[nodiscard]] bool          get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept;
     [[nodiscard]] bool          set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept;
@@ -214,6 +450,10 @@ public:
     [[nodiscard]] bool          writeBOM(utf_text& text) const noexcept;
     [[nodiscard]] bool          writeNull(utf_text& text) const noexcept;
     [[nodiscard]] bool          validate(const utf_text& text) const noexcept;
+    [[nodiscard]] bool          decodeBlock(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept;
+    [[nodiscard]] bool          encodeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept;
+    [[nodiscard]] bool          readBlock(utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count) const noexcept;
+    [[nodiscard]] bool          writeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count) const noexcept;
     //  non-virtual normalised line-feed functions (0x00, 0x0a, 0x0b, 0x0c, 0x0d, 0x85, 0x2028, 0x2029, {0x0d, 0x0a} and {0x0a,0x0d} are all translated to 0x0a):
     [[nodiscard]] bool          getNLF(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept;
     [[nodiscard]] bool          readNLF(utf_text& text, unicode_t& unicode) const noexcept;
@@ -233,15 +473,15 @@ constexpr uint32_t lenUTF8(const unicode_t unicode, const bool use_java) noexcep
     uint32_t bytes = 0;
     if (static_cast<uint32_t>(unicode) <= 0x0010ffffu)
     {   //  is an encodable unicode value
-        if (unicode <= 0x0000007fu)
+        if (static_cast<uint32_t>(unicode) <= 0x0000007fu)
         {   //  1 byte (7 bits)
             bytes = ((use_java && (unicode == 0x00000000u)) ? 2 : 1);
         }
-        else if (unicode <= 0x000007ffu)
+        else if (static_cast<uint32_t>(unicode) <= 0x000007ffu)
         {   //  2 bytes (11 bits)
             bytes = 2;
         }
-        else if (unicode <= 0x0000ffffu)
+        else if (static_cast<uint32_t>(unicode) <= 0x0000ffffu)
         {   //  3 bytes (16 bits)
             if ((unicode & 0xfffff800u) != 0x0000d800u)
             {
@@ -86,6 +86,7 @@
 #define __UTF_TOOLKIT_INCLUDED__
 
 #include "utf_std.h"
+#include "unicode_utilities.h"
 #include <type_traits>
 
 namespace unicode
@@ -341,6 +342,34 @@ uint32_t lenUTF32(const unicode_t unicode, const bool use_cesu = false, const bo
 [[nodiscard]] cp_errors decodeUTF32(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool le = false, const bool use_cesu = false, const bool use_ucs4 = false) noexcept;
 [[nodiscard]] cp_errors decodeCP1252(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool strict = false, const bool coalesce = true) noexcept;
 
+// ==== compile-time specialised low level code-point encoding and decoding functions ====
+// ==== note: the template flags have the same meaning as the function control flags, the functions above are thin wrappers around these ====
+template<bool use_ascii> [[nodiscard]] cp_errors encodeBYTE(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept;
+template<bool use_cesu, bool use_java> [[nodiscard]] cp_errors encodeUTF8(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept;
+template<bool le, bool use_ucs2> [[nodiscard]] cp_errors encodeUTF16(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept;
+template<bool le, bool use_cesu, bool use_ucs4> [[nodiscard]] cp_errors encodeUTF32(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept;
+template<bool strict> [[nodiscard]] cp_errors encodeCP1252(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept;
+template<bool use_ascii, bool coalesce> [[nodiscard]] cp_errors decodeBYTE(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept;
+template<bool use_cesu, bool use_java, bool strict, bool coalesce> [[nodiscard]] cp_errors decodeUTF8(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept;
+template<bool le, bool use_ucs2> [[nodiscard]] cp_errors decodeUTF16(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept;
+template<bool le, bool use_cesu, bool use_ucs4> [[nodiscard]] cp_errors decodeUTF32(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept;
+template<bool strict, bool coalesce> [[nodiscard]] cp_errors decodeCP1252(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept;
+
+// ==== low level code-point block decoding and encoding functions ====
+// ==== note: decoding continues past decode fails and stops at the end of the buffer, after 'capacity' code-points or on a buffer error ====
+// ==== note: encoding stops at the first code-point that fails to encode (the failing code-point is unicodes[count]) ====
+// ==== note: the returned errors are aggregated, 'failed' is the byte offset of the first sequence that failed relative to text.offset ====
+[[nodiscard]] cp_errors decodeBlockBYTE(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool use_ascii = false, const bool coalesce = true) noexcept;
+[[nodiscard]] cp_errors decodeBlockUTF8(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool use_cesu = false, const bool use_java = false, const bool strict = false, const bool coalesce = true) noexcept;
+[[nodiscard]] cp_errors decodeBlockUTF16(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool le = false, const bool use_ucs2 = false) noexcept;
+[[nodiscard]] cp_errors decodeBlockUTF32(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool le = false, const bool use_cesu = false, const bool use_ucs4 = false) noexcept;
+[[nodiscard]] cp_errors decodeBlockCP1252(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool strict = false, const bool coalesce = true) noexcept;
+[[nodiscard]] cp_errors encodeBlockBYTE(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_ascii = false) noexcept;
+[[nodiscard]] cp_errors encodeBlockUTF8(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_cesu = false, const bool use_java = false) noexcept;
+[[nodiscard]] cp_errors encodeBlockUTF16(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool le = false, const bool use_ucs2 = false) noexcept;
+[[nodiscard]] cp_errors encodeBlockUTF32(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool le = false, const bool use_cesu = false, const bool use_ucs4 = false) noexcept;
+[[nodiscard]] cp_errors encodeBlockCP1252(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool strict = false) noexcept;
+
 // ==== low level utf byte order marker and NULL code-point fast encoding functions ====
 [[nodiscard]] cp_errors encodeUTF8_BOM(utf_text& text, uint32_t& bytes) noexcept;
 [[nodiscard]] cp_errors encodeUTF16_BOM(utf_text& text, uint32_t& bytes, const bool le = false) noexcept;
@@ -380,6 +409,514 @@ inline constexpr [[nodiscard]] bool isOverlongUTF8(const unicode_t unicode, cons
 [[nodiscard]] bool overlongToIndexUTF8(const unicode_t unicode, const uint32_t bytes, uint32_t& index) noexcept;
 [[nodiscard]] bool indexToOverlongUTF8(const uint32_t index, unicode_t& unicode, uint32_t& bytes) noexcept;
 
+// ==== compile-time specialised encoded unicode code-point handling ====
+
+//  Notes:
+//
+//      codec<UTF_SUB_TYPE> exposes the same functions as the IUTFTK handler for the sub-type as static members
+//      calling the compile-time specialised encoding and decoding functions, so templated code can use a sub-type
+//      without virtual dispatch and the compiler is free to inline the decoder entirely.
+//
+//      The IUTFTK handlers returned by IUTFTK::getHandler() are implemented on top of these.
+
+template<UTF_SUB_TYPE sub_type> struct codec;
+
+template<> struct codec<UTF_SUB_TYPE::UTF8>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF8; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, false, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<false, false, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, false, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, false, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UTF8ns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF8ns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, false, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<false, false, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, false, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, false, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UTF8st>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF8st; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, false, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<false, false, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, false, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, false, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::JUTF8>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::JUTF8; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, false, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<false, true, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, false, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, false, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::JUTF8ns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::JUTF8ns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, false, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<false, true, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, false, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, false, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::JUTF8st>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::JUTF8st; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, false, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<false, true, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, false, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, false, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU8>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU8; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, true, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<true, false, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, true, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, true, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU8ns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU8ns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, true, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<true, false, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, true, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, true, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU8st>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU8st; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, true, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<true, false, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, true, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, true, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::JCESU8>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::JCESU8; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, true, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<true, true, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, true, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, true, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::JCESU8ns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::JCESU8ns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, true, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<true, true, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, true, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, true, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::JCESU8st>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF8; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::JCESU8st; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF8(unicode, true, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF8<true, true, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF8<true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF8(text, count, true, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF8(text, count, true, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UTF16le>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF16le; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF16le; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 2; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF16(unicode, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 2; }
+    static constexpr uint32_t       lenNull() noexcept { return 2; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF16<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF16<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_BOM(text, bytes, true); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF16(text, count, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF16(text, count, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UTF16be>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF16be; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF16be; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 2; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF16(unicode, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 2; }
+    static constexpr uint32_t       lenNull() noexcept { return 2; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF16<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF16<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_BOM(text, bytes, false); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF16(text, count, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF16(text, count, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UCS2le>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF16le; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UCS2le; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 2; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF16(unicode, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 2; }
+    static constexpr uint32_t       lenNull() noexcept { return 2; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF16<true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF16<true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_BOM(text, bytes, true); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF16(text, count, true, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF16(text, count, true, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UCS2be>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF16be; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UCS2be; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 2; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF16(unicode, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 2; }
+    static constexpr uint32_t       lenNull() noexcept { return 2; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF16<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF16<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_BOM(text, bytes, false); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF16_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF16(text, count, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF16(text, count, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UTF32le>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32le; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF32le; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, false, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<true, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<true, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, true); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UTF32be>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32be; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UTF32be; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, false, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<false, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<false, false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, false); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UCS4le>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32le; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UCS4le; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, false, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<true, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<true, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, true); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::UCS4be>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32be; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::UCS4be; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, false, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<false, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<false, false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, false); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU32le>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32le; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU32le; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, true, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<true, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<true, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, true); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, true, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, true, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU32be>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32be; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU32be; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, true, false); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<false, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<false, true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, false); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU4le>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32le; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU32le; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, true, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<true, true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<true, true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, true); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, true, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, true, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CESU4be>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::UTF32be; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CESU32be; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 4; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return lenUTF32(unicode, true, true); }
+    static constexpr uint32_t       lenBOM() noexcept { return 4; }
+    static constexpr uint32_t       lenNull() noexcept { return 4; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeUTF32<false, true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeUTF32<false, true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_BOM(text, bytes, false); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF32_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backUTF32(text, count, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepUTF32(text, count, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::BYTE>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::BYTE; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x000000ffu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeBYTE<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeBYTE<false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backBYTE(text, count, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepBYTE(text, count, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::BYTEns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::BYTEns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x000000ffu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeBYTE<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeBYTE<false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backBYTE(text, count, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepBYTE(text, count, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::ASCII>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::ASCII; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeBYTE<true, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeBYTE<true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backBYTE(text, count, true, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepBYTE(text, count, true, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::ASCIIns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::ASCIIns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 3; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeBYTE<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeBYTE<true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_BOM(text, bytes); }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backBYTE(text, count, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepBYTE(text, count, true, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CP1252>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CP1252; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 0; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeCP1252<false, true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeCP1252<false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { (void)text; bytes = 0; return cp_errors::bits::None; }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backCP1252(text, count, false, true); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepCP1252(text, count, false, true); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CP1252ns>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CP1252ns; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 0; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeCP1252<false, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeCP1252<false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { (void)text; bytes = 0; return cp_errors::bits::None; }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backCP1252(text, count, false, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepCP1252(text, count, false, false); }
+};
+
+template<> struct codec<UTF_SUB_TYPE::CP1252st>
+{
+    static constexpr UTF_TYPE       utfType(void) noexcept { return UTF_TYPE::OTHER; }
+    static constexpr UTF_SUB_TYPE   utfSubType(void) noexcept { return UTF_SUB_TYPE::CP1252st; }
+    static constexpr uint32_t       unitSize(void) noexcept { return 1; }
+    static uint32_t                 len(const unicode_t unicode) noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
+    static constexpr uint32_t       lenBOM() noexcept { return 0; }
+    static constexpr uint32_t       lenNull() noexcept { return 1; }
+    static [[nodiscard]] cp_errors  get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept { return decodeCP1252<true, false>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  set(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept { return encodeCP1252<true>(text, unicode, bytes); }
+    static [[nodiscard]] cp_errors  setBOM(utf_text& text, uint32_t& bytes) noexcept { (void)text; bytes = 0; return cp_errors::bits::None; }
+    static [[nodiscard]] cp_errors  setNull(utf_text& text, uint32_t& bytes) noexcept { return encodeUTF8_NULL(text, bytes); }
+    static uint32_t                 back(utf_text& text, const uint32_t count) noexcept { return backCP1252(text, count, true, false); }
+    static uint32_t                 step(utf_text& text, const uint32_t count) noexcept { return stepCP1252(text, count, true, false); }
+};
+
 /// encoded unicode code-point handling functions abstraction interface with utility functions
 struct IUTFTK
 {
@@ -402,12 +939,18 @@ public:
     virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept = 0;
     virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept = 0;
     virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept = 0;
+    //  virtual block functions (the defaults read or write the buffer one code-point at a time):
+    virtual [[nodiscard]] cp_errors decodeBlock(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed) const noexcept;
+    virtual [[nodiscard]] cp_errors encodeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept;
     //  non-virtual utility functions:
     [[nodiscard]] cp_errors         read(utf_text& text, unicode_t& unicode) const noexcept;
     [[nodiscard]] cp_errors         write(utf_text& text, const unicode_t unicode) const noexcept;
     [[nodiscard]] cp_errors         writeBOM(utf_text& text) const noexcept;
     [[nodiscard]] cp_errors         writeNull(utf_text& text) const noexcept;
     [[nodiscard]] cp_errors         validate(const utf_text& text) const noexcept;
+    [[nodiscard]] cp_errors         validate(const utf_text& text, uint32_t& failed, const uint32_t threads = 0) const noexcept;
+    [[nodiscard]] cp_errors         readBlock(utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& failed) const noexcept;
+    [[nodiscard]] cp_errors         writeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count) const noexcept;
     //  non-virtual normalised line-feed functions (0x0a, 0x0b, 0x0c, 0x0d, 0x85, 0x2028, 0x2029, {0x0d, 0x0a} and {0x0a,0x0d} are all translated to 0x0a):
     [[nodiscard]] cp_errors         getNLF(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept;
     [[nodiscard]] cp_errors         readNLF(utf_text& text, unicode_t& unicode) const noexcept;
@@ -415,6 +958,305 @@ public:
     [[nodiscard]] cp_errors         readLine(utf_text& text, utf_text& line) const noexcept;
 };
 
+// ==== multi-threaded transcoding function ====
+
+/// transcodes src to dst using multiple threads (0 for std::thread::hardware_concurrency())
+///
+///     The result is identical to a single threaded loop reading code-points from src with srcHandler and writing them
+///     to dst with dstHandler that stops on the first error: src.offset is advanced past the code-points transcoded and
+///     dst.offset past the bytes written. Bytes in dst beyond the returned dst.offset may have been overwritten.
+///
+[[nodiscard]] cp_errors transcode(const IUTFTK& srcHandler, const IUTFTK& dstHandler, utf_text& src, utf_text& dst, const uint32_t threads = 0) noexcept;
+
+// ==== multi-threaded line table function ====
+
+/// builds the table of line start offsets of text using multiple threads (0 for std::thread::hardware_concurrency())
+///
+///     The table holds the offsets at which a single threaded loop of readLine() calls from text.offset until the end of
+///     the text (or the first error) starts each line it reads, so lines end at the terminators found by getNLF() and at
+///     NULL. The returned cp_errors are the accumulated cp_errors of those readLine() calls and 'count' is the number of
+///     line starts. Only the first 'capacity' entries are written and cp_errors::bits::WriteOverflow is returned if the
+///     count does not fit. offsets may be nullptr to count the lines, the cp_errors are then those of a table that fits.
+///     Entries beyond 'count' may have been overwritten.
+///
+[[nodiscard]] cp_errors build_line_table(const IUTFTK& handler, const utf_text& text, uint32_t* const offsets, const uint32_t capacity, uint32_t& count, const uint32_t threads = 0) noexcept;
+
+// ==== line ending normalisation functions ====
+
+/// line terminator enumeration
+enum class NLF_TYPE : int32_t
+{
+    LF          = 0,    //  line-feed (U+000A)
+    CR          = 1,    //  carriage return (U+000D)
+    CRLF        = 2,    //  carriage return, line-feed (U+000D, U+000A)
+    NEL         = 3,    //  next line (U+0085)
+    LS          = 4,    //  line separator (U+2028)
+    PS          = 5,    //  paragraph separator (U+2029)
+    COUNT       = 6     //  count of line terminators
+};
+
+/// the output of a borrowing call, a view of either src (nothing was written) or the bytes written to dst
+///
+///     The output is text.buffer[text.offset] up to text.buffer[text.length]. A borrowed view is only valid while the
+///     source buffer is.
+///
+struct borrow_result
+{
+    utf_text        text;       //  the output view (text.length is the end offset, not the size of the buffer)
+    bool            borrowed;   //  true if text is a view of src
+};
+
+/// copies src to dst replacing every line terminator found by getNLF() with the terminator encoded with handler
+///
+///     The result is the same as a loop of readNLF() calls that stops on the first error, copying the bytes read unless
+///     getNLF() reports a line terminator: src.offset is advanced past the code-points read and dst.offset past the
+///     bytes written. Spans without line terminators are found by the bulk kernels and copied with memmove().
+///
+[[nodiscard]] cp_errors normalizeLineEndings(const IUTFTK& handler, utf_text& src, utf_text& dst, const NLF_TYPE terminator = NLF_TYPE::LF) noexcept;
+
+/// replaces every line terminator found by getNLF() in text (from text.offset) with the terminator encoded with handler
+///
+///     The text can only shrink so the terminator must encode no longer than a line-feed (LF or CR, or NEL, LS and PS
+///     for UTF16 and UTF32), cp_errors::bits::WriteOverflow is returned without changes otherwise. The bytes after the
+///     rewritten text are moved down and text.length is reduced to match. On return text.offset is at the end of the
+///     rewritten text (the failing code-point if there is an error).
+///
+[[nodiscard]] cp_errors normalizeLineEndings(const IUTFTK& handler, utf_text& text, const NLF_TYPE terminator = NLF_TYPE::LF) noexcept;
+
+/// normalizeLineEndings() that borrows src when it would be copied unchanged
+///
+///     The source is scanned first without writing. If every line terminator already matches, result borrows src,
+///     src.offset is advanced to src.length and dst is not used. Otherwise the bytes before the first change are copied
+///     in one pass and normalisation continues from there, result is the view of the bytes written to dst. The errors
+///     returned and the offsets are the same as normalizeLineEndings().
+///
+[[nodiscard]] cp_errors normalizeLineEndings(const IUTFTK& handler, utf_text& src, utf_text& dst, borrow_result& result, const NLF_TYPE terminator = NLF_TYPE::LF) noexcept;
+
+// ==== sanitising transcoder ====
+
+/// sanitize policy (the defaults replace every sequence for which cp_errors::use_replacement_character() is true)
+struct sanitize_policy
+{
+    unicode_t       replacement = 0x0000fffd;   //  written in place of each replaced sequence (U+FFFD REPLACEMENT CHARACTER)
+    unicode_t       fallback = 0x0000003f;      //  written instead when the destination cannot encode the replacement ('?')
+    bool            non_characters = true;      //  replace non-characters (otherwise they are transcoded)
+    bool            irregular_forms = true;     //  replace irregular forms such as unpaired surrogates (otherwise they are transcoded)
+    bool            unencodable = true;         //  replace code-points the destination cannot encode (otherwise sanitize() stops on them)
+};
+
+/// sanitize statistics (the count of sequences replaced for each class of repair)
+struct sanitize_stats
+{
+    uint32_t        replaced;                   //  replacement characters written (the sum of the classes below)
+    uint32_t        malformed;                  //  sequences that failed to decode (cp_errors::bits::NotDecodable)
+    uint32_t        truncated;                  //  sequences cut short by the end of src (counted in malformed)
+    uint32_t        non_characters;             //  non-characters (cp_errors::bits::NonCharacter)
+    uint32_t        irregular_forms;            //  irregular forms (cp_errors::bits::IrregularForm)
+    uint32_t        unencodable;                //  code-points the destination cannot encode
+    uint32_t        fallbacks;                  //  replacements written as the fallback
+};
+
+/// transcodes src to dst with srcHandler and dstHandler, replacing the sequences selected by the policy
+///
+///     The result is the same as a loop reading code-points with srcHandler.get() and writing them with dstHandler.set()
+///     that writes the replacement in place of each failed or selected sequence, so a malformed run produces as many
+///     replacements as the source sub-type decodes sequences (one for a coalescing decoder, one per byte for the ns and
+///     st sub-types). Spans that decode cleanly are copied or converted by the bulk kernels. Stops on buffer errors,
+///     when dst is full or if neither the replacement nor the fallback can be encoded, returning the errors of the
+///     code-point that stopped it: src.offset is advanced past the code-points sanitized and dst.offset past the bytes
+///     written. Bytes in dst beyond the returned dst.offset may have been overwritten.
+///
+[[nodiscard]] cp_errors sanitize(const IUTFTK& srcHandler, const IUTFTK& dstHandler, utf_text& src, utf_text& dst, const sanitize_policy& policy = sanitize_policy(), sanitize_stats* const stats = nullptr) noexcept;
+
+/// sanitize() within a single encoding that borrows src when it is already clean
+///
+///     The source is validated first by the bulk kernels without writing. If sanitize() would copy every code-point
+///     unchanged, result borrows src, src.offset is advanced to src.length and dst is not used. Otherwise the bytes
+///     before the first repair are copied in one pass and sanitising continues from there, result is the view of the
+///     bytes written to dst. The errors returned, the offsets and the stats are the same as sanitize().
+///
+[[nodiscard]] cp_errors sanitize(const IUTFTK& handler, utf_text& src, utf_text& dst, borrow_result& result, const sanitize_policy& policy = sanitize_policy(), sanitize_stats* const stats = nullptr) noexcept;
+
+// ==== streaming decoder ====
+
+/// decodes a stream delivered in chunks, holding back the bytes of a sequence cut short by the end of a chunk
+///
+///     The code-points and errors reported are the same as if all of the chunks had been decoded as one buffer. Up to 16
+///     pending bytes are held between calls, enough for any truncated sequence including a truncated surrogate pair
+///     (UTF16, CESU8 and CESU32) and for the part of a UTF16 or UTF32 code-unit split between chunks.
+///
+///     The chunks are decoded in place, only the pending bytes are copied. Call finish() at the end of the stream to
+///     decode any pending bytes.
+///
+class stream_decoder
+{
+public:
+    static constexpr uint32_t       PendingLimit = 16;
+    explicit                        stream_decoder(const IUTFTK& handler) noexcept : decoder(&handler), held(0) {}
+    inline const IUTFTK&            handler() const noexcept { return *decoder; }
+    inline uint32_t                 pending() const noexcept { return held; }
+    inline void                     reset() noexcept { held = 0; }
+    /// decodes code-points until the chunk or the output is exhausted, decoding continues past decode fails (as decodeBlock())
+    ///
+    ///     'consumed' is the number of chunk bytes decoded or held, if the output was filled the rest of the chunk must be
+    ///     fed again. The byte index of the returned cp_errors is that of the first failing sequence.
+    ///
+    [[nodiscard]] cp_errors         feed(const uint8_t* const data, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& consumed) noexcept;
+    /// transcodes code-points to dst using dstHandler until the chunk is exhausted, stops on any errors (as transcode())
+    ///
+    ///     The failing sequence is not consumed, dst.offset is advanced past the bytes written.
+    ///
+    [[nodiscard]] cp_errors         feed(const uint8_t* const data, const uint32_t size, const IUTFTK& dstHandler, utf_text& dst, uint32_t& consumed) noexcept;
+    /// decodes the pending bytes at the end of the stream (a partial code-unit fails with cp_errors::bits::ReadTruncated)
+    [[nodiscard]] cp_errors         finish(unicode_t* const unicodes, const uint32_t capacity, uint32_t& count) noexcept;
+    /// transcodes the pending bytes at the end of the stream to dst using dstHandler, stops on any errors
+    [[nodiscard]] cp_errors         finish(const IUTFTK& dstHandler, utf_text& dst) noexcept;
+private:
+    [[nodiscard]] cp_errors         decodeChunk(const uint8_t* const data, const uint32_t size, const bool flush, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& consumed) noexcept;
+    [[nodiscard]] cp_errors         transcodeChunk(const uint8_t* const data, const uint32_t size, const bool flush, const IUTFTK& dstHandler, utf_text& dst, uint32_t& consumed) noexcept;
+    [[nodiscard]] cp_errors         peek(const uint8_t* const data, const uint32_t size, const uint32_t offset, const bool flush, unicode_t& unicode, uint32_t& bytes, bool& hold) const noexcept;
+    void                            advance(const uint8_t* const data, const uint32_t size, uint32_t& offset, const uint32_t bytes, const bool hold) noexcept;
+    const IUTFTK*                   decoder;
+    uint32_t                        held;
+    uint8_t                         carry[PendingLimit];
+};
+
+// ==== streaming encoder ====
+
+/// encodes a stream into a ring or sequence of fixed capacity segments supplied by the caller
+///
+///     Each full segment is handed to the segment function which returns the segment to write next (for example the
+///     next slot of a ring once the previous write has been queued) or nullptr to stop, after which writes fail with
+///     cp_errors::bits::WriteOverflow. A code-point that does not fit in the rest of a segment is written to the next
+///     segment (the segment is handed over short) unless splitting is enabled, in which case segments are always filled
+///     and an encoded sequence may continue in the next segment. The segment capacity must be a multiple of the code-unit
+///     size and, without splitting, at least as large as the longest encoded sequence.
+///
+///     Call flush() to hand over a partially filled segment, the segment function is called with the same segment.
+///
+class stream_encoder
+{
+public:
+    using segment_function = uint8_t* (*)(void* const context, uint8_t* const segment, const uint32_t size) noexcept;
+    inline                          stream_encoder(const IUTFTK& handler, uint8_t* const first, const uint32_t size, const segment_function function, void* const user, const bool splitting = false) noexcept
+                                        : encoder(&handler), segment(first), capacity(size), used(0), deliver(function), context(user), split(splitting) {}
+    inline const IUTFTK&            handler() const noexcept { return *encoder; }
+    inline uint32_t                 pending() const noexcept { return used; }
+    /// encodes a code-point, handing over the segment when it is full
+    [[nodiscard]] cp_errors         write(const unicode_t unicode) noexcept;
+    /// encodes code-points a segment at a time using encodeBlock() until the input is exhausted, stops on any errors (the failing code-point is unicodes[count])
+    [[nodiscard]] cp_errors         write(const unicode_t* const unicodes, const uint32_t length, uint32_t& count) noexcept;
+    /// hands over the current segment if it is not empty
+    [[nodiscard]] cp_errors         flush() noexcept;
+private:
+    [[nodiscard]] cp_errors         advance() noexcept;
+    const IUTFTK*                   encoder;
+    uint8_t*                        segment;
+    uint32_t                        capacity;
+    uint32_t                        used;
+    segment_function                deliver;
+    void*                           context;
+    bool                            split;
+};
+
+// ==== sparse code-point offset index ====
+
+/// sparse index of the byte offsets of every interval'th code-point of a buffer for fast random access
+///
+///     The offsets are stored in caller supplied storage. When the storage is full every other offset is dropped and
+///     the interval is doubled, so the index always fits. Code-points are the sequences decoded by the handler (blocks
+///     are counted with decodeBlock()), so seek(text, n) leaves text.offset where n calls to read() from the start of
+///     the buffer would. The text.length must be a multiple of the code-unit size.
+///
+///     Code-point numbers are relative to the text.offset passed to build(). The utf_text passed to the other functions
+///     must describe the same buffer (text.length may grow, see extend()).
+///
+class cp_index
+{
+public:
+    static constexpr uint32_t       HoldBack = 16;
+    inline                          cp_index(const IUTFTK& handler, uint32_t* const storage, const uint32_t size, const uint32_t interval = 1024) noexcept
+                                        : counter(&handler), offsets(storage), capacity(size & ~1u), spacing(interval ? interval : 1), entries(0), points(0), indexed(0) {}
+    inline const IUTFTK&            handler() const noexcept { return *counter; }
+    inline uint32_t                 interval() const noexcept { return spacing; }
+    inline uint32_t                 count() const noexcept { return points; }
+    inline uint32_t                 length() const noexcept { return indexed; }
+    /// indexes the buffer from text.offset to text.length, returns false if the text or the storage (at least 2 entries) is invalid
+    [[nodiscard]] bool              build(const utf_text& text) noexcept;
+    /// extends the index to a grown text.length (the bytes already indexed must be unchanged), the last HoldBack bytes indexed are re-indexed
+    [[nodiscard]] bool              extend(const utf_text& text) noexcept;
+    /// sets text.offset to the start of code-point 'point' and returns 'point', or to text.length and returns the number of code-points if there are fewer
+    uint32_t                        seek(utf_text& text, const uint32_t point) const noexcept;
+    /// returns the number of the code-point that contains the byte at 'offset' (the number of code-points if offset is at or beyond the end)
+    uint32_t                        codePointAt(const utf_text& text, const uint32_t offset) const noexcept;
+private:
+    void                            index(const utf_text& text) noexcept;
+    uint32_t                        skip(utf_text& text, const uint32_t count) const noexcept;
+    const IUTFTK*                   counter;
+    uint32_t*                       offsets;
+    uint32_t                        capacity;
+    uint32_t                        spacing;
+    uint32_t                        entries;
+    uint32_t                        points;
+    uint32_t                        indexed;
+};
+
+// ==== UTF8 line and UTF16 column position index ====
+
+/// index mapping UTF8 byte offsets to and from {line, UTF16 column} positions (language server protocol positions)
+///
+///     Lines are ended by 0x0a, 0x0d or {0x0d, 0x0a} and a terminator at the end of the text starts an empty last line.
+///     Columns count the UTF16 code-units of the line: 2 for each 4 byte sequence and 1 for each other sequence accepted
+///     by getUTF8() and for each byte it rejects (as if the byte was replaced by U+FFFD).
+///
+///     An anchor {offset, line, column} is stored in caller supplied storage at the start of every line and at the
+///     first sequence at least interval bytes after the previous anchor of a long line. A lookup is a binary search
+///     followed by a scan of at most interval bytes. The storage needs at most (lines + (bytes / interval)) anchors,
+///     build() and update() return false and leave the index empty if it runs out.
+///
+///     Offsets are byte offsets in text.buffer and lines are relative to the text.offset passed to build(). The
+///     utf_text passed to the other functions must describe the same buffer, as edited if update() was called.
+///
+class position_index
+{
+public:
+    struct anchor
+    {
+        uint32_t                    offset;
+        uint32_t                    line;
+        uint32_t                    column;
+    };
+    inline                          position_index(anchor* const storage, const uint32_t size, const uint32_t interval = 256) noexcept
+                                        : anchors(storage), capacity(size), spacing(interval ? interval : 1), entries(0), indexed(0) {}
+    inline uint32_t                 interval() const noexcept { return spacing; }
+    inline uint32_t                 count() const noexcept { return entries; }
+    inline uint32_t                 lines() const noexcept { return (entries ? (anchors[entries - 1].line + 1) : 0); }
+    inline uint32_t                 length() const noexcept { return indexed; }
+    /// indexes the buffer from text.offset to text.length, returns false if the text is invalid or the storage is too small
+    [[nodiscard]] bool              build(const utf_text& text) noexcept;
+    /// re-indexes the buffer after the 'removed' bytes at 'offset' were replaced by 'inserted' bytes (text is the edited buffer)
+    ///
+    ///     Replacing lines first to last is update(text, offsetOf(text, first, 0), offsetOf(text, last + 1, 0) - offset, size)
+    ///     with the offsets taken before the edit. Only the anchors from the edit up to the first unchanged line are rebuilt.
+    ///
+    [[nodiscard]] bool              update(const utf_text& text, const uint32_t offset, const uint32_t removed, const uint32_t inserted) noexcept;
+    /// returns the byte offset of {line, column}, a column beyond the end of the line is clamped to the end of the line (before
+    /// the terminator), a column between the code-units of a surrogate pair is rounded down and a line beyond the last line
+    /// returns text.length
+    uint32_t                        offsetOf(const utf_text& text, const uint32_t line, const uint32_t column) const noexcept;
+    /// sets {line, column} for the byte offset and returns the byte offset of that position, an offset inside a sequence is
+    /// rounded down to the start of the sequence and an offset inside a line terminator is clamped to the end of the line
+    uint32_t                        positionOf(const utf_text& text, const uint32_t offset, uint32_t& line, uint32_t& column) const noexcept;
+private:
+    [[nodiscard]] bool              index(const utf_text& text, uint32_t tail, const uint32_t resume, const uint32_t shift) noexcept;
+    uint32_t                        anchorAt(const uint32_t offset) const noexcept;
+    anchor*                         anchors;
+    uint32_t                        capacity;
+    uint32_t                        spacing;
+    uint32_t                        entries;
+    uint32_t                        indexed;
+};
+
 // ==== inline function bodies ====
 
 [[nodiscard]] cp_errors get_errors(const utf_text& text) noexcept
@@ -456,6 +1298,907 @@ constexpr [[nodiscard]] bool isOverlongUTF8(const unicode_t unicode, const uint3
     return overlong;
 }
 
+namespace internal
+{
+
+/// internal low level UTF8 fetch function
+/// 
+///     This is a helper function for the decodeUTF8() function and only returns a subset of the error codes.
+/// 
+///     The coalesce flag controls the bytes count set when handling sequences with an illegal or invalid lead byte:
+/// 
+///         coalesce == false   :   bytes = 1
+///         coalesce == true    :   bytes = offset to the next valid lead byte or buffer end (limit)
+/// 
+inline [[nodiscard]] cp_errors fetchUTF8(const uint8_t* const buffer, const uint32_t size, unicode_t& unicode, uint32_t& bytes, const bool coalesce) noexcept
+{
+    cp_errors errors;
+    bytes = 0;
+    unicode = 0;
+    if (size < 1)
+    {
+        errors = cp_errors::bits::ReadExhausted;
+    }
+    else
+    {
+        uint8_t byte = buffer[0];
+        unicode = static_cast<unicode_t>(byte);
+        if (static_cast<uint8_t>(byte + 2) <= 0xc1u)
+        {   //  1 byte (7 bits: 0x00-0x7f) or unexpected continuation byte (0x80-0xbf) or illegal leading byte (0xfe-0xff)
+            bytes = 1;
+            if (byte > 0x7fu)
+            {
+                errors |= ((cp_errors::bits::Failed | cp_errors::bits::NotDecodable) | ((byte >= 0xfeu) ? cp_errors::bits::DisallowedByte : cp_errors::bits::UnexpectedByte));
+                if (coalesce)
+                {
+                    uint32_t count = size;
+                    for (uint32_t index = 1; index < count; ++index)
+                    {
+                        byte = buffer[index];
+                        if (((byte & 0xc0u) != 0x80u) && (byte < 0xfeu))
+                        {
+                            count = index;
+                            break;
+                        }
+                    }
+                    bytes = count;
+                }
+            }
+        }
+        else
+        {
+            uint32_t count = 0;
+            if (byte <= 0xefu)
+            {   //  2 bytes (11 bits: 0xc0-0xdf) or 3 bytes (16 bits: 0xe0-0xef)
+                count = static_cast<uint32_t>((byte >> 5) & 3);
+            }
+            else if (byte <= 0xf7u)
+            {   //  4 bytes (21 bits: 0xf0-0xf7)
+                count = 4;
+            }
+            else
+            {   //  extended encoding: 5 bytes (26 bits: 0xf8-0xfb) or 6 bytes (31 bits: 0xfc-0xfd)
+                count = static_cast<uint32_t>(((byte >> 2) & 7) - 1);
+                errors |= cp_errors::bits::ExtendedUTF8;
+            }
+            if (count > size)
+            {   //  truncated continuation
+                count = size;
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable | cp_errors::bits::ReadTruncated);
+            }
+            unicode_t value = (static_cast<unicode_t>(byte) & ((unicode_t(1) << (7 - count)) - 1));
+            for (uint32_t index = 1; index < count; ++index)
+            {
+                byte = buffer[index];
+                if ((byte & 0xc0u) != 0x80u)
+                {
+                    errors.clear(cp_errors::bits::ReadTruncated);
+                    errors |= ((cp_errors::bits::Failed | cp_errors::bits::NotDecodable) | ((byte >= 0xfeu) ? cp_errors::bits::DisallowedByte : cp_errors::bits::UnexpectedByte));
+                    errors.set_byte_index(index);
+                    count = index;
+                    break;
+                }
+                value = ((value << 6) | (byte & 0x3fu));
+            }
+            bytes = count;
+            if (errors.no_error())
+            {
+                unicode = value;
+                if (count > 1)
+                {   //  possible overlong
+                    int32_t n = (static_cast<int32_t>(count | (count << 2)) - 11);
+                    if ((value >> static_cast<uint32_t>((n & ((~n) >> 31)) + 7)) == 0)
+                    {   //  the unicode character used an overlong or modified encoding: a 2 byte UTF8 encoding of U+0000 is a common exception to the overlong encoding rule notably used in Java
+                        errors |= (((value == 0) && (count == 2)) ? cp_errors::bits::ModifiedUTF8 : cp_errors::bits::OverlongUTF8);
+                    }
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+};  //  namespace internal
+
+template<bool use_ascii>
+[[nodiscard]] cp_errors encodeBYTE(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    cp_errors errors = get_errors(text);
+    if (static_cast<uint32_t>(unicode) <= 0x00000000u)
+    {
+        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : cp_errors::bits::DelimitString);
+    }
+    else if (static_cast<uint32_t>(unicode) > (use_ascii ? 0x0000007fu : 0x000000ffu))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::NotEnoughBits);
+        if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+        {
+            if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+            {
+                errors |= cp_errors::bits::ExtendedUCS4;
+            }
+            else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+            {
+                if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+                {
+                    errors |= cp_errors::bits::NonCharacter;
+                }
+                if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+                {
+                    errors |= cp_errors::bits::Supplementary;
+                }
+            }
+            else if ((unicode & 0xfffff800u) == 0x0000d800u)
+            {
+                errors |= ((unicode & 0x00000400u) ? cp_errors::bits::LowSurrogate : cp_errors::bits::HighSurrogate);
+            }
+        }
+    }
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < 1)
+        {   //  buffer overflow
+            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        }
+        else
+        {
+            uint8_t* const buffer = &text.buffer[text.offset];
+            buffer[0] = static_cast<uint8_t>(unicode);
+            bytes = 1;
+        }
+    }
+    return errors;
+}
+
+template<bool use_cesu, bool use_java>
+[[nodiscard]] cp_errors encodeUTF8(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    cp_errors errors = get_errors(text);
+    if (static_cast<uint32_t>(unicode) <= 0x00000000u)
+    {
+        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : (use_java ? cp_errors::bits::ModifiedUTF8 : cp_errors::bits::DelimitString));
+    }
+    else if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+    {
+        if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+        {
+            errors |= ((static_cast<uint32_t>(unicode) > 0x001fffffu) ? (cp_errors::bits::ExtendedUTF8 | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm) : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+        }
+        else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+        {
+            if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+            {
+                errors |= cp_errors::bits::NonCharacter;
+            }
+            if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+            {
+                errors |= (use_cesu ? (cp_errors::bits::Supplementary | cp_errors::bits::SurrogatePair) : cp_errors::bits::Supplementary);
+            }
+        }
+        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        {
+            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+        }
+    }
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        uint8_t* const buffer = &text.buffer[text.offset];
+        if (static_cast<uint32_t>(unicode) <= 0x0000007fu)
+        {   //  1 byte (standard UTF8: 7 bits) or 2 bytes (modified NULL: 11 bits)
+            if (errors.any(cp_errors::bits::ModifiedUTF8))
+            {   //  2 bytes (modified NULL: 11 bits)
+                if (limit < 2)
+                {   //  buffer overflow
+                    errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+                }
+                else
+                {
+                    buffer[0] = 0xc0u;
+                    buffer[1] = 0x80u;
+                    bytes = 2;
+                }
+            }
+            else
+            {   //  1 byte (standard UTF8: 7 bits)
+                if (limit < 1)
+                {   //  buffer overflow
+                    errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+                }
+                else
+                {
+                    buffer[0] = static_cast<uint8_t>(unicode);
+                    bytes = 1;
+                }
+            }
+        }
+        else if (static_cast<uint32_t>(unicode) <= 0x000007ffu)
+        {   //  2 bytes (11 bits)
+            if (limit < 2)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                buffer[0] = (static_cast<uint8_t>(unicode >> 6) | 0xc0u);
+                buffer[1] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
+                bytes = 2;
+            }
+        }
+        else if (static_cast<uint32_t>(unicode) <= 0x0000ffffu)
+        {   //  3 bytes (16 bits)
+            if (limit < 3)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                buffer[0] = (static_cast<uint8_t>(unicode >> 12) | 0xe0u);
+                buffer[1] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
+                buffer[2] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
+                bytes = 3;
+            }
+        }
+        else if ((static_cast<uint32_t>(unicode) <= 0x0010ffffu) && errors.any(cp_errors::bits::SurrogatePair))
+        {   //  6 bytes (CESU UTF8: UTF16 surrogates encoded as 2 UTF8 characters)
+            if (limit < 6)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                unicode_t surrogate = (unicode - 0x00010000u);
+                surrogate = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
+                buffer[0] = ((static_cast<uint8_t>(surrogate >> 12) & 0x0fu) | 0xe0u);
+                buffer[1] = ((static_cast<uint8_t>(surrogate >> 6) & 0x3fu) | 0x80u);
+                buffer[2] = ((static_cast<uint8_t>(surrogate) & 0x3fu) | 0x80u);
+                buffer[3] = ((static_cast<uint8_t>(surrogate >> 28) & 0x0fu) | 0xe0u);
+                buffer[4] = ((static_cast<uint8_t>(surrogate >> 22) & 0x3fu) | 0x80u);
+                buffer[5] = ((static_cast<uint8_t>(surrogate >> 16) & 0x3fu) | 0x80u);
+                bytes = 6;
+            }
+        }
+        else if (static_cast<uint32_t>(unicode) <= 0x001fffffu)
+        {   //  4 bytes (21 bits)
+            if (limit < 4)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                buffer[0] = (static_cast<uint8_t>(unicode >> 18) | 0xf0u);
+                buffer[1] = ((static_cast<uint8_t>(unicode >> 12) & 0x3fu) | 0x80u);
+                buffer[2] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
+                buffer[3] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
+                bytes = 4;
+            }
+        }
+        else if (static_cast<uint32_t>(unicode) <= 0x03ffffffu)
+        {   //  5 bytes (26 bits)
+            if (limit < 5)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                buffer[0] = (static_cast<uint8_t>(unicode >> 24) | 0xf8u);
+                buffer[1] = ((static_cast<uint8_t>(unicode >> 18) & 0x3fu) | 0x80u);
+                buffer[2] = ((static_cast<uint8_t>(unicode >> 12) & 0x3fu) | 0x80u);
+                buffer[3] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
+                buffer[4] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
+                bytes = 5;
+            }
+        }
+        else
+        {   //  6 bytes (31 bits)
+            if (limit < 6)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                buffer[0] = (static_cast<uint8_t>(unicode >> 30) | 0xfcu);
+                buffer[1] = ((static_cast<uint8_t>(unicode >> 24) & 0x3fu) | 0x80u);
+                buffer[2] = ((static_cast<uint8_t>(unicode >> 18) & 0x3fu) | 0x80u);
+                buffer[3] = ((static_cast<uint8_t>(unicode >> 12) & 0x3fu) | 0x80u);
+                buffer[4] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
+                buffer[5] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
+                bytes = 6;
+            }
+        }
+    }
+    return errors;
+}
+
+template<bool le, bool use_ucs2>
+[[nodiscard]] cp_errors encodeUTF16(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    cp_errors errors = get_errors(text, 1);
+    if (static_cast<uint32_t>(unicode) <= 0x00000000u)
+    {
+        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : cp_errors::bits::DelimitString);
+    }
+    else if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+    {
+        if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+        {
+            errors |= (cp_errors::bits::Failed | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::NotEnoughBits);
+        }
+        else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+        {
+            if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+            {
+                errors |= cp_errors::bits::NonCharacter;
+            }
+            if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+            {
+                errors |= (use_ucs2 ? (cp_errors::bits::Failed | cp_errors::bits::Supplementary | cp_errors::bits::NotEnoughBits) : (cp_errors::bits::Supplementary | cp_errors::bits::SurrogatePair));
+            }
+        }
+        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        {
+            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+        }
+    }
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        uint8_t* const buffer = &text.buffer[text.offset];
+        if (errors.any(cp_errors::bits::SurrogatePair))
+        {   //  surrogate pair
+            if (limit < 4)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                unicode_t surrogate = (unicode - 0x00010000u);
+                surrogate = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
+                if (le)
+                {
+                    buffer[0] = static_cast<uint8_t>(surrogate);
+                    buffer[1] = static_cast<uint8_t>(surrogate >> 8);
+                    buffer[2] = static_cast<uint8_t>(surrogate >> 16);
+                    buffer[3] = static_cast<uint8_t>(surrogate >> 24);
+                }
+                else
+                {
+                    buffer[0] = static_cast<uint8_t>(surrogate >> 8);
+                    buffer[1] = static_cast<uint8_t>(surrogate);
+                    buffer[2] = static_cast<uint8_t>(surrogate >> 24);
+                    buffer[3] = static_cast<uint8_t>(surrogate >> 16);
+                }
+                bytes = 4;
+            }
+        }
+        else
+        {   //  simple UTF16
+            if (limit < 2)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                if (le)
+                {
+                    buffer[0] = static_cast<uint8_t>(unicode);
+                    buffer[1] = static_cast<uint8_t>(unicode >> 8);
+                }
+                else
+                {
+                    buffer[0] = static_cast<uint8_t>(unicode >> 8);
+                    buffer[1] = static_cast<uint8_t>(unicode);
+                }
+                bytes = 2;
+            }
+        }
+    }
+    return errors;
+}
+
+template<bool le, bool use_cesu, bool use_ucs4>
+[[nodiscard]] cp_errors encodeUTF32(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    cp_errors errors = get_errors(text, 3);
+    if (static_cast<uint32_t>(unicode) <= 0x00000000u)
+    {
+        errors |= (unicode ? cp_errors::bits::InvalidPoint : cp_errors::bits::DelimitString);
+    }
+    else if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+    {
+        if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+        {
+            errors |= (use_ucs4 ? cp_errors::bits::ExtendedUCS4 : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+        }
+        else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+        {
+            if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+            {
+                errors |= cp_errors::bits::NonCharacter;
+            }
+            if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+            {
+                errors |= (use_cesu ? (cp_errors::bits::Supplementary | cp_errors::bits::SurrogatePair) : cp_errors::bits::Supplementary);
+            }
+        }
+        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        {
+            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+        }
+    }
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        uint8_t* const buffer = &text.buffer[text.offset];
+        if (errors.any(cp_errors::bits::SurrogatePair))
+        {   //  surrogate pair
+            if (limit < 8)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                unicode_t surrogate = (unicode - 0x00010000u);
+                surrogate = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
+                if (le)
+                {
+                    buffer[0] = static_cast<uint8_t>(surrogate);
+                    buffer[1] = static_cast<uint8_t>(surrogate >> 8);
+                    buffer[2] = buffer[3] = static_cast<uint8_t>(0);
+                    buffer[4] = static_cast<uint8_t>(surrogate >> 16);
+                    buffer[5] = static_cast<uint8_t>(surrogate >> 24);
+                    buffer[6] = buffer[7] = static_cast<uint8_t>(0);
+                }
+                else
+                {
+                    buffer[0] = buffer[1] = static_cast<uint8_t>(0);
+                    buffer[2] = static_cast<uint8_t>(surrogate >> 8);
+                    buffer[3] = static_cast<uint8_t>(surrogate);
+                    buffer[4] = buffer[5] = static_cast<uint8_t>(0);
+                    buffer[6] = static_cast<uint8_t>(surrogate >> 24);
+                    buffer[7] = static_cast<uint8_t>(surrogate >> 16);
+                }
+                bytes = 8;
+            }
+        }
+        else
+        {   //  simple UTF32
+            if (limit < 4)
+            {   //  buffer overflow
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            }
+            else
+            {
+                if (le)
+                {
+                    buffer[0] = static_cast<uint8_t>(unicode);
+                    buffer[1] = static_cast<uint8_t>(unicode >> 8);
+                    buffer[2] = static_cast<uint8_t>(unicode >> 16);
+                    buffer[3] = static_cast<uint8_t>(unicode >> 24);
+                }
+                else
+                {
+                    buffer[0] = static_cast<uint8_t>(unicode >> 24);
+                    buffer[1] = static_cast<uint8_t>(unicode >> 16);
+                    buffer[2] = static_cast<uint8_t>(unicode >> 8);
+                    buffer[3] = static_cast<uint8_t>(unicode);
+                }
+                bytes = 4;
+            }
+        }
+    }
+    return errors;
+}
+
+template<bool strict>
+[[nodiscard]] cp_errors encodeCP1252(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    uint8_t cp1252 = 0;
+    cp_errors errors = get_errors(text);
+    if (static_cast<uint32_t>(unicode) <= 0x00000000u)
+    {
+        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : cp_errors::bits::DelimitString);
+    }
+    else if (!unicodeToCP1252(unicode, cp1252, (strict ? CP1252Strictness::StrictUndefined : CP1252Strictness::WindowsCompatible)))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable);
+        if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+        {
+            if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+            {
+                errors |= cp_errors::bits::ExtendedUCS4;
+            }
+            else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+            {
+                if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+                {
+                    errors |= cp_errors::bits::NonCharacter;
+                }
+                if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+                {
+                    errors |= cp_errors::bits::Supplementary;
+                }
+            }
+            else if ((unicode & 0xfffff800u) == 0x0000d800u)
+            {
+                errors |= ((unicode & 0x00000400u) ? cp_errors::bits::LowSurrogate : cp_errors::bits::HighSurrogate);
+            }
+        }
+    }
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < 1)
+        {   //  buffer overflow
+            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        }
+        else
+        {
+            uint8_t* const buffer = &text.buffer[text.offset];
+            buffer[0] = cp1252;
+            bytes = 1;
+        }
+    }
+    return errors;
+}
+
+template<bool use_ascii, bool coalesce>
+[[nodiscard]] cp_errors decodeBYTE(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    unicode = 0;
+    cp_errors errors = get_errors(text);
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < 1)
+        {   //  buffer over-run
+            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+        }
+        else
+        {
+            uint8_t* const buffer = &text.buffer[text.offset];
+            unicode = static_cast<unicode_t>(buffer[0]);
+            bytes = 1;
+            if (use_ascii && (unicode & 0x00000080u))
+            {
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable | cp_errors::bits::DisallowedByte);
+                if (coalesce)
+                {
+                    uint32_t count = limit;
+                    for (uint32_t index = 1; index < count; ++index)
+                    {
+                        if ((buffer[index] & 0x80u) != 0x80u)
+                        {
+                            count = index;
+                            break;
+                        }
+                    }
+                    bytes = count;
+                }
+            }
+            else if (unicode == 0x00000000u)
+            {
+                errors |= cp_errors::bits::DelimitString;
+            }
+        }
+    }
+    return errors;
+}
+
+template<bool use_cesu, bool use_java, bool strict, bool coalesce>
+[[nodiscard]] cp_errors decodeUTF8(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    unicode = 0;
+    cp_errors errors = get_errors(text);
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        uint8_t* const buffer = &text.buffer[text.offset];
+        if ((limit >= 1) && utf::internal::decodeDFA_UTF8(buffer, limit, unicode, bytes))
+        {   //  well formed UTF8 (the common case): only the informational bits can apply whatever the flags
+            if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+            {
+                if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+                {
+                    errors |= cp_errors::bits::NonCharacter;
+                }
+                if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+                {
+                    errors |= cp_errors::bits::Supplementary;
+                }
+            }
+            else if (unicode == 0x00000000u)
+            {
+                errors |= cp_errors::bits::DelimitString;
+            }
+            return errors;
+        }
+        errors |= internal::fetchUTF8(buffer, limit, unicode, bytes, (coalesce && !strict));
+        if (errors.no_error())
+        {   //  successfully read a UTF8 code-point
+            if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+            {
+                if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+                {
+                    errors |= cp_errors::bits::ExtendedUCS4;
+                }
+                else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+                {
+                    if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+                    {
+                        errors |= cp_errors::bits::NonCharacter;
+                    }
+                    if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+                    {
+                        errors |= cp_errors::bits::Supplementary;
+                    }
+                }
+                else if ((unicode & 0xfffff800u) == 0x0000d800u)
+                {   //  found a surrogate
+                    if (unicode & 0x00000400u)
+                    {   //  found an unpaired low surrogate
+                        errors |= cp_errors::bits::LowSurrogate;
+                    }
+                    else
+                    {   //  found an unpaired or leading high surrogate
+                        errors |= cp_errors::bits::HighSurrogate;
+                        if (use_cesu)
+                        {   //  found a leading high surrogate
+                            uint32_t extra = 0;
+                            unicode_t lowbits = 0;
+                            cp_errors check = internal::fetchUTF8(&buffer[bytes], (limit - bytes), lowbits, extra, false);
+                            if (check & (cp_errors::bits::ReadTruncated | cp_errors::bits::ReadExhausted))
+                            {
+                                errors |= cp_errors::bits::TruncatedPair;
+                            }
+                            else if (check.no_error())
+                            {
+                                if ((lowbits & 0xfffffc00u) == 0x0000dc00u)
+                                {   //  found low surrogate (valid surrogate pair)
+                                    unicode = (((unicode & 0x000003ffu) << 10) + (lowbits & 0x000003ffu) + 0x00010000u);
+                                    bytes += extra;
+                                    errors |= check;
+                                    errors ^= (cp_errors::bits::SurrogatePair | cp_errors::bits::Supplementary | cp_errors::bits::HighSurrogate);
+                                    if ((unicode & 0x0000fffeu) == 0x0000fffeu)
+                                    {
+                                        errors |= cp_errors::bits::NonCharacter;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            else if ((unicode == 0x00000000u) && (errors.none(cp_errors::bits::ModifiedUTF8 | cp_errors::bits::OverlongUTF8)))
+            {
+                errors |= cp_errors::bits::DelimitString;
+            }
+            if (errors.any((use_java ? cp_errors::bits::None : cp_errors::bits::ModifiedUTF8) | (cp_errors::bits::OverlongUTF8 | cp_errors::bits::ExtendedUTF8 | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::HighSurrogate | cp_errors::bits::LowSurrogate)))
+            {
+                errors |= cp_errors::bits::IrregularForm;
+                if (strict)
+                {
+                    errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable);
+                    unicode = static_cast<unicode_t>(buffer[0]);
+                    bytes = 1;
+                }
+            }
+        }
+        else if (strict && (bytes > 1))
+        {
+            bytes = 1;
+        }
+    }
+    return errors;
+}
+
+template<bool le, bool use_ucs2>
+[[nodiscard]] cp_errors decodeUTF16(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    unicode = 0;
+    cp_errors errors = get_errors(text, 1);
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < 2)
+        {   //  buffer over-run
+            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+        }
+        else
+        {
+            uint8_t* const buffer = &text.buffer[text.offset];
+            unicode = (le ? ((static_cast<unicode_t>(buffer[1]) << 8) + buffer[0]) : ((static_cast<unicode_t>(buffer[0]) << 8) + buffer[1]));
+            bytes = 2;
+            if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+            {
+                if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+                {
+                    if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+                    {
+                        errors |= cp_errors::bits::NonCharacter;
+                    }
+                }
+                else if ((unicode & 0xfffff800u) == 0x0000d800u)
+                {   //  found a surrogate
+                    errors |= cp_errors::bits::IrregularForm;
+                    if (unicode & 0x00000400u)
+                    {   //  found an unpaired low surrogate
+                        errors |= cp_errors::bits::LowSurrogate;
+                    }
+                    else
+                    {   //  found an unpaired or leading high surrogate
+                        errors |= cp_errors::bits::HighSurrogate;
+                        if (!use_ucs2)
+                        {   //  found a leading high surrogate
+                            if (limit < 4)
+                            {   //  truncated surrogate pair
+                                errors |= cp_errors::bits::TruncatedPair;
+                            }
+                            else
+                            {
+                                unicode_t lowbits = (le ? ((static_cast<unicode_t>(buffer[3]) << 8) + buffer[2]) : ((static_cast<unicode_t>(buffer[2]) << 8) + buffer[3]));
+                                if ((lowbits & 0xfffffc00u) == 0x0000dc00u)
+                                {   //  found low surrogate (valid surrogate pair)
+                                    unicode = (((unicode & 0x000003ffu) << 10) + (lowbits & 0x000003ffu) + 0x00010000u);
+                                    bytes = 4;
+                                    errors ^= (cp_errors::bits::SurrogatePair | cp_errors::bits::Supplementary | cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm);
+                                    if ((unicode & 0x0000fffeu) == 0x0000fffeu)
+                                    {
+                                        errors |= cp_errors::bits::NonCharacter;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            else if (unicode == 0x00000000u)
+            {
+                errors |= cp_errors::bits::DelimitString;
+            }
+        }
+    }
+    return errors;
+}
+
+template<bool le, bool use_cesu, bool use_ucs4>
+[[nodiscard]] cp_errors decodeUTF32(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    unicode = 0;
+    cp_errors errors = get_errors(text, 3);
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        uint8_t* const buffer = &text.buffer[text.offset];
+        if (limit < 4)
+        {   //  buffer over-run
+            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+        }
+        else
+        {
+            unicode = (le ?
+                ((((((static_cast<unicode_t>(buffer[3]) << 8) + buffer[2]) << 8) + buffer[1]) << 8) + buffer[0]) :
+                ((((((static_cast<unicode_t>(buffer[0]) << 8) + buffer[1]) << 8) + buffer[2]) << 8) + buffer[3]));
+            bytes = 4;
+            if (static_cast<uint32_t>(unicode) <= 0x00000000u)
+            {
+                errors |= (unicode ? (cp_errors::bits::InvalidPoint | cp_errors::bits::IrregularForm) : cp_errors::bits::DelimitString);
+            }
+            else if (static_cast<uint32_t>(unicode) >= 0x0000d800u)
+            {
+                if (static_cast<uint32_t>(unicode) > 0x0010ffffu)
+                {
+                    errors |= (use_ucs4 ? cp_errors::bits::ExtendedUCS4 : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+                }
+                else if (static_cast<uint32_t>(unicode) >= 0x0000fdd0u)
+                {
+                    if ((static_cast<uint32_t>(unicode) <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+                    {
+                        errors |= cp_errors::bits::NonCharacter;
+                    }
+                    if (static_cast<uint32_t>(unicode) > 0x0000ffffu)
+                    {
+                        errors |= cp_errors::bits::Supplementary;
+                    }
+                }
+                else if ((unicode & 0xfffff800u) == 0x0000d800u)
+                {   //  found a surrogate
+                    errors |= cp_errors::bits::IrregularForm;
+                    if (unicode & 0x00000400u)
+                    {   //  found an unpaired low surrogate
+                        errors |= cp_errors::bits::LowSurrogate;
+                    }
+                    else
+                    {   //  found an unpaired or leading high surrogate
+                        errors |= cp_errors::bits::HighSurrogate;
+                        if (use_cesu)
+                        {   //  found a leading high surrogate
+                            if (limit < 8)
+                            {   //  truncated surrogate pair
+                                errors |= cp_errors::bits::TruncatedPair;
+                            }
+                            else
+                            {
+                                unicode_t lowbits = (le ?
+                                    ((((((static_cast<unicode_t>(buffer[7]) << 8) + buffer[6]) << 8) + buffer[5]) << 8) + buffer[4]) :
+                                    ((((((static_cast<unicode_t>(buffer[4]) << 8) + buffer[5]) << 8) + buffer[6]) << 8) + buffer[7]));
+                                if ((lowbits & 0xfffffc00u) == 0x0000dc00u)
+                                {   //  found low surrogate (valid surrogate pair)
+                                    unicode = (((unicode & 0x000003ffu) << 10) + (lowbits & 0x000003ffu) + 0x00010000u);
+                                    bytes = 8;
+                                    errors ^= (cp_errors::bits::SurrogatePair | cp_errors::bits::Supplementary | cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm);
+                                    if ((unicode & 0x0000fffeu) == 0x0000fffeu)
+                                    {
+                                        errors |= cp_errors::bits::NonCharacter;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+template<bool strict, bool coalesce>
+[[nodiscard]] cp_errors decodeCP1252(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    unicode = 0;
+    cp_errors errors = get_errors(text);
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < 1)
+        {   //  buffer over-run
+            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+        }
+        else
+        {
+            CP1252Strictness strictness = strict ? CP1252Strictness::StrictUndefined : CP1252Strictness::WindowsCompatible;
+            uint8_t* const buffer = &text.buffer[text.offset];
+            uint8_t cp1252 = buffer[0];
+            bytes = 1;
+            if (!cp1252ToUnicode(cp1252, unicode, strictness))
+            {
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable);
+                if (coalesce)
+                {
+                    uint32_t count = limit;
+                    for (uint32_t index = 1; index < count; ++index)
+                    {
+                        cp1252 = buffer[index];
+                        if (cp1252ToUnicode(cp1252, unicode, strictness))
+                        {
+                            unicode = 0;
+                            count = index;
+                            break;
+                        }
+                    }
+                    bytes = count;
+                }
+            }
+            else if (unicode == 0x00000000u)
+            {
+                errors |= cp_errors::bits::DelimitString;
+            }
+        }
+    }
+    return errors;
+}
+
 };  //  namespace toolkit
 
 };  //  namespace utf
@@ -0,0 +1,4030 @@
+//  Copyright (c) 2010-2026 Ritchie Brannan
+//  License: MIT (see LICENSE file in repository root)
+//
+//  SuiteUTF
+//  Original design 20102016; maintained and extended 20242025.
+//  Copyright (c) 20102025 Ritchie Brannan.
+//  MIT License. See LICENSE.txt. Project history: docs/History.md.
+//
+//  File:   utf_simd.cpp
+//  Author: Ritchie Brannan
+//  Date:   11 July 16
+//  
+//  Description:
+//  
+//      Block based (SIMD) bulk UTF kernels.
+//  
+//  Notes:
+//  
+//      The vector code is compiled with per-function target attributes (GCC and Clang) or relies on the intrinsics
+//      always being available (MSVC), so no special compiler options are needed; the CPU is queried once and the public
+//      functions call the kernels through the function table of the selected tier.
+//  
+//      UTF8 validation uses the Keiser-Lemire three-nibble lookup method: each byte is classified against the byte
+//      before it using three 16 entry tables, and a separate test ensures that the bytes following a 3 or 4 byte lead
+//      byte are continuation bytes. The Java style 2-byte NULL {0xc0, 0x80} is the only over-long form accepted and
+//      is simply removed from the error bits when use_java is set.
+
+#include "utf_simd.h"
+#include "utf_std.h"
+#include <string.h>
+#include <stdlib.h>
+#include <atomic>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define SUITE_UTF_SIMD_X86
+#define SUITE_UTF_SIMD_X64
+#elif defined(_M_IX86) || defined(__i386__)
+#define SUITE_UTF_SIMD_X86
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(SUITE_UTF_SIMD_X86)
+#include <immintrin.h>
+#if !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SUITE_UTF_TARGET_SSE42
+#define SUITE_UTF_TARGET_AVX2
+#define SUITE_UTF_TARGET_AVX512
+#else
+#define SUITE_UTF_TARGET_SSE42  __attribute__((target("sse4.2,popcnt")))
+#define SUITE_UTF_TARGET_AVX2   __attribute__((target("avx2,popcnt")))
+#define SUITE_UTF_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,popcnt")))
+#endif
+
+namespace unicode
+{
+
+namespace utf
+{
+
+namespace simd
+{
+
+namespace internal
+{
+
+// ==== CPU feature detection ====
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+static void cpuid(uint32_t (&regs)[4], const uint32_t leaf, const uint32_t subleaf) noexcept
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    regs[0] = static_cast<uint32_t>(info[0]);
+    regs[1] = static_cast<uint32_t>(info[1]);
+    regs[2] = static_cast<uint32_t>(info[2]);
+    regs[3] = static_cast<uint32_t>(info[3]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static uint64_t xgetbv() noexcept
+{
+#if defined(_MSC_VER)
+    return static_cast<uint64_t>(_xgetbv(0));
+#else
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((static_cast<uint64_t>(hi) << 32) | lo);
+#endif
+}
+
+#endif
+
+static uint32_t detectFeatures() noexcept
+{
+    uint32_t features = 0;
+#if defined(SUITE_UTF_SIMD_X86)
+    uint32_t regs[4];
+    cpuid(regs, 0, 0);
+    const uint32_t leaves = regs[0];
+    if (leaves >= 1)
+    {
+        cpuid(regs, 1, 0);
+        const uint32_t ecx = regs[2];
+        uint32_t ebx7 = 0;
+        uint32_t ecx7 = 0;
+        if (leaves >= 7)
+        {
+            cpuid(regs, 7, 0);
+            ebx7 = regs[1];
+            ecx7 = regs[2];
+        }
+        if ((ebx7 & 0x00000100u) != 0)
+        {   //  BMI2
+            features |= FEATURE_BMI2;
+        }
+        if ((ecx & 0x00980200u) == 0x00980200u)
+        {   //  SSSE3, SSE4.1, SSE4.2 and POPCNT
+            features |= FEATURE_SSE42;
+        }
+        if (((features & FEATURE_SSE42) != 0) && ((ecx & 0x18000000u) == 0x18000000u))
+        {   //  OSXSAVE and AVX
+            const uint64_t xcr0 = xgetbv();
+            if ((xcr0 & 0x06u) == 0x06u)
+            {   //  the OS preserves the XMM and YMM state
+                if ((ebx7 & 0x00000020u) != 0)
+                {   //  AVX2
+                    features |= FEATURE_AVX2;
+                }
+                if (((xcr0 & 0xe6u) == 0xe6u) && ((ebx7 & 0x40010000u) == 0x40010000u))
+                {   //  AVX-512 F and BW with the opmask and ZMM state preserved by the OS
+                    features |= FEATURE_AVX512;
+                    if ((ecx7 & 0x00000002u) != 0)
+                    {   //  AVX-512 VBMI
+                        features |= FEATURE_AVX512VBMI;
+                    }
+                }
+            }
+        }
+    }
+#endif
+    return features;
+}
+
+static uint32_t features() noexcept
+{
+    static const uint32_t detected = detectFeatures();
+    return detected;
+}
+
+// ==== bit scanning ====
+
+static inline uint32_t trailingZeros(const uint32_t bits) noexcept
+{   //  bits must be non-zero
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<uint32_t>(index);
+#else
+    return static_cast<uint32_t>(__builtin_ctz(bits));
+#endif
+}
+
+static inline uint32_t trailingZeros(const uint64_t bits) noexcept
+{   //  bits must be non-zero
+#if defined(_MSC_VER)
+    const uint32_t low = static_cast<uint32_t>(bits);
+    return (low != 0) ? trailingZeros(low) : (trailingZeros(static_cast<uint32_t>(bits >> 32)) + 32);
+#else
+    return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+static inline uint32_t populationCount(const uint64_t bits) noexcept
+{   //  only used by the SIMD kernels (FEATURE_SSE42 includes POPCNT)
+#if defined(_MSC_VER) && defined(SUITE_UTF_SIMD_X64)
+    return static_cast<uint32_t>(__popcnt64(bits));
+#elif defined(_MSC_VER)
+    return static_cast<uint32_t>(__popcnt(static_cast<uint32_t>(bits)) + __popcnt(static_cast<uint32_t>(bits >> 32)));
+#else
+    return static_cast<uint32_t>(__builtin_popcountll(bits));
+#endif
+}
+
+#endif
+
+// ==== scalar (SWAR) UTF8 validation ====
+
+static uint32_t resyncUTF8(const uint8_t* const buffer, const uint32_t index) noexcept
+{   //  steps back to the start of the sequence containing the byte before index (the sequence may straddle index)
+    uint32_t start = index;
+    if (start > 0)
+    {
+        const uint32_t limit = (start > 4) ? (start - 4) : 0;
+        --start;
+        while ((start > limit) && ((buffer[start] & 0xc0u) == 0x80u))
+        {
+            --start;
+        }
+    }
+    return start;
+}
+
+static uint32_t validSpanUTF8_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index, const bool use_java) noexcept
+{
+    while (index < size)
+    {
+        if ((size - index) >= 8)
+        {   //  skip 8 ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &buffer[index], 8);
+            if ((word & 0x8080808080808080ull) == 0)
+            {
+                index += 8;
+                continue;
+            }
+        }
+        if (buffer[index] <= 0x7fu)
+        {
+            ++index;
+            continue;
+        }
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        if (!std::getUTF8(&buffer[index], (size - index), unicode, bytes, use_java))
+        {
+            break;
+        }
+        index += bytes;
+    }
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== Keiser-Lemire UTF8 validation tables ====
+
+constexpr uint8_t TOO_SHORT      = 0x01u;   //  11______ 0_______ or 11______ 11______
+constexpr uint8_t TOO_LONG       = 0x02u;   //  0_______ 10______
+constexpr uint8_t OVERLONG_3     = 0x04u;   //  11100000 100_____
+constexpr uint8_t TOO_LARGE      = 0x08u;   //  11110100 1001____ or 11110100 101_____ or 11110101-11111111
+constexpr uint8_t SURROGATE      = 0x10u;   //  11101101 101_____
+constexpr uint8_t OVERLONG_2     = 0x20u;   //  1100000_ 10______
+constexpr uint8_t TOO_LARGE_1000 = 0x40u;   //  11110101-11111111 1000____
+constexpr uint8_t OVERLONG_4     = 0x40u;   //  11110000 1000____
+constexpr uint8_t TWO_CONTS      = 0x80u;   //  10______ 10______
+constexpr uint8_t CARRY          = (TOO_SHORT | TOO_LONG | TWO_CONTS);
+
+alignas(16) static const uint8_t byte1HighUTF8[16] =
+{
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,     //  0_______
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,                                         //  10______
+    (TOO_SHORT | OVERLONG_2),                                                           //  1100____
+    TOO_SHORT,                                                                          //  1101____
+    (TOO_SHORT | OVERLONG_3 | SURROGATE),                                               //  1110____
+    (TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4)                               //  1111____
+};
+
+alignas(16) static const uint8_t byte1LowUTF8[16] =
+{
+    (CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4),                                     //  ____0000
+    (CARRY | OVERLONG_2),                                                               //  ____0001
+    CARRY, CARRY,                                                                       //  ____001_
+    (CARRY | TOO_LARGE),                                                                //  ____0100
+    (CARRY | TOO_LARGE | TOO_LARGE_1000),                                               //  ____0101
+    (CARRY | TOO_LARGE | TOO_LARGE_1000), (CARRY | TOO_LARGE | TOO_LARGE_1000),         //  ____011_
+    (CARRY | TOO_LARGE | TOO_LARGE_1000), (CARRY | TOO_LARGE | TOO_LARGE_1000),         //  ____1000-____1001
+    (CARRY | TOO_LARGE | TOO_LARGE_1000), (CARRY | TOO_LARGE | TOO_LARGE_1000),         //  ____1010-____1011
+    (CARRY | TOO_LARGE | TOO_LARGE_1000),                                               //  ____1100
+    (CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE),                                   //  ____1101
+    (CARRY | TOO_LARGE | TOO_LARGE_1000), (CARRY | TOO_LARGE | TOO_LARGE_1000)          //  ____111_
+};
+
+alignas(16) static const uint8_t byte2HighUTF8[16] =
+{
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,                 //  0_______
+    (TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4),                         //  1000____
+    (TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE),                                           //  1001____
+    (TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),                                            //  1010____
+    (TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE),                                            //  1011____
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT                                                              //  11______
+};
+
+//  a non-zero result of a saturating subtract of this from the final 16 bytes of a block flags an incomplete sequence
+alignas(16) static const uint8_t incompleteUTF8[16] =
+{
+    0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xefu, 0xdfu, 0xbfu
+};
+
+alignas(16) static const uint8_t noneUTF8[16] =
+{
+    0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu
+};
+
+// ==== SSE4.2 UTF8 validation ====
+
+SUITE_UTF_TARGET_SSE42 static inline __m128i checkUTF8_sse(const __m128i input, const __m128i prior, const bool use_java) noexcept
+{
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i prev1 = _mm_alignr_epi8(input, prior, 15);
+    const __m128i byte1High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(byte1HighUTF8)), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    const __m128i byte1Low = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(byte1LowUTF8)), _mm_and_si128(prev1, nibble));
+    const __m128i byte2High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(byte2HighUTF8)), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+    if (use_java)
+    {   //  {0xc0, 0x80} is the Java style NULL
+        special = _mm_andnot_si128(_mm_and_si128(_mm_cmpeq_epi8(prev1, _mm_set1_epi8(static_cast<char>(0xc0u))), _mm_cmpeq_epi8(input, _mm_set1_epi8(static_cast<char>(0x80u)))), special);
+    }
+    const __m128i third = _mm_subs_epu8(_mm_alignr_epi8(input, prior, 14), _mm_set1_epi8(0x60));
+    const __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, prior, 13), _mm_set1_epi8(0x70));
+    const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80u)));
+    return _mm_xor_si128(must23, special);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t validSpanUTF8_sse(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+{
+    const __m128i limit = _mm_load_si128(reinterpret_cast<const __m128i*>(incompleteUTF8));
+    __m128i prior = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+        const __m128i input0 = _mm_loadu_si128(block + 0);
+        const __m128i input1 = _mm_loadu_si128(block + 1);
+        const __m128i input2 = _mm_loadu_si128(block + 2);
+        const __m128i input3 = _mm_loadu_si128(block + 3);
+        __m128i error = incomplete;
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(input0, input1), _mm_or_si128(input2, input3))) != 0)
+        {   //  not an ASCII block
+            error = _mm_or_si128(_mm_or_si128(checkUTF8_sse(input0, prior, use_java), checkUTF8_sse(input1, input0, use_java)),
+                                 _mm_or_si128(checkUTF8_sse(input2, input1, use_java), checkUTF8_sse(input3, input2, use_java)));
+        }
+        if (!_mm_testz_si128(error, error))
+        {
+            break;
+        }
+        incomplete = _mm_subs_epu8(input3, limit);
+        prior = input3;
+    }
+    return validSpanUTF8_swar(buffer, size, resyncUTF8(buffer, index), use_java);
+}
+
+// ==== AVX2 UTF8 validation ====
+
+SUITE_UTF_TARGET_AVX2 static inline __m256i checkUTF8_avx2(const __m256i input, const __m256i prior, const bool use_java) noexcept
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i shifted = _mm256_permute2x128_si256(prior, input, 0x21);
+    const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+    const __m256i byte1High = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(byte1HighUTF8))), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    const __m256i byte1Low = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(byte1LowUTF8))), _mm256_and_si256(prev1, nibble));
+    const __m256i byte2High = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(byte2HighUTF8))), _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+    if (use_java)
+    {   //  {0xc0, 0x80} is the Java style NULL
+        special = _mm256_andnot_si256(_mm256_and_si256(_mm256_cmpeq_epi8(prev1, _mm256_set1_epi8(static_cast<char>(0xc0u))), _mm256_cmpeq_epi8(input, _mm256_set1_epi8(static_cast<char>(0x80u)))), special);
+    }
+    const __m256i third = _mm256_subs_epu8(_mm256_alignr_epi8(input, shifted, 14), _mm256_set1_epi8(0x60));
+    const __m256i fourth = _mm256_subs_epu8(_mm256_alignr_epi8(input, shifted, 13), _mm256_set1_epi8(0x70));
+    const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80u)));
+    return _mm256_xor_si256(must23, special);
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t validSpanUTF8_avx2(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+{
+    const __m256i limit = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(noneUTF8))), _mm_load_si128(reinterpret_cast<const __m128i*>(incompleteUTF8)), 1);
+    __m256i prior = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+        const __m256i input0 = _mm256_loadu_si256(block + 0);
+        const __m256i input1 = _mm256_loadu_si256(block + 1);
+        __m256i error = incomplete;
+        if (_mm256_movemask_epi8(_mm256_or_si256(input0, input1)) != 0)
+        {   //  not an ASCII block
+            error = _mm256_or_si256(checkUTF8_avx2(input0, prior, use_java), checkUTF8_avx2(input1, input0, use_java));
+        }
+        if (!_mm256_testz_si256(error, error))
+        {
+            break;
+        }
+        incomplete = _mm256_subs_epu8(input1, limit);
+        prior = input1;
+    }
+    return validSpanUTF8_swar(buffer, size, resyncUTF8(buffer, index), use_java);
+}
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+// ==== AVX-512 UTF8 validation ====
+
+SUITE_UTF_TARGET_AVX512 static inline __m512i checkUTF8_avx512(const __m512i input, const __m512i prior, const bool use_java) noexcept
+{
+    const __m512i nibble = _mm512_set1_epi8(0x0f);
+    const __m512i shifted = _mm512_alignr_epi64(input, prior, 6);
+    const __m512i prev1 = _mm512_alignr_epi8(input, shifted, 15);
+    const __m512i byte1High = _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(byte1HighUTF8))), _mm512_and_si512(_mm512_srli_epi16(prev1, 4), nibble));
+    const __m512i byte1Low = _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(byte1LowUTF8))), _mm512_and_si512(prev1, nibble));
+    const __m512i byte2High = _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(byte2HighUTF8))), _mm512_and_si512(_mm512_srli_epi16(input, 4), nibble));
+    __m512i special = _mm512_and_si512(_mm512_and_si512(byte1High, byte1Low), byte2High);
+    if (use_java)
+    {   //  {0xc0, 0x80} is the Java style NULL
+        const __mmask64 javaNull = (_mm512_cmpeq_epi8_mask(prev1, _mm512_set1_epi8(static_cast<char>(0xc0u))) & _mm512_cmpeq_epi8_mask(input, _mm512_set1_epi8(static_cast<char>(0x80u))));
+        special = _mm512_maskz_mov_epi8(~javaNull, special);
+    }
+    const __m512i third = _mm512_subs_epu8(_mm512_alignr_epi8(input, shifted, 14), _mm512_set1_epi8(0x60));
+    const __m512i fourth = _mm512_subs_epu8(_mm512_alignr_epi8(input, shifted, 13), _mm512_set1_epi8(0x70));
+    const __m512i must23 = _mm512_and_si512(_mm512_or_si512(third, fourth), _mm512_set1_epi8(static_cast<char>(0x80u)));
+    return _mm512_xor_si512(must23, special);
+}
+
+SUITE_UTF_TARGET_AVX512 static uint32_t validSpanUTF8_avx512(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+{
+    const __m512i limit = _mm512_inserti32x4(_mm512_set1_epi8(static_cast<char>(0xffu)), _mm_load_si128(reinterpret_cast<const __m128i*>(incompleteUTF8)), 3);
+    __m512i prior = _mm512_setzero_si512();
+    __m512i incomplete = _mm512_setzero_si512();
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m512i input = _mm512_loadu_si512(&buffer[index]);
+        __m512i error = incomplete;
+        if (_mm512_movepi8_mask(input) != 0)
+        {   //  not an ASCII block
+            error = checkUTF8_avx512(input, prior, use_java);
+        }
+        if (_mm512_test_epi8_mask(error, error) != 0)
+        {
+            break;
+        }
+        incomplete = _mm512_subs_epu8(input, limit);
+        prior = input;
+    }
+    return validSpanUTF8_swar(buffer, size, resyncUTF8(buffer, index), use_java);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) UTF8 to UTF16 conversion ====
+
+static inline bool stepUTF8toUTF16(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool big_endian, const bool use_java) noexcept
+{   //  converts a single code-point using the quick functions
+    unicode_t unicode;
+    uint32_t bytes = 0;
+    uint32_t units = 0;
+    if (std::getUTF8(&src[index], (srcSize - index), unicode, bytes, use_java))
+    {
+        if (big_endian ? std::setUTF16be(&dst[output], (dstSize - output), unicode, units) : std::setUTF16le(&dst[output], (dstSize - output), unicode, units))
+        {
+            index += bytes;
+            output += units;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t convertUTF8toUTF16_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    const uint32_t high = big_endian ? 0 : 1;
+    while (index < srcSize)
+    {
+        if (((srcSize - index) >= 8) && ((dstSize - output) >= 16))
+        {   //  widen 8 ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            if ((word & 0x8080808080808080ull) == 0)
+            {
+                for (uint32_t count = 0; count < 8; ++count)
+                {
+                    dst[output + high] = 0;
+                    dst[output + (high ^ 1)] = src[index];
+                    ++index;
+                    output += 2;
+                }
+                continue;
+            }
+        }
+        if (!stepUTF8toUTF16(src, srcSize, dst, dstSize, index, output, big_endian, use_java))
+        {
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== UTF8 to UTF16 shuffle tables ====
+
+/// shuffle tables for converting validated UTF8 (indexed by a 12-bit mask of the bytes that end a code-point)
+struct utf8_shuffle_tables
+{
+    uint8_t     pattern[4096];      //  shuffle pattern for each mask (0xff if the next code-point must be converted alone)
+    uint8_t     consumed[4096];     //  source bytes consumed by the shuffle pattern for each mask
+    uint8_t     shuffle[145][16];   //  64 patterns for six 1 or 2 byte sequences then 81 patterns for four 1 to 3 byte sequences
+    utf8_shuffle_tables() noexcept;
+};
+
+utf8_shuffle_tables::utf8_shuffle_tables() noexcept
+{
+    for (uint32_t id = 0; id < 64; ++id)
+    {   //  six 1 or 2 byte sequences into 16-bit lanes {last byte, lead byte of a 2 byte sequence}
+        uint32_t start = 0;
+        for (uint32_t lane = 0; lane < 8; ++lane)
+        {
+            uint8_t* const entry = &shuffle[id][lane << 1];
+            entry[0] = entry[1] = 0x80u;
+            if (lane < 6)
+            {
+                const uint32_t length = (1 + ((id >> lane) & 1));
+                entry[0] = static_cast<uint8_t>(start + length - 1);
+                if (length == 2)
+                {
+                    entry[1] = static_cast<uint8_t>(start);
+                }
+                start += length;
+            }
+        }
+    }
+    for (uint32_t id = 0; id < 81; ++id)
+    {   //  four 1 to 3 byte sequences into 32-bit lanes {last byte, second last byte, lead byte of a 3 byte sequence, 0}
+        uint32_t start = 0;
+        uint32_t digits = id;
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            const uint32_t length = (1 + (digits % 3));
+            uint8_t* const entry = &shuffle[64 + id][lane << 2];
+            digits /= 3;
+            entry[0] = static_cast<uint8_t>(start + length - 1);
+            entry[1] = (length >= 2) ? static_cast<uint8_t>(start + length - 2) : 0x80u;
+            entry[2] = (length == 3) ? static_cast<uint8_t>(start) : 0x80u;
+            entry[3] = 0x80u;
+            start += length;
+        }
+    }
+    for (uint32_t mask = 0; mask < 4096; ++mask)
+    {
+        uint32_t lengths[12];
+        uint32_t count = 0;
+        uint32_t start = 0;
+        for (uint32_t bit = 0; bit < 12; ++bit)
+        {
+            if (((mask >> bit) & 1) != 0)
+            {
+                lengths[count++] = (bit + 1 - start);
+                start = (bit + 1);
+            }
+        }
+        pattern[mask] = 0xffu;
+        consumed[mask] = 0;
+        if ((count >= 6) && (lengths[0] <= 2) && (lengths[1] <= 2) && (lengths[2] <= 2) && (lengths[3] <= 2) && (lengths[4] <= 2) && (lengths[5] <= 2))
+        {
+            uint32_t id = 0;
+            uint32_t bytes = 0;
+            for (uint32_t index = 0; index < 6; ++index)
+            {
+                id |= ((lengths[index] - 1) << index);
+                bytes += lengths[index];
+            }
+            pattern[mask] = static_cast<uint8_t>(id);
+            consumed[mask] = static_cast<uint8_t>(bytes);
+        }
+        else if ((count >= 4) && (lengths[0] <= 3) && (lengths[1] <= 3) && (lengths[2] <= 3) && (lengths[3] <= 3))
+        {
+            uint32_t id = 0;
+            uint32_t bytes = 0;
+            for (uint32_t index = 4; index > 0; --index)
+            {
+                id = ((id * 3) + (lengths[index - 1] - 1));
+                bytes += lengths[index - 1];
+            }
+            pattern[mask] = static_cast<uint8_t>(64 + id);
+            consumed[mask] = static_cast<uint8_t>(bytes);
+        }
+    }
+}
+
+static const utf8_shuffle_tables& shuffleTablesUTF8() noexcept
+{
+    static const utf8_shuffle_tables tables;
+    return tables;
+}
+
+// ==== SSE4.2 UTF8 to UTF16 conversion ====
+
+SUITE_UTF_TARGET_SSE42 static inline __m128i swapUTF16_sse(const __m128i units, const bool big_endian) noexcept
+{
+    return big_endian ? _mm_or_si128(_mm_slli_epi16(units, 8), _mm_srli_epi16(units, 8)) : units;
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint32_t convertBlockUTF8toUTF16_sse(const uint8_t* const src, const uint64_t leads, uint8_t* const dst, uint32_t& output, const bool big_endian) noexcept
+{   //  converts the code-points starting in the first 49 bytes of a validated 64 byte block and returns the bytes consumed
+    const utf8_shuffle_tables& tables = shuffleTablesUTF8();
+    uint32_t index = 0;
+    while (index <= 48)
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index]));
+        if (_mm_movemask_epi8(input) == 0)
+        {   //  16 ASCII bytes
+            __m128i* const target = reinterpret_cast<__m128i*>(&dst[output]);
+            _mm_storeu_si128(target + 0, swapUTF16_sse(_mm_unpacklo_epi8(input, _mm_setzero_si128()), big_endian));
+            _mm_storeu_si128(target + 1, swapUTF16_sse(_mm_unpackhi_epi8(input, _mm_setzero_si128()), big_endian));
+            index += 16;
+            output += 32;
+            continue;
+        }
+        const uint32_t mask = (static_cast<uint32_t>(leads >> (index + 1)) & 0x00000fffu);
+        const uint32_t id = tables.pattern[mask];
+        if (id < 64)
+        {   //  six 1 or 2 byte sequences
+            const __m128i lanes = _mm_shuffle_epi8(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[id])));
+            const __m128i units = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi16(0x007f)), _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x1f00)), 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), swapUTF16_sse(units, big_endian));
+            index += tables.consumed[mask];
+            output += 12;
+        }
+        else if (id < 145)
+        {   //  four 1 to 3 byte sequences
+            const __m128i lanes = _mm_shuffle_epi8(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[id])));
+            const __m128i values = _mm_or_si128(_mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi32(0x0000007f)), _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x00003f00)), 2)),
+                                                _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x000f0000)), 4));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[output]), swapUTF16_sse(_mm_packus_epi32(values, values), big_endian));
+            index += tables.consumed[mask];
+            output += 8;
+        }
+        else
+        {   //  a single code-point (4 byte sequences and surrogate pairs)
+            const uint8_t lead = src[index];
+            uint32_t unicode = lead;
+            uint32_t length = 1;
+            if (lead >= 0xf0u)
+            {
+                unicode = ((lead & 0x07u) << 18) | ((src[index + 1] & 0x3fu) << 12) | ((src[index + 2] & 0x3fu) << 6) | (src[index + 3] & 0x3fu);
+                length = 4;
+            }
+            else if (lead >= 0xe0u)
+            {
+                unicode = ((lead & 0x0fu) << 12) | ((src[index + 1] & 0x3fu) << 6) | (src[index + 2] & 0x3fu);
+                length = 3;
+            }
+            else if (lead >= 0xc0u)
+            {
+                unicode = ((lead & 0x1fu) << 6) | (src[index + 1] & 0x3fu);
+                length = 2;
+            }
+            if (unicode >= 0x00010000u)
+            {   //  surrogate pair
+                const uint32_t surrogate = (unicode - 0x00010000u);
+                unicode = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
+            }
+            const uint32_t high = big_endian ? 0 : 1;
+            dst[output + high] = static_cast<uint8_t>(unicode >> 8);
+            dst[output + (high ^ 1)] = static_cast<uint8_t>(unicode);
+            output += 2;
+            if (length == 4)
+            {
+                dst[output + high] = static_cast<uint8_t>(unicode >> 24);
+                dst[output + (high ^ 1)] = static_cast<uint8_t>(unicode >> 16);
+                output += 2;
+            }
+            index += length;
+        }
+    }
+    return index;
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertUTF8toUTF16_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i cont = _mm_set1_epi8(-64);
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 128))
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&src[index]);
+        const __m128i input0 = _mm_loadu_si128(block + 0);
+        const __m128i input1 = _mm_loadu_si128(block + 1);
+        const __m128i input2 = _mm_loadu_si128(block + 2);
+        const __m128i input3 = _mm_loadu_si128(block + 3);
+        if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(input0, input1), _mm_or_si128(input2, input3))) == 0)
+        {   //  64 ASCII bytes
+            __m128i* const target = reinterpret_cast<__m128i*>(&dst[output]);
+            _mm_storeu_si128(target + 0, swapUTF16_sse(_mm_unpacklo_epi8(input0, zero), big_endian));
+            _mm_storeu_si128(target + 1, swapUTF16_sse(_mm_unpackhi_epi8(input0, zero), big_endian));
+            _mm_storeu_si128(target + 2, swapUTF16_sse(_mm_unpacklo_epi8(input1, zero), big_endian));
+            _mm_storeu_si128(target + 3, swapUTF16_sse(_mm_unpackhi_epi8(input1, zero), big_endian));
+            _mm_storeu_si128(target + 4, swapUTF16_sse(_mm_unpacklo_epi8(input2, zero), big_endian));
+            _mm_storeu_si128(target + 5, swapUTF16_sse(_mm_unpackhi_epi8(input2, zero), big_endian));
+            _mm_storeu_si128(target + 6, swapUTF16_sse(_mm_unpacklo_epi8(input3, zero), big_endian));
+            _mm_storeu_si128(target + 7, swapUTF16_sse(_mm_unpackhi_epi8(input3, zero), big_endian));
+            index += 64;
+            output += 128;
+            continue;
+        }
+        const __m128i error = _mm_or_si128(_mm_or_si128(checkUTF8_sse(input0, zero, use_java), checkUTF8_sse(input1, input0, use_java)),
+                                           _mm_or_si128(checkUTF8_sse(input2, input1, use_java), checkUTF8_sse(input3, input2, use_java)));
+        if (!_mm_testz_si128(error, error))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        const uint64_t conts = (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(cont, input0)))) |
+                               (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(cont, input1)))) << 16) |
+                               (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(cont, input2)))) << 32) |
+                               (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(cont, input3)))) << 48));
+        index += convertBlockUTF8toUTF16_sse(&src[index], ~conts, dst, output, big_endian);
+    }
+    written = output;
+    return convertUTF8toUTF16_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_java);
+}
+
+// ==== AVX2 UTF8 to UTF16 conversion ====
+
+SUITE_UTF_TARGET_AVX2 static inline __m256i swapUTF16_avx2(const __m256i units, const bool big_endian) noexcept
+{
+    return big_endian ? _mm256_or_si256(_mm256_slli_epi16(units, 8), _mm256_srli_epi16(units, 8)) : units;
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertUTF8toUTF16_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i cont = _mm256_set1_epi8(-64);
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 128))
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&src[index]);
+        const __m256i input0 = _mm256_loadu_si256(block + 0);
+        const __m256i input1 = _mm256_loadu_si256(block + 1);
+        if (_mm256_movemask_epi8(_mm256_or_si256(input0, input1)) == 0)
+        {   //  64 ASCII bytes
+            __m256i* const target = reinterpret_cast<__m256i*>(&dst[output]);
+            _mm256_storeu_si256(target + 0, swapUTF16_avx2(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(input0)), big_endian));
+            _mm256_storeu_si256(target + 1, swapUTF16_avx2(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(input0, 1)), big_endian));
+            _mm256_storeu_si256(target + 2, swapUTF16_avx2(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(input1)), big_endian));
+            _mm256_storeu_si256(target + 3, swapUTF16_avx2(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(input1, 1)), big_endian));
+            index += 64;
+            output += 128;
+            continue;
+        }
+        const __m256i error = _mm256_or_si256(checkUTF8_avx2(input0, zero, use_java), checkUTF8_avx2(input1, input0, use_java));
+        if (!_mm256_testz_si256(error, error))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        const uint64_t conts = (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(cont, input0)))) |
+                               (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(cont, input1)))) << 32));
+        index += convertBlockUTF8toUTF16_sse(&src[index], ~conts, dst, output, big_endian);
+    }
+    written = output;
+    return convertUTF8toUTF16_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_java);
+}
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+// ==== AVX-512 UTF8 to UTF16 conversion ====
+
+SUITE_UTF_TARGET_AVX512 static inline __m512i swapUTF16_avx512(const __m512i units, const bool big_endian) noexcept
+{
+    return big_endian ? _mm512_or_si512(_mm512_slli_epi16(units, 8), _mm512_srli_epi16(units, 8)) : units;
+}
+
+SUITE_UTF_TARGET_AVX512 static uint32_t convertUTF8toUTF16_avx512(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    const __m512i cont = _mm512_set1_epi8(-64);
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 128))
+    {
+        const __m512i input = _mm512_loadu_si512(&src[index]);
+        if (_mm512_movepi8_mask(input) == 0)
+        {   //  64 ASCII bytes
+            _mm512_storeu_si512(&dst[output], swapUTF16_avx512(_mm512_cvtepu8_epi16(_mm512_castsi512_si256(input)), big_endian));
+            _mm512_storeu_si512(&dst[output + 64], swapUTF16_avx512(_mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(input, 1)), big_endian));
+            index += 64;
+            output += 128;
+            continue;
+        }
+        const __m512i error = checkUTF8_avx512(input, _mm512_setzero_si512(), use_java);
+        if (_mm512_test_epi8_mask(error, error) != 0)
+        {   //  the scalar code finds the failure
+            break;
+        }
+        const uint64_t conts = static_cast<uint64_t>(_mm512_cmpgt_epi8_mask(cont, input));
+        index += convertBlockUTF8toUTF16_sse(&src[index], ~conts, dst, output, big_endian);
+    }
+    written = output;
+    return convertUTF8toUTF16_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_java);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) UTF16 to UTF8 conversion ====
+
+static inline bool stepUTF16toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool big_endian, const bool use_java) noexcept
+{   //  converts a single code-point using the quick functions
+    unicode_t unicode;
+    uint32_t units = 0;
+    uint32_t bytes = 0;
+    if (big_endian ? std::getUTF16be(&src[index], (srcSize - index), unicode, units) : std::getUTF16le(&src[index], (srcSize - index), unicode, units))
+    {
+        if (std::setUTF8(&dst[output], (dstSize - output), unicode, bytes, use_java))
+        {
+            index += units;
+            output += bytes;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t convertUTF16toUTF8_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    static const uint8_t asciiLE[8] = { 0x80u, 0xffu, 0x80u, 0xffu, 0x80u, 0xffu, 0x80u, 0xffu };
+    static const uint8_t asciiBE[8] = { 0xffu, 0x80u, 0xffu, 0x80u, 0xffu, 0x80u, 0xffu, 0x80u };
+    uint64_t ascii;
+    ::memcpy(&ascii, big_endian ? asciiBE : asciiLE, 8);
+    uint32_t output = written;
+    const uint32_t low = big_endian ? 1 : 0;
+    while (index < srcSize)
+    {
+        if (((srcSize - index) >= 8) && ((dstSize - output) >= 4))
+        {   //  narrow 4 ASCII code-units at a time (Java UTF8 encodes NULL as 2 bytes)
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            if (((word & ascii) == 0) && (!use_java || (((word | ((word & 0x7fff7fff7fff7fffull) + 0x7fff7fff7fff7fffull)) & 0x8000800080008000ull) == 0x8000800080008000ull)))
+            {
+                for (uint32_t count = 0; count < 4; ++count)
+                {
+                    dst[output] = src[index + low];
+                    index += 2;
+                    ++output;
+                }
+                continue;
+            }
+        }
+        if (!stepUTF16toUTF8(src, srcSize, dst, dstSize, index, output, big_endian, use_java))
+        {
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== UTF16 to UTF8 shuffle tables ====
+
+/// shuffle tables for compacting groups of four UTF8 encoded code-units held in 32-bit lanes
+///
+///     The tables are indexed by the sum of the lane codes (0 to 4) weighted by 1, 8, 64 and 512 where the lane code is
+///     the UTF8 length of the code-unit, 4 for a high surrogate and 0 for a low surrogate. A high surrogate in the last
+///     lane is left for the next group and keys with unpaired surrogates map to 0xff.
+///
+struct utf16_shuffle_tables
+{
+    uint8_t     pattern[4096];      //  shuffle pattern for each key (0xff if the group is not valid)
+    uint8_t     length[142];        //  UTF8 bytes produced by each shuffle pattern
+    uint8_t     units[142];         //  UTF16 code-units consumed by each shuffle pattern (3 or 4)
+    uint8_t     shuffle[142][16];   //  compaction shuffle patterns
+    utf16_shuffle_tables() noexcept;
+};
+
+utf16_shuffle_tables::utf16_shuffle_tables() noexcept
+{
+    uint32_t id = 0;
+    ::memset(pattern, 0xff, sizeof(pattern));
+    for (uint32_t combination = 0; combination < 625; ++combination)
+    {
+        uint32_t codes[4];
+        uint32_t digits = combination;
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            codes[lane] = (digits % 5);
+            digits /= 5;
+        }
+        bool valid = true;
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            if ((codes[lane] == 4) && (lane < 3) && (codes[lane + 1] != 0))
+            {   //  unpaired high surrogate
+                valid = false;
+            }
+            else if ((codes[lane] == 0) && ((lane == 0) || (codes[lane - 1] != 4)))
+            {   //  unpaired low surrogate
+                valid = false;
+            }
+        }
+        if (valid)
+        {
+            uint32_t bytes = 0;
+            ::memset(shuffle[id], 0x80, 16);
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                const uint32_t count = ((lane == 3) && (codes[lane] == 4)) ? 0 : codes[lane];
+                for (uint32_t offset = 0; offset < count; ++offset)
+                {
+                    shuffle[id][bytes++] = static_cast<uint8_t>((lane << 2) + offset);
+                }
+            }
+            length[id] = static_cast<uint8_t>(bytes);
+            units[id] = (codes[3] == 4) ? 3 : 4;
+            pattern[codes[0] + (codes[1] << 3) + (codes[2] << 6) + (codes[3] << 9)] = static_cast<uint8_t>(id);
+            ++id;
+        }
+    }
+}
+
+static const utf16_shuffle_tables& shuffleTablesUTF16() noexcept
+{
+    static const utf16_shuffle_tables tables;
+    return tables;
+}
+
+// ==== SSE4.2 UTF16 to UTF8 conversion ====
+
+SUITE_UTF_TARGET_SSE42 static inline __m128i encodeGroupUTF8_sse(const __m128i units, const __m128i under80, const __m128i under800) noexcept
+{   //  encodes four BMP code-units (zero extended in 32-bit lanes) as UTF8 sequences of 1 to 3 bytes
+    const __m128i byte1 = units;
+    const __m128i byte2 = _mm_or_si128(_mm_set1_epi32(0x000080c0), _mm_or_si128(_mm_srli_epi32(units, 6), _mm_slli_epi32(_mm_and_si128(units, _mm_set1_epi32(0x0000003f)), 8)));
+    const __m128i byte3 = _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0x008080e0), _mm_srli_epi32(units, 12)),
+                                       _mm_or_si128(_mm_slli_epi32(_mm_and_si128(units, _mm_set1_epi32(0x00000fc0)), 2), _mm_slli_epi32(_mm_and_si128(units, _mm_set1_epi32(0x0000003f)), 16)));
+    return _mm_blendv_epi8(_mm_blendv_epi8(byte3, byte2, under800), byte1, under80);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline __m128i encodePairUTF8_sse(const __m128i high, const __m128i low) noexcept
+{   //  encodes surrogate pairs (zero extended in 32-bit lanes) as 4 byte UTF8 sequences
+    const __m128i unicode = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(high, _mm_set1_epi32(0x000003ff)), 10), _mm_and_si128(low, _mm_set1_epi32(0x000003ff))), _mm_set1_epi32(0x00010000));
+    return _mm_or_si128(_mm_or_si128(_mm_set1_epi32(static_cast<int>(0x808080f0u)), _mm_srli_epi32(unicode, 18)),
+                        _mm_or_si128(_mm_or_si128(_mm_srli_epi32(_mm_and_si128(unicode, _mm_set1_epi32(0x0003f000)), 4), _mm_slli_epi32(_mm_and_si128(unicode, _mm_set1_epi32(0x00000fc0)), 10)),
+                                     _mm_slli_epi32(_mm_and_si128(unicode, _mm_set1_epi32(0x0000003f)), 24)));
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint32_t convertBlockUTF16toUTF8_sse(const __m128i units, uint8_t* const dst, uint32_t& output, const bool use_java) noexcept
+{   //  converts up to 8 code-units (at least 32 bytes of dst space required) and returns the units consumed (0 if the scalar code must take over)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i under80 = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xff80u))), zero);
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        under80 = _mm_andnot_si128(_mm_cmpeq_epi16(units, zero), under80);
+    }
+    if (_mm_movemask_epi8(under80) == 0xffff)
+    {   //  ASCII kernel
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[output]), _mm_packus_epi16(units, units));
+        output += 8;
+        return 8;
+    }
+    const utf16_shuffle_tables& tables = shuffleTablesUTF16();
+    const __m128i under800 = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xf800u))), zero);
+    const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xf800u))), _mm_set1_epi16(static_cast<short>(0xd800u)));
+    __m128i codes = _mm_add_epi16(_mm_set1_epi16(3), _mm_add_epi16(under80, under800));
+    __m128i group0 = encodeGroupUTF8_sse(_mm_cvtepu16_epi32(units), _mm_cvtepi16_epi32(under80), _mm_cvtepi16_epi32(under800));
+    __m128i group1 = encodeGroupUTF8_sse(_mm_cvtepu16_epi32(_mm_srli_si128(units, 8)), _mm_cvtepi16_epi32(_mm_srli_si128(under80, 8)), _mm_cvtepi16_epi32(_mm_srli_si128(under800, 8)));
+    if (!_mm_testz_si128(surrogates, surrogates))
+    {   //  surrogate kernel (high surrogates take the following low surrogate, low surrogates produce no bytes)
+        const __m128i high = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xfc00u))), _mm_set1_epi16(static_cast<short>(0xd800u)));
+        const __m128i low = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xfc00u))), _mm_set1_epi16(static_cast<short>(0xdc00u)));
+        const __m128i next = _mm_srli_si128(units, 2);
+        codes = _mm_add_epi16(_mm_sub_epi16(codes, high), _mm_add_epi16(low, _mm_add_epi16(low, low)));
+        group0 = _mm_blendv_epi8(group0, encodePairUTF8_sse(_mm_cvtepu16_epi32(units), _mm_cvtepu16_epi32(next)), _mm_cvtepi16_epi32(high));
+        group1 = _mm_blendv_epi8(group1, encodePairUTF8_sse(_mm_cvtepu16_epi32(_mm_srli_si128(units, 8)), _mm_cvtepu16_epi32(_mm_srli_si128(next, 8))), _mm_cvtepi16_epi32(_mm_srli_si128(high, 8)));
+    }
+    const __m128i sums = _mm_madd_epi16(codes, _mm_setr_epi16(1, 8, 64, 512, 1, 8, 64, 512));
+    const __m128i keys = _mm_hadd_epi32(sums, sums);
+    const uint32_t id0 = tables.pattern[static_cast<uint32_t>(_mm_cvtsi128_si32(keys))];
+    if (id0 == 0xff)
+    {
+        return 0;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), _mm_shuffle_epi8(group0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[id0]))));
+    output += tables.length[id0];
+    if (tables.units[id0] != 4)
+    {   //  the surrogate pair that straddles the groups is left for the next block
+        return tables.units[id0];
+    }
+    const uint32_t id1 = tables.pattern[static_cast<uint32_t>(_mm_extract_epi32(keys, 1))];
+    if (id1 == 0xff)
+    {
+        return 4;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), _mm_shuffle_epi8(group1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[id1]))));
+    output += tables.length[id1];
+    return (4 + tables.units[id1]);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertUTF16toUTF8_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 16) && ((dstSize - output) >= 32))
+    {
+        const __m128i units = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index])), big_endian);
+        const uint32_t count = convertBlockUTF16toUTF8_sse(units, dst, output, use_java);
+        if (count == 0)
+        {   //  the scalar code finds the failure
+            break;
+        }
+        index += (count << 1);
+    }
+    written = output;
+    return convertUTF16toUTF8_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_java);
+}
+
+// ==== AVX2 UTF16 to UTF8 conversion ====
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertUTF16toUTF8_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ascii = _mm256_set1_epi16(static_cast<short>(0xff80u));
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 32))
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&src[index]);
+        const __m256i units0 = swapUTF16_avx2(_mm256_loadu_si256(block + 0), big_endian);
+        const __m256i units1 = swapUTF16_avx2(_mm256_loadu_si256(block + 1), big_endian);
+        __m256i other = _mm256_or_si256(_mm256_and_si256(units0, ascii), _mm256_and_si256(units1, ascii));
+        if (use_java)
+        {   //  Java UTF8 encodes NULL as 2 bytes
+            other = _mm256_or_si256(other, _mm256_or_si256(_mm256_cmpeq_epi16(units0, zero), _mm256_cmpeq_epi16(units1, zero)));
+        }
+        if (_mm256_testz_si256(other, other))
+        {   //  32 ASCII code-units
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[output]), _mm256_permute4x64_epi64(_mm256_packus_epi16(units0, units1), 0xd8));
+            index += 64;
+            output += 32;
+            continue;
+        }
+        uint32_t offset = 0;
+        while ((offset <= 48) && ((dstSize - output) >= 32))
+        {
+            const __m128i units = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index + offset])), big_endian);
+            const uint32_t count = convertBlockUTF16toUTF8_sse(units, dst, output, use_java);
+            if (count == 0)
+            {   //  the scalar code finds the failure
+                written = output;
+                return convertUTF16toUTF8_swar(src, srcSize, dst, dstSize, (index + offset), written, big_endian, use_java);
+            }
+            offset += (count << 1);
+        }
+        index += offset;
+    }
+    written = output;
+    return convertUTF16toUTF8_sse(src, srcSize, dst, dstSize, index, written, big_endian, use_java);
+}
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+// ==== AVX-512 UTF16 to UTF8 conversion ====
+
+SUITE_UTF_TARGET_AVX512 static uint32_t convertUTF16toUTF8_avx512(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    const __m512i ascii = _mm512_set1_epi16(static_cast<short>(0xff80u));
+    uint32_t output = written;
+    while (((srcSize - index) >= 128) && ((dstSize - output) >= 64))
+    {
+        const __m512i units0 = swapUTF16_avx512(_mm512_loadu_si512(&src[index]), big_endian);
+        const __m512i units1 = swapUTF16_avx512(_mm512_loadu_si512(&src[index + 64]), big_endian);
+        uint64_t other = (static_cast<uint64_t>(_mm512_test_epi16_mask(units0, ascii)) | (static_cast<uint64_t>(_mm512_test_epi16_mask(units1, ascii)) << 32));
+        if (use_java)
+        {   //  Java UTF8 encodes NULL as 2 bytes
+            other |= (static_cast<uint64_t>(_mm512_testn_epi16_mask(units0, units0)) | (static_cast<uint64_t>(_mm512_testn_epi16_mask(units1, units1)) << 32));
+        }
+        if (other == 0)
+        {   //  64 ASCII code-units
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[output]), _mm512_cvtepi16_epi8(units0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[output + 32]), _mm512_cvtepi16_epi8(units1));
+            index += 128;
+            output += 64;
+            continue;
+        }
+        uint32_t offset = 0;
+        while ((offset <= 112) && ((dstSize - output) >= 32))
+        {
+            const __m128i units = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index + offset])), big_endian);
+            const uint32_t count = convertBlockUTF16toUTF8_sse(units, dst, output, use_java);
+            if (count == 0)
+            {   //  the scalar code finds the failure
+                written = output;
+                return convertUTF16toUTF8_swar(src, srcSize, dst, dstSize, (index + offset), written, big_endian, use_java);
+            }
+            offset += (count << 1);
+        }
+        index += offset;
+    }
+    written = output;
+    return convertUTF16toUTF8_avx2(src, srcSize, dst, dstSize, index, written, big_endian, use_java);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== CP1252 sequence tables ====
+
+struct cp1252_sequence
+{
+    uint8_t     length;     //  UTF8 length
+    uint8_t     bytes[3];   //  UTF8 bytes
+};
+
+struct cp1252_tables
+{
+    cp1252_sequence sequences[128];     //  UTF8 sequences of 0x80 to 0xff
+    uint8_t         reverse[128];       //  CP1252 byte of the code-points above 0xff indexed by hashCP1252()
+};
+
+static constexpr uint16_t kUnicodeCP1252[32] =
+{   //  0x80 to 0x9f (the undefined bytes 0x81, 0x8d, 0x8f, 0x90 and 0x9d map to the C1 control with the same value)
+    0x20acu, 0x0081u, 0x201au, 0x0192u, 0x201eu, 0x2026u, 0x2020u, 0x2021u,
+    0x02c6u, 0x2030u, 0x0160u, 0x2039u, 0x0152u, 0x008du, 0x017du, 0x008fu,
+    0x0090u, 0x2018u, 0x2019u, 0x201cu, 0x201du, 0x2022u, 0x2013u, 0x2014u,
+    0x02dcu, 0x2122u, 0x0161u, 0x203au, 0x0153u, 0x009du, 0x017eu, 0x0178u
+};
+
+static constexpr uint32_t unicodeCP1252(const uint32_t byte) noexcept
+{
+    return (((byte & 0xe0u) == 0x80u) ? static_cast<uint32_t>(kUnicodeCP1252[byte & 0x1fu]) : byte);
+}
+
+static constexpr bool isUndefinedCP1252(const uint32_t byte) noexcept
+{
+    return (((byte & 0xe0u) == 0x80u) && (unicodeCP1252(byte) == byte));
+}
+
+static constexpr uint32_t hashCP1252(const uint32_t unicode) noexcept
+{   //  collision free for the 27 code-points above 0xff
+    return ((unicode ^ (unicode >> 8)) & 0x7fu);
+}
+
+static constexpr cp1252_tables makeTablesCP1252() noexcept
+{
+    cp1252_tables tables = {};
+    for (uint32_t index = 0; index < 128; ++index)
+    {
+        const uint32_t unicode = unicodeCP1252(index + 0x80u);
+        cp1252_sequence& sequence = tables.sequences[index];
+        if (unicode < 0x0800u)
+        {
+            sequence.length = 2;
+            sequence.bytes[0] = static_cast<uint8_t>(0xc0u | (unicode >> 6));
+            sequence.bytes[1] = static_cast<uint8_t>(0x80u | (unicode & 0x3fu));
+        }
+        else
+        {
+            sequence.length = 3;
+            sequence.bytes[0] = static_cast<uint8_t>(0xe0u | (unicode >> 12));
+            sequence.bytes[1] = static_cast<uint8_t>(0x80u | ((unicode >> 6) & 0x3fu));
+            sequence.bytes[2] = static_cast<uint8_t>(0x80u | (unicode & 0x3fu));
+        }
+        if (unicode > 0x00ffu)
+        {
+            tables.reverse[hashCP1252(unicode)] = static_cast<uint8_t>(index + 0x80u);
+        }
+    }
+    return tables;
+}
+
+static constexpr cp1252_tables kTablesCP1252 = makeTablesCP1252();
+
+static constexpr bool checkTablesCP1252() noexcept
+{   //  every code-point above 0xff has its own reverse table entry
+    for (uint32_t index = 0; index < 32; ++index)
+    {
+        const uint32_t unicode = kUnicodeCP1252[index];
+        if ((unicode > 0x00ffu) && (kTablesCP1252.reverse[hashCP1252(unicode)] != (index + 0x80u)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(checkTablesCP1252(), "CP1252 reverse table collision");
+
+static inline bool isCopyCP1252(const uint8_t byte, const bool use_java) noexcept
+{   //  true if the byte is the same in CP1252 and UTF8 (ASCII, other than NULL for Java style UTF8)
+    return ((byte < 0x80u) && ((byte != 0) || !use_java));
+}
+
+static inline bool toCP1252(const uint32_t unicode, uint8_t& byte, const bool strict) noexcept
+{   //  the same as unicodeToCP1252() (CP1252Strictness::StrictUndefined if strict)
+    if (unicode <= 0x00ffu)
+    {
+        byte = static_cast<uint8_t>(unicode);
+        return (!isUndefinedCP1252(unicode) ? ((unicode < 0x80u) || (unicode >= 0xa0u)) : !strict);
+    }
+    byte = kTablesCP1252.reverse[hashCP1252(unicode)];
+    return ((byte != 0) && (unicodeCP1252(byte) == unicode));
+}
+
+// ==== scalar (SWAR) CP1252 to UTF8 conversion ====
+
+static inline bool stepCP1252toUTF8(const uint8_t* const src, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool strict, const bool use_java) noexcept
+{   //  converts a single byte using the sequence table
+    const uint8_t byte = src[index];
+    const uint32_t space = (dstSize - output);
+    if (byte < 0x80u)
+    {
+        if ((byte == 0) && use_java)
+        {
+            if (space < 2)
+            {
+                return false;
+            }
+            dst[output] = 0xc0u;
+            dst[output + 1] = 0x80u;
+            output += 2;
+        }
+        else
+        {
+            if (space < 1)
+            {
+                return false;
+            }
+            dst[output] = byte;
+            ++output;
+        }
+        ++index;
+        return true;
+    }
+    const cp1252_sequence& sequence = kTablesCP1252.sequences[byte - 0x80u];
+    if ((space < sequence.length) || (strict && isUndefinedCP1252(byte)))
+    {
+        return false;
+    }
+    for (uint32_t count = 0; count < sequence.length; ++count)
+    {
+        dst[output + count] = sequence.bytes[count];
+    }
+    output += sequence.length;
+    ++index;
+    return true;
+}
+
+static uint32_t convertCP1252toUTF8_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (index < srcSize)
+    {
+        if (((srcSize - index) >= 8) && ((dstSize - output) >= 8))
+        {   //  copy 8 ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            const uint64_t zeros = (use_java ? ((word - 0x0101010101010101ull) & ~word) : 0);
+            if (((word | zeros) & 0x8080808080808080ull) == 0)
+            {
+                ::memcpy(&dst[output], &word, 8);
+                index += 8;
+                output += 8;
+                continue;
+            }
+        }
+        if (!stepCP1252toUTF8(src, dst, dstSize, index, output, strict, use_java))
+        {
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+// ==== scalar (SWAR) UTF8 to CP1252 conversion ====
+
+static inline bool stepUTF8toCP1252(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool strict, const bool use_java) noexcept
+{   //  converts a single code-point, the 2 byte sequences of 0x80 to 0xff are decoded directly
+    if (output >= dstSize)
+    {
+        return false;
+    }
+    const uint8_t lead = src[index];
+    uint32_t unicode = lead;
+    uint32_t bytes = 1;
+    if (lead >= 0x80u)
+    {
+        if (((lead & 0xfeu) == 0xc2u) && ((srcSize - index) >= 2) && ((src[index + 1] & 0xc0u) == 0x80u))
+        {
+            unicode = (((lead & 0x1fu) << 6) | (src[index + 1] & 0x3fu));
+            bytes = 2;
+        }
+        else
+        {
+            unicode_t decoded;
+            if (!std::getUTF8(&src[index], (srcSize - index), decoded, bytes, use_java))
+            {
+                return false;
+            }
+            unicode = static_cast<uint32_t>(decoded);
+        }
+    }
+    uint8_t byte = 0;
+    if (!toCP1252(unicode, byte, strict))
+    {
+        return false;
+    }
+    dst[output] = byte;
+    ++output;
+    index += bytes;
+    return true;
+}
+
+static uint32_t convertUTF8toCP1252_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (index < srcSize)
+    {
+        if (((srcSize - index) >= 8) && ((dstSize - output) >= 8))
+        {   //  copy 8 ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            if ((word & 0x8080808080808080ull) == 0)
+            {
+                ::memcpy(&dst[output], &word, 8);
+                index += 8;
+                output += 8;
+                continue;
+            }
+        }
+        if (!stepUTF8toCP1252(src, srcSize, dst, dstSize, index, output, strict, use_java))
+        {
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== SSE4.2 CP1252 and UTF8 conversion ====
+// ==== note: the blocks are copied as they are and the bytes that are not ASCII are then converted one code-point at a time ====
+
+SUITE_UTF_TARGET_SSE42 static inline uint64_t copyBlock_sse(const uint8_t* const src, uint8_t* const dst, const bool use_java) noexcept
+{   //  copies 64 bytes and returns the mask of the bytes that are not ASCII (or NULL if use_java)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i* const block = reinterpret_cast<const __m128i*>(src);
+    __m128i* const target = reinterpret_cast<__m128i*>(dst);
+    uint64_t mask = 0;
+    for (uint32_t lane = 0; lane < 4; ++lane)
+    {
+        const __m128i input = _mm_loadu_si128(block + lane);
+        _mm_storeu_si128(target + lane, input);
+        const __m128i special = (use_java ? _mm_or_si128(input, _mm_cmpeq_epi8(input, zero)) : input);
+        mask |= (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(special))) << (lane << 4));
+    }
+    return mask;
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertCP1252toUTF8_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 64))
+    {
+        const uint64_t mask = copyBlock_sse(&src[index], &dst[output], use_java);
+        const uint32_t ascii = (mask ? trailingZeros(mask) : 64);
+        index += ascii;
+        output += ascii;
+        bool failed = false;
+        while ((index < srcSize) && !isCopyCP1252(src[index], use_java) && !failed)
+        {
+            failed = !stepCP1252toUTF8(src, dst, dstSize, index, output, strict, use_java);
+        }
+        if (failed)
+        {   //  the scalar code finds the failure
+            break;
+        }
+    }
+    written = output;
+    return convertCP1252toUTF8_swar(src, srcSize, dst, dstSize, index, written, strict, use_java);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertUTF8toCP1252_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 64))
+    {
+        const uint64_t mask = copyBlock_sse(&src[index], &dst[output], false);
+        const uint32_t ascii = (mask ? trailingZeros(mask) : 64);
+        index += ascii;
+        output += ascii;
+        bool failed = false;
+        while ((index < srcSize) && (src[index] >= 0x80u) && !failed)
+        {
+            failed = !stepUTF8toCP1252(src, srcSize, dst, dstSize, index, output, strict, use_java);
+        }
+        if (failed)
+        {   //  the scalar code finds the failure
+            break;
+        }
+    }
+    written = output;
+    return convertUTF8toCP1252_swar(src, srcSize, dst, dstSize, index, written, strict, use_java);
+}
+
+// ==== AVX2 CP1252 and UTF8 conversion ====
+
+SUITE_UTF_TARGET_AVX2 static inline uint64_t copyBlock_avx2(const uint8_t* const src, uint8_t* const dst, const bool use_java) noexcept
+{   //  copies 64 bytes and returns the mask of the bytes that are not ASCII (or NULL if use_java)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i* const block = reinterpret_cast<const __m256i*>(src);
+    __m256i* const target = reinterpret_cast<__m256i*>(dst);
+    const __m256i input0 = _mm256_loadu_si256(block + 0);
+    const __m256i input1 = _mm256_loadu_si256(block + 1);
+    _mm256_storeu_si256(target + 0, input0);
+    _mm256_storeu_si256(target + 1, input1);
+    const __m256i special0 = (use_java ? _mm256_or_si256(input0, _mm256_cmpeq_epi8(input0, zero)) : input0);
+    const __m256i special1 = (use_java ? _mm256_or_si256(input1, _mm256_cmpeq_epi8(input1, zero)) : input1);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(special0))) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(special1))) << 32));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertCP1252toUTF8_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 64))
+    {
+        const uint64_t mask = copyBlock_avx2(&src[index], &dst[output], use_java);
+        const uint32_t ascii = (mask ? trailingZeros(mask) : 64);
+        index += ascii;
+        output += ascii;
+        bool failed = false;
+        while ((index < srcSize) && !isCopyCP1252(src[index], use_java) && !failed)
+        {
+            failed = !stepCP1252toUTF8(src, dst, dstSize, index, output, strict, use_java);
+        }
+        if (failed)
+        {   //  the scalar code finds the failure
+            break;
+        }
+    }
+    written = output;
+    return convertCP1252toUTF8_swar(src, srcSize, dst, dstSize, index, written, strict, use_java);
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertUTF8toCP1252_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 64))
+    {
+        const uint64_t mask = copyBlock_avx2(&src[index], &dst[output], false);
+        const uint32_t ascii = (mask ? trailingZeros(mask) : 64);
+        index += ascii;
+        output += ascii;
+        bool failed = false;
+        while ((index < srcSize) && (src[index] >= 0x80u) && !failed)
+        {
+            failed = !stepUTF8toCP1252(src, srcSize, dst, dstSize, index, output, strict, use_java);
+        }
+        if (failed)
+        {   //  the scalar code finds the failure
+            break;
+        }
+    }
+    written = output;
+    return convertUTF8toCP1252_swar(src, srcSize, dst, dstSize, index, written, strict, use_java);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) ISO-8859-1 and ASCII conversion ====
+
+static inline bool stepBYTEtoUTF8(const uint8_t* const src, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool use_ascii, const bool use_java) noexcept
+{   //  converts a single byte as getBYTE() and setUTF8() do
+    const uint8_t byte = src[index];
+    const uint32_t space = (dstSize - output);
+    if (byte >= 0x80u)
+    {
+        if (use_ascii || (space < 2))
+        {
+            return false;
+        }
+        dst[output] = static_cast<uint8_t>(0xc0u | (byte >> 6));
+        dst[output + 1] = static_cast<uint8_t>(0x80u | (byte & 0x3fu));
+        output += 2;
+    }
+    else if ((byte == 0) && use_java)
+    {
+        if (space < 2)
+        {
+            return false;
+        }
+        dst[output] = 0xc0u;
+        dst[output + 1] = 0x80u;
+        output += 2;
+    }
+    else
+    {
+        if (space < 1)
+        {
+            return false;
+        }
+        dst[output] = byte;
+        ++output;
+    }
+    ++index;
+    return true;
+}
+
+static uint32_t convertBYTEtoUTF8_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (index < srcSize)
+    {
+        if (((srcSize - index) >= 8) && ((dstSize - output) >= 8))
+        {   //  copy 8 ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            const uint64_t zeros = (use_java ? ((word - 0x0101010101010101ull) & ~word) : 0);
+            if (((word | zeros) & 0x8080808080808080ull) == 0)
+            {
+                ::memcpy(&dst[output], &word, 8);
+                index += 8;
+                output += 8;
+                continue;
+            }
+        }
+        if (!stepBYTEtoUTF8(src, dst, dstSize, index, output, use_ascii, use_java))
+        {
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+static inline bool stepUTF8toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool use_ascii, const bool use_java) noexcept
+{   //  converts a single code-point as getUTF8() and setBYTE() do, the 2 byte sequences of 0x80 to 0xff are decoded directly
+    if (output >= dstSize)
+    {
+        return false;
+    }
+    const uint8_t lead = src[index];
+    uint32_t unicode = lead;
+    uint32_t bytes = 1;
+    if (lead >= 0x80u)
+    {
+        if (((lead & 0xfeu) == 0xc2u) && ((srcSize - index) >= 2) && ((src[index + 1] & 0xc0u) == 0x80u))
+        {
+            unicode = (((lead & 0x1fu) << 6) | (src[index + 1] & 0x3fu));
+            bytes = 2;
+        }
+        else
+        {
+            unicode_t decoded;
+            if (!std::getUTF8(&src[index], (srcSize - index), decoded, bytes, use_java))
+            {
+                return false;
+            }
+            unicode = static_cast<uint32_t>(decoded);
+        }
+    }
+    if (unicode > (use_ascii ? 0x007fu : 0x00ffu))
+    {
+        return false;
+    }
+    dst[output] = static_cast<uint8_t>(unicode);
+    ++output;
+    index += bytes;
+    return true;
+}
+
+static uint32_t convertUTF8toBYTE_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (index < srcSize)
+    {
+        if (((srcSize - index) >= 8) && ((dstSize - output) >= 8))
+        {   //  copy 8 ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            if ((word & 0x8080808080808080ull) == 0)
+            {
+                ::memcpy(&dst[output], &word, 8);
+                index += 8;
+                output += 8;
+                continue;
+            }
+        }
+        if (!stepUTF8toBYTE(src, srcSize, dst, dstSize, index, output, use_ascii, use_java))
+        {
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+static uint32_t convertBYTEtoUTF16_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    uint32_t output = written;
+    const uint32_t high = big_endian ? 0 : 1;
+    while ((index < srcSize) && ((dstSize - output) >= 2))
+    {
+        if (use_ascii && (src[index] >= 0x80u))
+        {
+            break;
+        }
+        dst[output + high] = 0;
+        dst[output + (high ^ 1)] = src[index];
+        ++index;
+        output += 2;
+    }
+    written = output;
+    return index;
+}
+
+static uint32_t convertUTF16toBYTE_swar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    uint32_t output = written;
+    const uint32_t high = big_endian ? 0 : 1;
+    const uint64_t limit = (big_endian ? (use_ascii ? 0x80ff80ff80ff80ffull : 0x00ff00ff00ff00ffull) : (use_ascii ? 0xff80ff80ff80ff80ull : 0xff00ff00ff00ff00ull));
+    const uint32_t units = (srcSize & ~1u);
+    while (index < units)
+    {
+        if (((units - index) >= 8) && ((dstSize - output) >= 4))
+        {   //  narrow 4 code-units at a time
+            uint64_t word;
+            ::memcpy(&word, &src[index], 8);
+            if ((word & limit) == 0)
+            {
+                for (uint32_t count = 0; count < 4; ++count)
+                {
+                    dst[output] = src[index + (high ^ 1)];
+                    index += 2;
+                    ++output;
+                }
+                continue;
+            }
+        }
+        if ((output >= dstSize) || (src[index + high] != 0) || (use_ascii && (src[index + (high ^ 1)] >= 0x80u)))
+        {
+            break;
+        }
+        dst[output] = src[index + (high ^ 1)];
+        index += 2;
+        ++output;
+    }
+    written = output;
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== ISO-8859-1 and UTF8 shuffle tables ====
+
+struct byte_shuffle_tables
+{
+    uint8_t     expand[256][16];    //  for each mask of bytes above 0x7f, packs 8 lanes {ASCII or lead byte, continuation byte} to UTF8
+    uint8_t     compress[256][16];  //  for each mask of UTF8 lead bytes, packs the other bytes of an 8 byte group
+    byte_shuffle_tables() noexcept;
+};
+
+byte_shuffle_tables::byte_shuffle_tables() noexcept
+{
+    for (uint32_t mask = 0; mask < 256; ++mask)
+    {
+        uint32_t expanded = 0;
+        uint32_t compressed = 0;
+        for (uint32_t lane = 0; lane < 8; ++lane)
+        {
+            expand[mask][expanded++] = static_cast<uint8_t>(lane << 1);
+            if ((mask >> lane) & 1)
+            {
+                expand[mask][expanded++] = static_cast<uint8_t>((lane << 1) + 1);
+            }
+            else
+            {
+                compress[mask][compressed++] = static_cast<uint8_t>(lane);
+            }
+        }
+        while (expanded < 16)
+        {
+            expand[mask][expanded++] = 0x80u;
+        }
+        while (compressed < 16)
+        {
+            compress[mask][compressed++] = 0x80u;
+        }
+    }
+}
+
+static const byte_shuffle_tables& shuffleTablesBYTE() noexcept
+{
+    static const byte_shuffle_tables tables;
+    return tables;
+}
+
+// ==== SSE4.2 ISO-8859-1 and ASCII conversion ====
+
+SUITE_UTF_TARGET_SSE42 static inline void expandBYTEtoUTF8_sse(const __m128i input, const uint32_t mask, uint8_t* const dst, uint32_t& output) noexcept
+{   //  converts 16 bytes to UTF8 (up to 32 bytes), mask is the mask of the bytes above 0x7f (each half is a 16 byte store, so
+    //  there must be 32 bytes of space at output whatever the number of bytes written)
+    const byte_shuffle_tables& tables = shuffleTablesBYTE();
+    const __m128i zero = _mm_setzero_si128();
+    for (uint32_t half = 0; half < 2; ++half)
+    {
+        const __m128i units = (half ? _mm_unpackhi_epi8(input, zero) : _mm_unpacklo_epi8(input, zero));
+        const __m128i pairs = _mm_or_si128(_mm_or_si128(_mm_srli_epi16(units, 6), _mm_set1_epi16(static_cast<int16_t>(0x80c0))), _mm_slli_epi16(_mm_and_si128(units, _mm_set1_epi16(0x003f)), 8));
+        const __m128i lanes = _mm_blendv_epi8(units, pairs, _mm_cmpgt_epi16(units, _mm_set1_epi16(0x007f)));
+        const uint32_t bits = ((mask >> (half << 3)) & 0xffu);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), _mm_shuffle_epi8(lanes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.expand[bits]))));
+        output += (8 + populationCount(bits));
+    }
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint32_t compressUTF8toBYTE_sse(const __m128i input, const uint32_t leads, uint8_t* const dst, uint32_t& output) noexcept
+{   //  converts 16 bytes of ASCII and {0xc2 or 0xc3, continuation} pairs (a lead byte in the last lane is left), returns the bytes consumed
+    //  (each half is an 8 byte store, so there must be 16 bytes of space at output whatever the number of bytes written)
+    const byte_shuffle_tables& tables = shuffleTablesBYTE();
+    const __m128i prior = _mm_slli_si128(input, 1);
+    const __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(prior, _mm_set1_epi8(0x03)), 6), _mm_and_si128(input, _mm_set1_epi8(0x3f)));
+    const __m128i values = _mm_blendv_epi8(input, pairs, _mm_cmpgt_epi8(_mm_set1_epi8(-64), input));
+    const uint32_t low = (leads & 0xffu);
+    const uint32_t high = ((leads >> 8) & 0xffu);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[output]), _mm_shuffle_epi8(values, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.compress[low]))));
+    output += (8 - populationCount(low));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&dst[output]), _mm_shuffle_epi8(_mm_srli_si128(values, 8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.compress[high]))));
+    output += (8 - populationCount(high));
+    return ((leads & 0x8000u) ? 15 : 16);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertBYTEtoUTF8_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t output = written;
+    while (((srcSize - index) >= 16) && ((dstSize - output) >= 32))
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index]));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(input));
+        if (use_ascii && (mask != 0))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        if (use_java && (_mm_movemask_epi8(_mm_cmpeq_epi8(input, zero)) != 0))
+        {   //  the scalar code converts a block with NULL (there is space for every byte to become 2 bytes)
+            for (const uint32_t end = (index + 16); index < end; )
+            {
+                static_cast<void>(stepBYTEtoUTF8(src, dst, dstSize, index, output, use_ascii, use_java));
+            }
+            continue;
+        }
+        if (mask == 0)
+        {   //  16 ASCII bytes
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), input);
+            output += 16;
+        }
+        else
+        {
+            expandBYTEtoUTF8_sse(input, mask, dst, output);
+        }
+        index += 16;
+    }
+    written = output;
+    return convertBYTEtoUTF8_swar(src, srcSize, dst, dstSize, index, written, use_ascii, use_java);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertUTF8toBYTE_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    const __m128i cont = _mm_set1_epi8(-64);
+    const __m128i pair = _mm_set1_epi8(static_cast<char>(0xc2u));
+    const __m128i even = _mm_set1_epi8(static_cast<char>(0xfeu));
+    uint32_t output = written;
+    while (((srcSize - index) >= 16) && ((dstSize - output) >= 16))
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index]));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(input));
+        if (mask == 0)
+        {   //  16 ASCII bytes
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), input);
+            index += 16;
+            output += 16;
+            continue;
+        }
+        const uint32_t leads = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(input, even), pair)));
+        const uint32_t conts = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(cont, input)));
+        if (!use_ascii && ((leads | conts) == mask) && (conts == ((leads << 1) & 0xffffu)))
+        {   //  only ASCII and 0x80 to 0xff
+            index += compressUTF8toBYTE_sse(input, leads, dst, output);
+            continue;
+        }
+        bool failed = false;
+        for (const uint32_t end = (index + 16); (index < end) && !failed; )
+        {   //  the scalar code converts a block with other sequences
+            failed = !stepUTF8toBYTE(src, srcSize, dst, dstSize, index, output, use_ascii, use_java);
+        }
+        if (failed)
+        {   //  the scalar code finds the failure
+            break;
+        }
+    }
+    written = output;
+    return convertUTF8toBYTE_swar(src, srcSize, dst, dstSize, index, written, use_ascii, use_java);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertBYTEtoUTF16_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t output = written;
+    while (((srcSize - index) >= 16) && ((dstSize - output) >= 32))
+    {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index]));
+        if (use_ascii && (_mm_movemask_epi8(input) != 0))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        __m128i* const target = reinterpret_cast<__m128i*>(&dst[output]);
+        _mm_storeu_si128(target + 0, swapUTF16_sse(_mm_unpacklo_epi8(input, zero), big_endian));
+        _mm_storeu_si128(target + 1, swapUTF16_sse(_mm_unpackhi_epi8(input, zero), big_endian));
+        index += 16;
+        output += 32;
+    }
+    written = output;
+    return convertBYTEtoUTF16_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_ascii);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t convertUTF16toBYTE_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    const __m128i limit = _mm_set1_epi16(static_cast<int16_t>(use_ascii ? 0xff80u : 0xff00u));
+    uint32_t output = written;
+    while (((srcSize - index) >= 32) && ((dstSize - output) >= 16))
+    {
+        const __m128i units0 = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index])), big_endian);
+        const __m128i units1 = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[index + 16])), big_endian);
+        if (!_mm_testz_si128(_mm_or_si128(units0, units1), limit))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[output]), _mm_packus_epi16(units0, units1));
+        index += 32;
+        output += 16;
+    }
+    written = output;
+    return convertUTF16toBYTE_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_ascii);
+}
+
+// ==== AVX2 ISO-8859-1 and ASCII conversion ====
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertBYTEtoUTF8_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    uint32_t output = written;
+    while (((srcSize - index) >= 32) && ((dstSize - output) >= 64))
+    {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[index]));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(input));
+        if ((use_ascii && (mask != 0)) || (use_java && (_mm256_movemask_epi8(_mm256_cmpeq_epi8(input, zero)) != 0)))
+        {   //  the SSE4.2 code converts a block with NULL or finds the failure
+            break;
+        }
+        if (mask == 0)
+        {   //  32 ASCII bytes
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[output]), input);
+            output += 32;
+        }
+        else
+        {
+            expandBYTEtoUTF8_sse(_mm256_castsi256_si128(input), (mask & 0xffffu), dst, output);
+            expandBYTEtoUTF8_sse(_mm256_extracti128_si256(input, 1), (mask >> 16), dst, output);
+        }
+        index += 32;
+    }
+    written = output;
+    return convertBYTEtoUTF8_sse(src, srcSize, dst, dstSize, index, written, use_ascii, use_java);
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertUTF8toBYTE_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 32) && ((dstSize - output) >= 32))
+    {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[index]));
+        if (_mm256_movemask_epi8(input) != 0)
+        {   //  the SSE4.2 code converts the blocks that are not ASCII
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[output]), input);
+        index += 32;
+        output += 32;
+    }
+    written = output;
+    return convertUTF8toBYTE_sse(src, srcSize, dst, dstSize, index, written, use_ascii, use_java);
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertBYTEtoUTF16_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    uint32_t output = written;
+    while (((srcSize - index) >= 32) && ((dstSize - output) >= 64))
+    {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[index]));
+        if (use_ascii && (_mm256_movemask_epi8(input) != 0))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        __m256i* const target = reinterpret_cast<__m256i*>(&dst[output]);
+        _mm256_storeu_si256(target + 0, swapUTF16_avx2(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(input)), big_endian));
+        _mm256_storeu_si256(target + 1, swapUTF16_avx2(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(input, 1)), big_endian));
+        index += 32;
+        output += 64;
+    }
+    written = output;
+    return convertBYTEtoUTF16_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_ascii);
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t convertUTF16toBYTE_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    const __m256i limit = _mm256_set1_epi16(static_cast<int16_t>(use_ascii ? 0xff80u : 0xff00u));
+    uint32_t output = written;
+    while (((srcSize - index) >= 64) && ((dstSize - output) >= 32))
+    {
+        const __m256i units0 = swapUTF16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[index])), big_endian);
+        const __m256i units1 = swapUTF16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[index + 32])), big_endian);
+        if (!_mm256_testz_si256(_mm256_or_si256(units0, units1), limit))
+        {   //  the scalar code finds the failure
+            break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&dst[output]), _mm256_permute4x64_epi64(_mm256_packus_epi16(units0, units1), 0xd8));
+        index += 64;
+        output += 32;
+    }
+    written = output;
+    return convertUTF16toBYTE_swar(src, srcSize, dst, dstSize, index, written, big_endian, use_ascii);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) CESU8 and Java style UTF8 conversion ====
+// ==== note: the spans found by the UTF8 validation kernels are copied as they are, only the sequences that CESU8 and Java style UTF8 ====
+// ==== encode differently (surrogate pairs, 4 byte sequences and NULL) are converted one code-point at a time ====
+
+using validSpanFunction = uint32_t (*)(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept;
+using findRewriteFunction = uint32_t (*)(const uint8_t* const buffer, const uint32_t size, const bool use_cesu, const bool use_java) noexcept;
+
+static constexpr uint32_t kWindowMUTF8 = 0x2000u;  //  the spans are validated a window at a time so they are copied from the cache
+
+static inline uint32_t windowMUTF8(const uint32_t srcSize, const uint32_t dstSize, const uint32_t index, const uint32_t output) noexcept
+{   //  the bytes that can be validated and copied without checking the space in dst
+    const uint32_t left = (srcSize - index);
+    const uint32_t space = (dstSize - output);
+    const uint32_t window = ((left < space) ? left : space);
+    return ((window < kWindowMUTF8) ? window : kWindowMUTF8);
+}
+
+static inline bool stepMUTF8toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool use_cesu, const bool use_java) noexcept
+{   //  converts a single code-point, a CESU8 surrogate pair is re-encoded as a 4 byte sequence and {0xc0, 0x80} as NULL (the sequence
+    //  is read before it is written so dst may be src)
+    const uint8_t* const sequence = &src[index];
+    const uint32_t left = (srcSize - index);
+    const uint32_t space = (dstSize - output);
+    uint8_t* const target = &dst[output];
+    if (use_cesu && (left >= 6) && (sequence[0] == 0xedu) && ((sequence[1] & 0xf0u) == 0xa0u) && ((sequence[2] & 0xc0u) == 0x80u) &&
+        (sequence[3] == 0xedu) && ((sequence[4] & 0xf0u) == 0xb0u) && ((sequence[5] & 0xc0u) == 0x80u))
+    {   //  a high surrogate followed by a low surrogate (3 byte forms only, longer forms are left to the diagnostic decoder)
+        if (space < 4)
+        {
+            return false;
+        }
+        const uint32_t high = (((sequence[1] & 0x0fu) << 6) | (sequence[2] & 0x3fu));
+        const uint32_t low = (((sequence[4] & 0x0fu) << 6) | (sequence[5] & 0x3fu));
+        const uint32_t unicode = (0x00010000u + (high << 10) + low);
+        target[0] = static_cast<uint8_t>(0xf0u | (unicode >> 18));
+        target[1] = static_cast<uint8_t>(0x80u | ((unicode >> 12) & 0x3fu));
+        target[2] = static_cast<uint8_t>(0x80u | ((unicode >> 6) & 0x3fu));
+        target[3] = static_cast<uint8_t>(0x80u | (unicode & 0x3fu));
+        index += 6;
+        output += 4;
+        return true;
+    }
+    if (use_java && (left >= 2) && (sequence[0] == 0xc0u) && (sequence[1] == 0x80u))
+    {
+        if (space < 1)
+        {
+            return false;
+        }
+        target[0] = 0;
+        index += 2;
+        ++output;
+        return true;
+    }
+    unicode_t unicode;
+    uint32_t bytes = 0;
+    if (!std::getUTF8(sequence, left, unicode, bytes, false) || (space < bytes))
+    {
+        return false;
+    }
+    ::memmove(target, sequence, bytes);
+    index += bytes;
+    output += bytes;
+    return true;
+}
+
+static inline bool stepUTF8toMUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& index, uint32_t& output, const bool use_cesu, const bool use_java) noexcept
+{   //  converts a single code-point, a 4 byte sequence is re-encoded as a CESU8 surrogate pair and NULL as {0xc0, 0x80}
+    const uint8_t* const sequence = &src[index];
+    const uint32_t space = (dstSize - output);
+    uint8_t* const target = &dst[output];
+    unicode_t unicode;
+    uint32_t bytes = 0;
+    if (!std::getUTF8(sequence, (srcSize - index), unicode, bytes, false))
+    {
+        return false;
+    }
+    if (use_java && (unicode == 0))
+    {
+        if (space < 2)
+        {
+            return false;
+        }
+        target[0] = 0xc0u;
+        target[1] = 0x80u;
+        output += 2;
+    }
+    else if (use_cesu && (bytes == 4))
+    {
+        if (space < 6)
+        {
+            return false;
+        }
+        const uint32_t value = (static_cast<uint32_t>(unicode) - 0x00010000u);
+        const uint32_t high = (0xd800u | (value >> 10));
+        const uint32_t low = (0xdc00u | (value & 0x03ffu));
+        target[0] = 0xedu;
+        target[1] = static_cast<uint8_t>(0x80u | ((high >> 6) & 0x3fu));
+        target[2] = static_cast<uint8_t>(0x80u | (high & 0x3fu));
+        target[3] = 0xedu;
+        target[4] = static_cast<uint8_t>(0x80u | ((low >> 6) & 0x3fu));
+        target[5] = static_cast<uint8_t>(0x80u | (low & 0x3fu));
+        output += 6;
+    }
+    else
+    {
+        if (space < bytes)
+        {
+            return false;
+        }
+        ::memcpy(target, sequence, bytes);
+        output += bytes;
+    }
+    index += bytes;
+    return true;
+}
+
+static uint32_t findRewriteUTF8_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index, const bool use_cesu, const bool use_java) noexcept
+{   //  returns the offset of the first 4 byte sequence lead (if use_cesu) or NULL (if use_java) in valid UTF8
+    if (!use_cesu && !use_java)
+    {
+        return size;
+    }
+    while (index < size)
+    {
+        if ((size - index) >= 8)
+        {   //  skip 8 bytes at a time while none of them are 0xf0 to 0xff or NULL
+            uint64_t word;
+            ::memcpy(&word, &buffer[index], 8);
+            const uint64_t leads = (use_cesu ? (word & (word << 1) & (word << 2) & (word << 3)) : 0);
+            const uint64_t zeros = (use_java ? ((word - 0x0101010101010101ull) & ~word) : 0);
+            if (((leads | zeros) & 0x8080808080808080ull) == 0)
+            {
+                index += 8;
+                continue;
+            }
+        }
+        const uint8_t byte = buffer[index];
+        if ((use_cesu && (byte >= 0xf0u)) || (use_java && (byte == 0)))
+        {
+            break;
+        }
+        ++index;
+    }
+    return index;
+}
+
+static uint32_t convertMUTF8toUTF8_spans(const validSpanFunction validSpan, const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{   //  the output is never longer than the input so the spans are moved down when dst is src
+    uint32_t output = written;
+    while (index < srcSize)
+    {
+        const uint32_t window = windowMUTF8(srcSize, dstSize, index, output);
+        const uint32_t span = validSpan(&src[index], window, false);
+        if (&dst[output] != &src[index])
+        {
+            ::memmove(&dst[output], &src[index], span);
+        }
+        index += span;
+        output += span;
+        if (((span < window) || (window == 0)) && !stepMUTF8toUTF8(src, srcSize, dst, dstSize, index, output, use_cesu, use_java))
+        {   //  a surrogate pair, a Java style NULL, a sequence cut by the window or the failure
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+static uint32_t convertUTF8toMUTF8_spans(const validSpanFunction validSpan, const findRewriteFunction findRewrite, const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    uint32_t output = written;
+    while (index < srcSize)
+    {
+        const uint32_t window = windowMUTF8(srcSize, dstSize, index, output);
+        const uint32_t span = validSpan(&src[index], window, false);
+        const uint32_t end = (index + span);
+        bool failed = false;
+        while ((index < end) && !failed)
+        {   //  the span is copied up to each code-point that is rewritten, the rewrites are longer so the space is checked again
+            const uint32_t space = (dstSize - output);
+            const uint32_t limit = (((end - index) < space) ? (end - index) : space);
+            uint32_t copy = findRewrite(&src[index], limit, use_cesu, use_java);
+            if ((copy == limit) && (limit < (end - index)))
+            {   //  only whole sequences are copied when dst is short
+                while ((copy > 0) && ((src[index + copy] & 0xc0u) == 0x80u))
+                {
+                    --copy;
+                }
+            }
+            ::memcpy(&dst[output], &src[index], copy);
+            index += copy;
+            output += copy;
+            failed = ((index < end) && !stepUTF8toMUTF8(src, srcSize, dst, dstSize, index, output, use_cesu, use_java));
+        }
+        if (failed || (((span < window) || (window == 0)) && !stepUTF8toMUTF8(src, srcSize, dst, dstSize, index, output, use_cesu, use_java)))
+        {   //  a sequence cut by the window or the failure
+            break;
+        }
+    }
+    written = output;
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== SSE4.2 CESU8 and Java style UTF8 conversion ====
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findRewriteUTF8_sse(const uint8_t* const buffer, const uint32_t size, const bool use_cesu, const bool use_java) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lead = _mm_set1_epi8(static_cast<char>(0xf0u));
+    uint32_t index = 0;
+    if (use_cesu || use_java)
+    {
+        for (; (size - index) >= 16; index += 16)
+        {
+            const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&buffer[index]));
+            const uint32_t leads = (use_cesu ? static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(input, lead), input))) : 0);
+            const uint32_t zeros = (use_java ? static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(input, zero))) : 0);
+            if ((leads | zeros) != 0)
+            {
+                return (index + trailingZeros(leads | zeros));
+            }
+        }
+    }
+    return findRewriteUTF8_swar(buffer, size, index, use_cesu, use_java);
+}
+
+static uint32_t convertMUTF8toUTF8_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertMUTF8toUTF8_spans(&validSpanUTF8_sse, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+static uint32_t convertUTF8toMUTF8_sse(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertUTF8toMUTF8_spans(&validSpanUTF8_sse, &findRewriteUTF8_sse, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+// ==== AVX2 CESU8 and Java style UTF8 conversion ====
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findRewriteUTF8_avx2(const uint8_t* const buffer, const uint32_t size, const bool use_cesu, const bool use_java) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lead = _mm256_set1_epi8(static_cast<char>(0xf0u));
+    uint32_t index = 0;
+    if (use_cesu || use_java)
+    {
+        for (; (size - index) >= 32; index += 32)
+        {
+            const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&buffer[index]));
+            const uint32_t leads = (use_cesu ? static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(input, lead), input))) : 0);
+            const uint32_t zeros = (use_java ? static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(input, zero))) : 0);
+            if ((leads | zeros) != 0)
+            {
+                return (index + trailingZeros(leads | zeros));
+            }
+        }
+    }
+    return findRewriteUTF8_swar(buffer, size, index, use_cesu, use_java);
+}
+
+static uint32_t convertMUTF8toUTF8_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertMUTF8toUTF8_spans(&validSpanUTF8_avx2, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+static uint32_t convertUTF8toMUTF8_avx2(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertUTF8toMUTF8_spans(&validSpanUTF8_avx2, &findRewriteUTF8_avx2, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+// ==== AVX-512 CESU8 and Java style UTF8 conversion ====
+// ==== note: only the validation uses AVX-512, the rewrite scan and the copies are bound by memory bandwidth ====
+
+static uint32_t convertMUTF8toUTF8_avx512(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertMUTF8toUTF8_spans(&validSpanUTF8_avx512, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+static uint32_t convertUTF8toMUTF8_avx512(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertUTF8toMUTF8_spans(&validSpanUTF8_avx512, &findRewriteUTF8_avx2, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) code-point counting ====
+
+static uint32_t countUTF8_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index, uint32_t count) noexcept
+{   //  counts the bytes that are not continuation bytes (0x80 to 0xbf)
+    for (; (size - index) >= 8; index += 8)
+    {
+        uint64_t word;
+        ::memcpy(&word, &buffer[index], 8);
+        const uint64_t conts = (((word & ~(word << 1)) & 0x8080808080808080ull) >> 7);
+        count += (8 - static_cast<uint32_t>((conts * 0x0101010101010101ull) >> 56));
+    }
+    for (; index < size; ++index)
+    {
+        if ((buffer[index] & 0xc0u) != 0x80u)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static uint32_t pairsUTF16_swar(const uint8_t* const buffer, const uint32_t units, uint32_t unit, uint32_t pairs, const bool big_endian) noexcept
+{   //  counts the high surrogates that are immediately followed by a low surrogate
+    const uint32_t high = big_endian ? 0 : 1;
+    for (; (unit + 1) < units; ++unit)
+    {
+        if (((buffer[(unit << 1) + high] & 0xfcu) == 0xd8u) && ((buffer[(unit << 1) + 2 + high] & 0xfcu) == 0xdcu))
+        {
+            ++pairs;
+        }
+    }
+    return pairs;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== SSE4.2 code-point counting ====
+
+SUITE_UTF_TARGET_SSE42 static uint32_t countUTF8_sse(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i cont = _mm_set1_epi8(-64);
+    __m128i totals = zero;
+    uint32_t index = 0;
+    while ((size - index) >= 64)
+    {   //  byte counters are flushed before they can overflow (4 per iteration)
+        __m128i counts = zero;
+        for (uint32_t limit = 63; limit && ((size - index) >= 64); --limit)
+        {
+            const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+            counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(cont, _mm_loadu_si128(block + 0)));
+            counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(cont, _mm_loadu_si128(block + 1)));
+            counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(cont, _mm_loadu_si128(block + 2)));
+            counts = _mm_sub_epi8(counts, _mm_cmpgt_epi8(cont, _mm_loadu_si128(block + 3)));
+            index += 64;
+        }
+        totals = _mm_add_epi64(totals, _mm_sad_epu8(counts, zero));
+    }
+    const uint32_t conts = static_cast<uint32_t>(_mm_cvtsi128_si32(totals) + _mm_cvtsi128_si32(_mm_srli_si128(totals, 8)));
+    return countUTF8_swar(buffer, size, index, (index - conts));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t countUTF16_sse(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const uint32_t units = (size >> 1);
+    const __m128i mask = _mm_set1_epi16(big_endian ? 0x00fc : static_cast<short>(0xfc00u));
+    const __m128i high = _mm_set1_epi16(big_endian ? 0x00d8 : static_cast<short>(0xd800u));
+    const __m128i low = _mm_set1_epi16(big_endian ? 0x00dc : static_cast<short>(0xdc00u));
+    __m128i totals = _mm_setzero_si128();
+    uint32_t unit = 0;
+    while ((units - unit) > 16)
+    {   //  16-bit counters are flushed before they can overflow (2 per iteration)
+        __m128i counts = _mm_setzero_si128();
+        for (uint32_t limit = 0x3fff; limit && ((units - unit) > 16); --limit)
+        {
+            const uint8_t* const block = &buffer[unit << 1];
+            const __m128i units0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 0));
+            const __m128i next0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 2));
+            const __m128i units1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+            const __m128i next1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 18));
+            counts = _mm_sub_epi16(counts, _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(units0, mask), high), _mm_cmpeq_epi16(_mm_and_si128(next0, mask), low)));
+            counts = _mm_sub_epi16(counts, _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(units1, mask), high), _mm_cmpeq_epi16(_mm_and_si128(next1, mask), low)));
+            unit += 16;
+        }
+        totals = _mm_add_epi32(totals, _mm_madd_epi16(counts, _mm_set1_epi16(1)));
+    }
+    totals = _mm_add_epi32(totals, _mm_srli_si128(totals, 8));
+    totals = _mm_add_epi32(totals, _mm_srli_si128(totals, 4));
+    return (units - pairsUTF16_swar(buffer, units, unit, static_cast<uint32_t>(_mm_cvtsi128_si32(totals)), big_endian));
+}
+
+// ==== AVX2 code-point counting ====
+
+SUITE_UTF_TARGET_AVX2 static uint32_t countUTF8_avx2(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i cont = _mm256_set1_epi8(-64);
+    __m256i totals = zero;
+    uint32_t index = 0;
+    while ((size - index) >= 128)
+    {   //  byte counters are flushed before they can overflow (4 per iteration)
+        __m256i counts = zero;
+        for (uint32_t limit = 63; limit && ((size - index) >= 128); --limit)
+        {
+            const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+            counts = _mm256_sub_epi8(counts, _mm256_cmpgt_epi8(cont, _mm256_loadu_si256(block + 0)));
+            counts = _mm256_sub_epi8(counts, _mm256_cmpgt_epi8(cont, _mm256_loadu_si256(block + 1)));
+            counts = _mm256_sub_epi8(counts, _mm256_cmpgt_epi8(cont, _mm256_loadu_si256(block + 2)));
+            counts = _mm256_sub_epi8(counts, _mm256_cmpgt_epi8(cont, _mm256_loadu_si256(block + 3)));
+            index += 128;
+        }
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counts, zero));
+    }
+    const __m128i sums = _mm_add_epi64(_mm256_castsi256_si128(totals), _mm256_extracti128_si256(totals, 1));
+    const uint32_t conts = static_cast<uint32_t>(_mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    return countUTF8_swar(buffer, size, index, (index - conts));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t countUTF16_avx2(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const uint32_t units = (size >> 1);
+    const __m256i mask = _mm256_set1_epi16(big_endian ? 0x00fc : static_cast<short>(0xfc00u));
+    const __m256i high = _mm256_set1_epi16(big_endian ? 0x00d8 : static_cast<short>(0xd800u));
+    const __m256i low = _mm256_set1_epi16(big_endian ? 0x00dc : static_cast<short>(0xdc00u));
+    __m256i totals = _mm256_setzero_si256();
+    uint32_t unit = 0;
+    while ((units - unit) > 32)
+    {   //  16-bit counters are flushed before they can overflow (2 per iteration)
+        __m256i counts = _mm256_setzero_si256();
+        for (uint32_t limit = 0x3fff; limit && ((units - unit) > 32); --limit)
+        {
+            const uint8_t* const block = &buffer[unit << 1];
+            const __m256i units0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 0));
+            const __m256i next0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 2));
+            const __m256i units1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+            const __m256i next1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 34));
+            counts = _mm256_sub_epi16(counts, _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_and_si256(units0, mask), high), _mm256_cmpeq_epi16(_mm256_and_si256(next0, mask), low)));
+            counts = _mm256_sub_epi16(counts, _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_and_si256(units1, mask), high), _mm256_cmpeq_epi16(_mm256_and_si256(next1, mask), low)));
+            unit += 32;
+        }
+        totals = _mm256_add_epi32(totals, _mm256_madd_epi16(counts, _mm256_set1_epi16(1)));
+    }
+    __m128i sums = _mm_add_epi32(_mm256_castsi256_si128(totals), _mm256_extracti128_si256(totals, 1));
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 8));
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 4));
+    return (units - pairsUTF16_swar(buffer, units, unit, static_cast<uint32_t>(_mm_cvtsi128_si32(sums)), big_endian));
+}
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+// ==== AVX-512 code-point counting ====
+
+SUITE_UTF_TARGET_AVX512 static uint32_t countUTF8_avx512(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i cont = _mm512_set1_epi8(-64);
+    __m512i totals = zero;
+    uint32_t index = 0;
+    while ((size - index) >= 128)
+    {   //  byte counters are flushed before they can overflow (2 per iteration)
+        __m512i counts = zero;
+        for (uint32_t limit = 127; limit && ((size - index) >= 128); --limit)
+        {
+            counts = _mm512_sub_epi8(counts, _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(cont, _mm512_loadu_si512(&buffer[index]))));
+            counts = _mm512_sub_epi8(counts, _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(cont, _mm512_loadu_si512(&buffer[index + 64]))));
+            index += 128;
+        }
+        totals = _mm512_add_epi64(totals, _mm512_sad_epu8(counts, zero));
+    }
+    const uint32_t conts = static_cast<uint32_t>(_mm512_reduce_add_epi64(totals));
+    return countUTF8_swar(buffer, size, index, (index - conts));
+}
+
+SUITE_UTF_TARGET_AVX512 static uint32_t countUTF16_avx512(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const uint32_t units = (size >> 1);
+    const __m512i mask = _mm512_set1_epi16(big_endian ? 0x00fc : static_cast<short>(0xfc00u));
+    const __m512i high = _mm512_set1_epi16(big_endian ? 0x00d8 : static_cast<short>(0xd800u));
+    const __m512i low = _mm512_set1_epi16(big_endian ? 0x00dc : static_cast<short>(0xdc00u));
+    __m512i totals = _mm512_setzero_si512();
+    uint32_t unit = 0;
+    while ((units - unit) > 64)
+    {   //  16-bit counters are flushed before they can overflow (2 per iteration)
+        __m512i counts = _mm512_setzero_si512();
+        for (uint32_t limit = 0x3fff; limit && ((units - unit) > 64); --limit)
+        {
+            const uint8_t* const block = &buffer[unit << 1];
+            const __mmask32 pairs0 = (_mm512_cmpeq_epi16_mask(_mm512_and_si512(_mm512_loadu_si512(block + 0), mask), high) & _mm512_cmpeq_epi16_mask(_mm512_and_si512(_mm512_loadu_si512(block + 2), mask), low));
+            const __mmask32 pairs1 = (_mm512_cmpeq_epi16_mask(_mm512_and_si512(_mm512_loadu_si512(block + 64), mask), high) & _mm512_cmpeq_epi16_mask(_mm512_and_si512(_mm512_loadu_si512(block + 66), mask), low));
+            counts = _mm512_sub_epi16(counts, _mm512_movm_epi16(pairs0));
+            counts = _mm512_sub_epi16(counts, _mm512_movm_epi16(pairs1));
+            unit += 64;
+        }
+        totals = _mm512_add_epi32(totals, _mm512_madd_epi16(counts, _mm512_set1_epi16(1)));
+    }
+    return (units - pairsUTF16_swar(buffer, units, unit, static_cast<uint32_t>(_mm512_reduce_add_epi32(totals)), big_endian));
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) conversion size calculation ====
+
+static uint32_t sizeUTF16fromUTF8_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index, uint32_t units) noexcept
+{   //  counts 1 UTF16 code-unit for each byte that is not a continuation byte and 1 more for each 4 byte lead byte
+    for (; (size - index) >= 8; index += 8)
+    {
+        uint64_t word;
+        ::memcpy(&word, &buffer[index], 8);
+        const uint64_t conts = (((word & ~(word << 1)) & 0x8080808080808080ull) >> 7);
+        const uint64_t leads = (((word & (word << 1) & (word << 2) & (word << 3)) & 0x8080808080808080ull) >> 7);
+        units += (8 - static_cast<uint32_t>((conts * 0x0101010101010101ull) >> 56) + static_cast<uint32_t>((leads * 0x0101010101010101ull) >> 56));
+    }
+    for (; index < size; ++index)
+    {
+        const uint8_t value = buffer[index];
+        units += ((value & 0xc0u) != 0x80u) ? ((value >= 0xf0u) ? 2 : 1) : 0;
+    }
+    return (units << 1);
+}
+
+static uint32_t sizeUTF8fromUTF16_swar(const uint8_t* const buffer, const uint32_t units, uint32_t unit, uint32_t needs, const bool big_endian, const bool use_java) noexcept
+{   //  unpaired surrogates are skipped (as getUTF16le() and getUTF16be() reject them)
+    const uint32_t high = big_endian ? 0 : 1;
+    for (; unit < units; ++unit)
+    {
+        const uint32_t value = ((static_cast<uint32_t>(buffer[(unit << 1) + high]) << 8) | buffer[(unit << 1) + (high ^ 1)]);
+        if ((value & 0xf800u) != 0xd800u)
+        {
+            needs += (value <= 0x007fu) ? ((use_java && (value == 0)) ? 2 : 1) : ((value <= 0x07ffu) ? 2 : 3);
+        }
+        else if (((value & 0xfc00u) == 0xd800u) && ((unit + 1) < units) && ((buffer[(unit << 1) + 2 + high] & 0xfcu) == 0xdcu))
+        {
+            needs += 4;
+            ++unit;
+        }
+    }
+    return needs;
+}
+
+static uint32_t sizeFromUTF32_swar(const uint8_t* const buffer, const uint32_t units, uint32_t unit, uint32_t needs, const bool big_endian, const bool use_java, const bool utf16) noexcept
+{   //  values that getUTF32le() and getUTF32be() reject are skipped
+    for (; unit < units; ++unit)
+    {
+        const uint8_t* const bytes = &buffer[unit << 2];
+        const uint32_t value = big_endian ? ((static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) | (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3])
+                                          : ((static_cast<uint32_t>(bytes[3]) << 24) | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[1]) << 8) | bytes[0]);
+        if ((value <= 0x0010ffffu) && ((value & 0xfffff800u) != 0x0000d800u))
+        {
+            if (utf16)
+            {
+                needs += (value <= 0x0000ffffu) ? 2 : 4;
+            }
+            else
+            {
+                needs += (value <= 0x0000007fu) ? ((use_java && (value == 0)) ? 2 : 1) : ((value <= 0x000007ffu) ? 2 : ((value <= 0x0000ffffu) ? 3 : 4));
+            }
+        }
+    }
+    return needs;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== SSE4.2 conversion size calculation ====
+
+SUITE_UTF_TARGET_SSE42 static uint32_t sizeUTF16fromUTF8_sse(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i cont = _mm_set1_epi8(-64);
+    const __m128i lead = _mm_set1_epi8(static_cast<char>(0xf0u));
+    __m128i totals = zero;
+    uint32_t index = 0;
+    while ((size - index) >= 64)
+    {   //  byte counters are flushed before they can overflow (8 per iteration)
+        __m128i counts = zero;
+        for (uint32_t limit = 31; limit && ((size - index) >= 64); --limit)
+        {
+            const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+            for (uint32_t part = 0; part < 4; ++part)
+            {
+                const __m128i input = _mm_loadu_si128(block + part);
+                counts = _mm_add_epi8(counts, _mm_sub_epi8(_mm_add_epi8(one, _mm_cmpgt_epi8(cont, input)), _mm_cmpeq_epi8(_mm_max_epu8(input, lead), input)));
+            }
+            index += 64;
+        }
+        totals = _mm_add_epi64(totals, _mm_sad_epu8(counts, zero));
+    }
+    const uint32_t units = static_cast<uint32_t>(_mm_cvtsi128_si32(totals) + _mm_cvtsi128_si32(_mm_srli_si128(totals, 8)));
+    return sizeUTF16fromUTF8_swar(buffer, size, index, units);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline __m128i sizeUTF8fromUTF16_sse(const __m128i units, const __m128i next, const bool use_java) noexcept
+{   //  UTF8 bytes needed for each code-unit (4 for a high surrogate followed by a low surrogate and 0 for other surrogates)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xf800u))), _mm_set1_epi16(static_cast<short>(0xd800u)));
+    const __m128i pairs = _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xfc00u))), _mm_set1_epi16(static_cast<short>(0xd800u))),
+                                        _mm_cmpeq_epi16(_mm_and_si128(next, _mm_set1_epi16(static_cast<short>(0xfc00u))), _mm_set1_epi16(static_cast<short>(0xdc00u))));
+    __m128i needs = _mm_add_epi16(_mm_set1_epi16(3), _mm_add_epi16(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xff80u))), zero), _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xf800u))), zero)));
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        needs = _mm_sub_epi16(needs, _mm_cmpeq_epi16(units, zero));
+    }
+    return _mm_sub_epi16(_mm_andnot_si128(surrogates, needs), _mm_slli_epi16(pairs, 2));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t sizeUTF8fromUTF16_sse(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept
+{
+    const uint32_t units = (size >> 1);
+    __m128i totals = _mm_setzero_si128();
+    uint32_t unit = 0;
+    while ((units - unit) > 16)
+    {   //  16-bit counters are flushed before they can overflow (8 per iteration)
+        __m128i counts = _mm_setzero_si128();
+        for (uint32_t limit = 0x0fff; limit && ((units - unit) > 16); --limit)
+        {
+            const uint8_t* const block = &buffer[unit << 1];
+            const __m128i units0 = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 0)), big_endian);
+            const __m128i next0 = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 2)), big_endian);
+            const __m128i units1 = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)), big_endian);
+            const __m128i next1 = swapUTF16_sse(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 18)), big_endian);
+            counts = _mm_add_epi16(counts, sizeUTF8fromUTF16_sse(units0, next0, use_java));
+            counts = _mm_add_epi16(counts, sizeUTF8fromUTF16_sse(units1, next1, use_java));
+            unit += 16;
+        }
+        totals = _mm_add_epi32(totals, _mm_madd_epi16(counts, _mm_set1_epi16(1)));
+    }
+    totals = _mm_add_epi32(totals, _mm_srli_si128(totals, 8));
+    totals = _mm_add_epi32(totals, _mm_srli_si128(totals, 4));
+    return sizeUTF8fromUTF16_swar(buffer, units, unit, static_cast<uint32_t>(_mm_cvtsi128_si32(totals)), big_endian, use_java);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline __m128i sizeFromUTF32_sse(const __m128i values, const bool use_java, const bool utf16) noexcept
+{   //  UTF8 or UTF16 bytes needed for each value (0 for values that are not valid code-points)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i valid = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(values, _mm_set1_epi32(static_cast<int>(0xfffff800u))), _mm_set1_epi32(0x0000d800)),
+                                           _mm_cmpeq_epi32(_mm_min_epu32(values, _mm_set1_epi32(0x0010ffff)), values));
+    const __m128i bmp = _mm_cmpeq_epi32(_mm_and_si128(values, _mm_set1_epi32(static_cast<int>(0xffff0000u))), zero);
+    if (utf16)
+    {
+        return _mm_and_si128(valid, _mm_add_epi32(_mm_set1_epi32(4), _mm_add_epi32(bmp, bmp)));
+    }
+    __m128i needs = _mm_add_epi32(_mm_add_epi32(_mm_set1_epi32(4), bmp),
+                                  _mm_add_epi32(_mm_cmpeq_epi32(_mm_and_si128(values, _mm_set1_epi32(static_cast<int>(0xffffff80u))), zero), _mm_cmpeq_epi32(_mm_and_si128(values, _mm_set1_epi32(static_cast<int>(0xfffff800u))), zero)));
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        needs = _mm_sub_epi32(needs, _mm_cmpeq_epi32(values, zero));
+    }
+    return _mm_and_si128(valid, needs);
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t sizeFromUTF32_sse(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java, const bool utf16) noexcept
+{
+    const uint32_t units = (size >> 2);
+    const __m128i swap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m128i totals = _mm_setzero_si128();
+    uint32_t unit = 0;
+    for (; (units - unit) >= 8; unit += 8)
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[unit << 2]);
+        __m128i values0 = _mm_loadu_si128(block + 0);
+        __m128i values1 = _mm_loadu_si128(block + 1);
+        if (big_endian)
+        {
+            values0 = _mm_shuffle_epi8(values0, swap);
+            values1 = _mm_shuffle_epi8(values1, swap);
+        }
+        totals = _mm_add_epi32(totals, _mm_add_epi32(sizeFromUTF32_sse(values0, use_java, utf16), sizeFromUTF32_sse(values1, use_java, utf16)));
+    }
+    totals = _mm_add_epi32(totals, _mm_srli_si128(totals, 8));
+    totals = _mm_add_epi32(totals, _mm_srli_si128(totals, 4));
+    return sizeFromUTF32_swar(buffer, units, unit, static_cast<uint32_t>(_mm_cvtsi128_si32(totals)), big_endian, use_java, utf16);
+}
+
+// ==== AVX2 conversion size calculation ====
+
+SUITE_UTF_TARGET_AVX2 static uint32_t sizeUTF16fromUTF8_avx2(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i cont = _mm256_set1_epi8(-64);
+    const __m256i lead = _mm256_set1_epi8(static_cast<char>(0xf0u));
+    __m256i totals = zero;
+    uint32_t index = 0;
+    while ((size - index) >= 128)
+    {   //  byte counters are flushed before they can overflow (8 per iteration)
+        __m256i counts = zero;
+        for (uint32_t limit = 31; limit && ((size - index) >= 128); --limit)
+        {
+            const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+            for (uint32_t part = 0; part < 4; ++part)
+            {
+                const __m256i input = _mm256_loadu_si256(block + part);
+                counts = _mm256_add_epi8(counts, _mm256_sub_epi8(_mm256_add_epi8(one, _mm256_cmpgt_epi8(cont, input)), _mm256_cmpeq_epi8(_mm256_max_epu8(input, lead), input)));
+            }
+            index += 128;
+        }
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counts, zero));
+    }
+    const __m128i sums = _mm_add_epi64(_mm256_castsi256_si128(totals), _mm256_extracti128_si256(totals, 1));
+    const uint32_t units = static_cast<uint32_t>(_mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    return sizeUTF16fromUTF8_swar(buffer, size, index, units);
+}
+
+SUITE_UTF_TARGET_AVX2 static inline __m256i sizeUTF8fromUTF16_avx2(const __m256i units, const __m256i next, const bool use_java) noexcept
+{   //  UTF8 bytes needed for each code-unit (4 for a high surrogate followed by a low surrogate and 0 for other surrogates)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i surrogates = _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xf800u))), _mm256_set1_epi16(static_cast<short>(0xd800u)));
+    const __m256i pairs = _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xfc00u))), _mm256_set1_epi16(static_cast<short>(0xd800u))),
+                                           _mm256_cmpeq_epi16(_mm256_and_si256(next, _mm256_set1_epi16(static_cast<short>(0xfc00u))), _mm256_set1_epi16(static_cast<short>(0xdc00u))));
+    __m256i needs = _mm256_add_epi16(_mm256_set1_epi16(3), _mm256_add_epi16(_mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xff80u))), zero), _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xf800u))), zero)));
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        needs = _mm256_sub_epi16(needs, _mm256_cmpeq_epi16(units, zero));
+    }
+    return _mm256_sub_epi16(_mm256_andnot_si256(surrogates, needs), _mm256_slli_epi16(pairs, 2));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t sizeUTF8fromUTF16_avx2(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept
+{
+    const uint32_t units = (size >> 1);
+    __m256i totals = _mm256_setzero_si256();
+    uint32_t unit = 0;
+    while ((units - unit) > 32)
+    {   //  16-bit counters are flushed before they can overflow (8 per iteration)
+        __m256i counts = _mm256_setzero_si256();
+        for (uint32_t limit = 0x0fff; limit && ((units - unit) > 32); --limit)
+        {
+            const uint8_t* const block = &buffer[unit << 1];
+            const __m256i units0 = swapUTF16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 0)), big_endian);
+            const __m256i next0 = swapUTF16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 2)), big_endian);
+            const __m256i units1 = swapUTF16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)), big_endian);
+            const __m256i next1 = swapUTF16_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 34)), big_endian);
+            counts = _mm256_add_epi16(counts, sizeUTF8fromUTF16_avx2(units0, next0, use_java));
+            counts = _mm256_add_epi16(counts, sizeUTF8fromUTF16_avx2(units1, next1, use_java));
+            unit += 32;
+        }
+        totals = _mm256_add_epi32(totals, _mm256_madd_epi16(counts, _mm256_set1_epi16(1)));
+    }
+    __m128i sums = _mm_add_epi32(_mm256_castsi256_si128(totals), _mm256_extracti128_si256(totals, 1));
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 8));
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 4));
+    return sizeUTF8fromUTF16_swar(buffer, units, unit, static_cast<uint32_t>(_mm_cvtsi128_si32(sums)), big_endian, use_java);
+}
+
+SUITE_UTF_TARGET_AVX2 static inline __m256i sizeFromUTF32_avx2(const __m256i values, const bool use_java, const bool utf16) noexcept
+{   //  UTF8 or UTF16 bytes needed for each value (0 for values that are not valid code-points)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i valid = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(values, _mm256_set1_epi32(static_cast<int>(0xfffff800u))), _mm256_set1_epi32(0x0000d800)),
+                                              _mm256_cmpeq_epi32(_mm256_min_epu32(values, _mm256_set1_epi32(0x0010ffff)), values));
+    const __m256i bmp = _mm256_cmpeq_epi32(_mm256_and_si256(values, _mm256_set1_epi32(static_cast<int>(0xffff0000u))), zero);
+    if (utf16)
+    {
+        return _mm256_and_si256(valid, _mm256_add_epi32(_mm256_set1_epi32(4), _mm256_add_epi32(bmp, bmp)));
+    }
+    __m256i needs = _mm256_add_epi32(_mm256_add_epi32(_mm256_set1_epi32(4), bmp),
+                                     _mm256_add_epi32(_mm256_cmpeq_epi32(_mm256_and_si256(values, _mm256_set1_epi32(static_cast<int>(0xffffff80u))), zero), _mm256_cmpeq_epi32(_mm256_and_si256(values, _mm256_set1_epi32(static_cast<int>(0xfffff800u))), zero)));
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        needs = _mm256_sub_epi32(needs, _mm256_cmpeq_epi32(values, zero));
+    }
+    return _mm256_and_si256(valid, needs);
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t sizeFromUTF32_avx2(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java, const bool utf16) noexcept
+{
+    const uint32_t units = (size >> 2);
+    const __m256i swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i totals = _mm256_setzero_si256();
+    uint32_t unit = 0;
+    for (; (units - unit) >= 16; unit += 16)
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[unit << 2]);
+        __m256i values0 = _mm256_loadu_si256(block + 0);
+        __m256i values1 = _mm256_loadu_si256(block + 1);
+        if (big_endian)
+        {
+            values0 = _mm256_shuffle_epi8(values0, swap);
+            values1 = _mm256_shuffle_epi8(values1, swap);
+        }
+        totals = _mm256_add_epi32(totals, _mm256_add_epi32(sizeFromUTF32_avx2(values0, use_java, utf16), sizeFromUTF32_avx2(values1, use_java, utf16)));
+    }
+    __m128i sums = _mm_add_epi32(_mm256_castsi256_si128(totals), _mm256_extracti128_si256(totals, 1));
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 8));
+    sums = _mm_add_epi32(sums, _mm_srli_si128(sums, 4));
+    return sizeFromUTF32_swar(buffer, units, unit, static_cast<uint32_t>(_mm_cvtsi128_si32(sums)), big_endian, use_java, utf16);
+}
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+// ==== AVX-512 conversion size calculation ====
+
+SUITE_UTF_TARGET_AVX512 static uint32_t sizeUTF16fromUTF8_avx512(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    const __m512i cont = _mm512_set1_epi8(-64);
+    const __m512i lead = _mm512_set1_epi8(static_cast<char>(0xf0u));
+    __m512i totals = zero;
+    uint32_t index = 0;
+    while ((size - index) >= 128)
+    {   //  byte counters are flushed before they can overflow (4 per iteration)
+        __m512i counts = zero;
+        for (uint32_t limit = 63; limit && ((size - index) >= 128); --limit)
+        {
+            const __m512i input0 = _mm512_loadu_si512(&buffer[index]);
+            const __m512i input1 = _mm512_loadu_si512(&buffer[index + 64]);
+            counts = _mm512_mask_add_epi8(counts, ~_mm512_cmpgt_epi8_mask(cont, input0), counts, one);
+            counts = _mm512_mask_add_epi8(counts, _mm512_cmpge_epu8_mask(input0, lead), counts, one);
+            counts = _mm512_mask_add_epi8(counts, ~_mm512_cmpgt_epi8_mask(cont, input1), counts, one);
+            counts = _mm512_mask_add_epi8(counts, _mm512_cmpge_epu8_mask(input1, lead), counts, one);
+            index += 128;
+        }
+        totals = _mm512_add_epi64(totals, _mm512_sad_epu8(counts, zero));
+    }
+    return sizeUTF16fromUTF8_swar(buffer, size, index, static_cast<uint32_t>(_mm512_reduce_add_epi64(totals)));
+}
+
+SUITE_UTF_TARGET_AVX512 static inline __m512i sizeUTF8fromUTF16_avx512(const __m512i units, const __m512i next, const bool use_java) noexcept
+{   //  UTF8 bytes needed for each code-unit (4 for a high surrogate followed by a low surrogate and 0 for other surrogates)
+    const __mmask32 surrogates = _mm512_cmpeq_epi16_mask(_mm512_and_si512(units, _mm512_set1_epi16(static_cast<short>(0xf800u))), _mm512_set1_epi16(static_cast<short>(0xd800u)));
+    const __mmask32 pairs = (_mm512_cmpeq_epi16_mask(_mm512_and_si512(units, _mm512_set1_epi16(static_cast<short>(0xfc00u))), _mm512_set1_epi16(static_cast<short>(0xd800u))) &
+                             _mm512_cmpeq_epi16_mask(_mm512_and_si512(next, _mm512_set1_epi16(static_cast<short>(0xfc00u))), _mm512_set1_epi16(static_cast<short>(0xdc00u))));
+    const __m512i one = _mm512_set1_epi16(1);
+    __m512i needs = _mm512_mask_add_epi16(one, _mm512_cmpge_epu16_mask(units, _mm512_set1_epi16(0x0080)), one, one);
+    needs = _mm512_mask_add_epi16(needs, _mm512_cmpge_epu16_mask(units, _mm512_set1_epi16(0x0800)), needs, one);
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        needs = _mm512_mask_add_epi16(needs, _mm512_testn_epi16_mask(units, units), needs, one);
+    }
+    return _mm512_mask_mov_epi16(_mm512_maskz_mov_epi16(~surrogates, needs), pairs, _mm512_set1_epi16(4));
+}
+
+SUITE_UTF_TARGET_AVX512 static uint32_t sizeUTF8fromUTF16_avx512(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept
+{
+    const uint32_t units = (size >> 1);
+    __m512i totals = _mm512_setzero_si512();
+    uint32_t unit = 0;
+    while ((units - unit) > 64)
+    {   //  16-bit counters are flushed before they can overflow (8 per iteration)
+        __m512i counts = _mm512_setzero_si512();
+        for (uint32_t limit = 0x0fff; limit && ((units - unit) > 64); --limit)
+        {
+            const uint8_t* const block = &buffer[unit << 1];
+            const __m512i units0 = swapUTF16_avx512(_mm512_loadu_si512(block + 0), big_endian);
+            const __m512i next0 = swapUTF16_avx512(_mm512_loadu_si512(block + 2), big_endian);
+            const __m512i units1 = swapUTF16_avx512(_mm512_loadu_si512(block + 64), big_endian);
+            const __m512i next1 = swapUTF16_avx512(_mm512_loadu_si512(block + 66), big_endian);
+            counts = _mm512_add_epi16(counts, sizeUTF8fromUTF16_avx512(units0, next0, use_java));
+            counts = _mm512_add_epi16(counts, sizeUTF8fromUTF16_avx512(units1, next1, use_java));
+            unit += 64;
+        }
+        totals = _mm512_add_epi32(totals, _mm512_madd_epi16(counts, _mm512_set1_epi16(1)));
+    }
+    return sizeUTF8fromUTF16_swar(buffer, units, unit, static_cast<uint32_t>(_mm512_reduce_add_epi32(totals)), big_endian, use_java);
+}
+
+SUITE_UTF_TARGET_AVX512 static inline __m512i sizeFromUTF32_avx512(const __m512i values, const bool use_java, const bool utf16) noexcept
+{   //  UTF8 or UTF16 bytes needed for each value (0 for values that are not valid code-points)
+    const __mmask16 valid = (_mm512_cmple_epu32_mask(values, _mm512_set1_epi32(0x0010ffff)) & ~_mm512_cmpeq_epi32_mask(_mm512_and_si512(values, _mm512_set1_epi32(static_cast<int>(0xfffff800u))), _mm512_set1_epi32(0x0000d800)));
+    const __mmask16 bmp = _mm512_cmplt_epu32_mask(values, _mm512_set1_epi32(0x00010000));
+    if (utf16)
+    {
+        return _mm512_maskz_mov_epi32(valid, _mm512_mask_mov_epi32(_mm512_set1_epi32(4), bmp, _mm512_set1_epi32(2)));
+    }
+    __m512i needs = _mm512_mask_mov_epi32(_mm512_set1_epi32(4), bmp, _mm512_set1_epi32(3));
+    needs = _mm512_mask_mov_epi32(needs, _mm512_cmplt_epu32_mask(values, _mm512_set1_epi32(0x00000800)), _mm512_set1_epi32(2));
+    needs = _mm512_mask_mov_epi32(needs, _mm512_cmplt_epu32_mask(values, _mm512_set1_epi32(0x00000080)), _mm512_set1_epi32(1));
+    if (use_java)
+    {   //  Java UTF8 encodes NULL as 2 bytes
+        needs = _mm512_mask_mov_epi32(needs, _mm512_testn_epi32_mask(values, values), _mm512_set1_epi32(2));
+    }
+    return _mm512_maskz_mov_epi32(valid, needs);
+}
+
+SUITE_UTF_TARGET_AVX512 static uint32_t sizeFromUTF32_avx512(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java, const bool utf16) noexcept
+{
+    const uint32_t units = (size >> 2);
+    const __m512i swap = _mm512_broadcast_i32x4(_mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+    __m512i totals = _mm512_setzero_si512();
+    uint32_t unit = 0;
+    for (; (units - unit) >= 32; unit += 32)
+    {
+        __m512i values0 = _mm512_loadu_si512(&buffer[unit << 2]);
+        __m512i values1 = _mm512_loadu_si512(&buffer[(unit << 2) + 64]);
+        if (big_endian)
+        {
+            values0 = _mm512_shuffle_epi8(values0, swap);
+            values1 = _mm512_shuffle_epi8(values1, swap);
+        }
+        totals = _mm512_add_epi32(totals, _mm512_add_epi32(sizeFromUTF32_avx512(values0, use_java, utf16), sizeFromUTF32_avx512(values1, use_java, utf16)));
+    }
+    return sizeFromUTF32_swar(buffer, units, unit, static_cast<uint32_t>(_mm512_reduce_add_epi32(totals)), big_endian, use_java, utf16);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) null terminator scanning ====
+
+static inline bool isNull(const uint8_t* const unit, const uint32_t unitSize) noexcept
+{
+    return (unitSize == 1) ? (unit[0] == 0) : ((unitSize == 2) ? ((unit[0] | unit[1]) == 0) : ((unit[0] | unit[1] | unit[2] | unit[3]) == 0));
+}
+
+static uint32_t findNull_swar(const uint8_t* const buffer, const uint32_t unitSize) noexcept
+{   //  aligned 8 byte reads never cross a page boundary (a buffer that is not aligned to the unit size is read one unit at a time)
+    uint32_t index = 0;
+    if ((reinterpret_cast<uintptr_t>(buffer) & (unitSize - 1)) == 0)
+    {
+        const uint64_t low = (unitSize == 1) ? 0x0101010101010101ull : ((unitSize == 2) ? 0x0001000100010001ull : 0x0000000100000001ull);
+        const uint64_t high = (low << ((unitSize << 3) - 1));
+        for (; (reinterpret_cast<uintptr_t>(&buffer[index]) & 7) != 0; index += unitSize)
+        {
+            if (isNull(&buffer[index], unitSize))
+            {
+                return index;
+            }
+        }
+        for (;; index += 8)
+        {   //  detects any zero lane of the unit size
+            uint64_t word;
+            ::memcpy(&word, &buffer[index], 8);
+            if (((word - low) & ~word & high) != 0)
+            {
+                break;
+            }
+        }
+    }
+    while (!isNull(&buffer[index], unitSize))
+    {
+        index += unitSize;
+    }
+    return index;
+}
+
+static uint32_t countNullUTF8_swar(const uint8_t* const buffer, uint32_t& bytes) noexcept
+{   //  counts the bytes that are not continuation bytes before the null terminator
+    uint32_t count = 0;
+    uint32_t index = 0;
+    for (; (reinterpret_cast<uintptr_t>(&buffer[index]) & 7) != 0; ++index)
+    {
+        if (buffer[index] == 0)
+        {
+            bytes = index;
+            return count;
+        }
+        if ((buffer[index] & 0xc0u) != 0x80u)
+        {
+            ++count;
+        }
+    }
+    for (;; index += 8)
+    {
+        uint64_t word;
+        ::memcpy(&word, &buffer[index], 8);
+        if (((word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull) != 0)
+        {
+            break;
+        }
+        const uint64_t conts = (((word & ~(word << 1)) & 0x8080808080808080ull) >> 7);
+        count += (8 - static_cast<uint32_t>((conts * 0x0101010101010101ull) >> 56));
+    }
+    for (; buffer[index] != 0; ++index)
+    {
+        if ((buffer[index] & 0xc0u) != 0x80u)
+        {
+            ++count;
+        }
+    }
+    bytes = index;
+    return count;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== aligned block null terminator scanning ====
+// ==== note: aligned 64 byte blocks never cross a page boundary, bytes before the buffer are masked out of the first block ====
+
+static inline uint64_t nullUnits(const uint64_t zeros, const uint32_t unitSize) noexcept
+{   //  reduces a mask of the zero bytes to the first byte of each zero unit
+    if (unitSize == 1)
+    {
+        return zeros;
+    }
+    const uint64_t pairs = (zeros & (zeros >> 1));
+    return (unitSize == 2) ? (pairs & 0x5555555555555555ull) : (pairs & (pairs >> 2) & 0x1111111111111111ull);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint64_t scanBlock_sse(const uint8_t* const block, uint64_t& leads) noexcept
+{   //  returns the zero byte mask and the mask of the bytes that are not continuation bytes
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i cont = _mm_set1_epi8(-64);
+    uint64_t zeros = 0;
+    uint64_t conts = 0;
+    for (uint32_t part = 0; part < 4; ++part)
+    {
+        const __m128i input = _mm_load_si128(reinterpret_cast<const __m128i*>(block) + part);
+        zeros |= (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(input, zero)))) << (part << 4));
+        conts |= (static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(cont, input)))) << (part << 4));
+    }
+    leads = ~conts;
+    return zeros;
+}
+
+SUITE_UTF_TARGET_AVX2 static inline uint64_t scanBlock_avx2(const uint8_t* const block, uint64_t& leads) noexcept
+{   //  returns the zero byte mask and the mask of the bytes that are not continuation bytes
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i cont = _mm256_set1_epi8(-64);
+    const __m256i input0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block) + 0);
+    const __m256i input1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block) + 1);
+    leads = ~(static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(cont, input0)))) |
+              (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(cont, input1)))) << 32));
+    return (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(input0, zero)))) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(input1, zero)))) << 32));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findNull_sse(const uint8_t* const buffer, const uint32_t unitSize) noexcept
+{
+    const uint32_t offset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer) & 63);
+    const uint8_t* block = (buffer - offset);
+    uint64_t leads;
+    uint64_t nulls = (nullUnits(scanBlock_sse(block, leads), unitSize) & (~0ull << offset));
+    uint32_t index = (0u - offset);
+    while (nulls == 0)
+    {
+        block += 64;
+        index += 64;
+        nulls = nullUnits(scanBlock_sse(block, leads), unitSize);
+    }
+    return (index + trailingZeros(nulls));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t countNullUTF8_sse(const uint8_t* const buffer, uint32_t& bytes) noexcept
+{
+    const uint32_t offset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer) & 63);
+    const uint8_t* block = (buffer - offset);
+    uint64_t range = (~0ull << offset);
+    uint32_t index = (0u - offset);
+    uint32_t count = 0;
+    for (;;)
+    {
+        uint64_t leads;
+        const uint64_t zeros = (scanBlock_sse(block, leads) & range);
+        if (zeros != 0)
+        {   //  count up to the terminator
+            bytes = (index + trailingZeros(zeros));
+            return (count + populationCount(leads & range & ((zeros & (0 - zeros)) - 1)));
+        }
+        count += populationCount(leads & range);
+        range = ~0ull;
+        block += 64;
+        index += 64;
+    }
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findNull_avx2(const uint8_t* const buffer, const uint32_t unitSize) noexcept
+{
+    const uint32_t offset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer) & 63);
+    const uint8_t* block = (buffer - offset);
+    uint64_t leads;
+    uint64_t nulls = (nullUnits(scanBlock_avx2(block, leads), unitSize) & (~0ull << offset));
+    uint32_t index = (0u - offset);
+    while (nulls == 0)
+    {
+        block += 64;
+        index += 64;
+        nulls = nullUnits(scanBlock_avx2(block, leads), unitSize);
+    }
+    return (index + trailingZeros(nulls));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t countNullUTF8_avx2(const uint8_t* const buffer, uint32_t& bytes) noexcept
+{
+    const uint32_t offset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer) & 63);
+    const uint8_t* block = (buffer - offset);
+    uint64_t range = (~0ull << offset);
+    uint32_t index = (0u - offset);
+    uint32_t count = 0;
+    for (;;)
+    {
+        uint64_t leads;
+        const uint64_t zeros = (scanBlock_avx2(block, leads) & range);
+        if (zeros != 0)
+        {   //  count up to the terminator
+            bytes = (index + trailingZeros(zeros));
+            return (count + populationCount(leads & range & ((zeros & (0 - zeros)) - 1)));
+        }
+        count += populationCount(leads & range);
+        range = ~0ull;
+        block += 64;
+        index += 64;
+    }
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) line break scanning ====
+
+static uint32_t findLineBreakUTF8_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index) noexcept
+{   //  detects any 0x0a or 0x0d lane 8 bytes at a time
+    for (; (size - index) >= 8; index += 8)
+    {
+        uint64_t word;
+        ::memcpy(&word, &buffer[index], 8);
+        const uint64_t lf = (word ^ 0x0a0a0a0a0a0a0a0aull);
+        const uint64_t cr = (word ^ 0x0d0d0d0d0d0d0d0dull);
+        if (((((lf - 0x0101010101010101ull) & ~lf) | ((cr - 0x0101010101010101ull) & ~cr)) & 0x8080808080808080ull) != 0)
+        {
+            break;
+        }
+    }
+    while ((index < size) && (buffer[index] != 0x0au) && (buffer[index] != 0x0du))
+    {
+        ++index;
+    }
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== SSE4.2 line break scanning ====
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findLineBreakUTF8_sse(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m128i lf = _mm_set1_epi8(0x0a);
+    const __m128i cr = _mm_set1_epi8(0x0d);
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+        const __m128i bytes0 = _mm_loadu_si128(block + 0);
+        const __m128i bytes1 = _mm_loadu_si128(block + 1);
+        const __m128i bytes2 = _mm_loadu_si128(block + 2);
+        const __m128i bytes3 = _mm_loadu_si128(block + 3);
+        const uint64_t breaks0 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes0, lf), _mm_cmpeq_epi8(bytes0, cr))));
+        const uint64_t breaks1 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes1, lf), _mm_cmpeq_epi8(bytes1, cr))));
+        const uint64_t breaks2 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes2, lf), _mm_cmpeq_epi8(bytes2, cr))));
+        const uint64_t breaks3 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes3, lf), _mm_cmpeq_epi8(bytes3, cr))));
+        const uint64_t breaks = (breaks0 | (breaks1 << 16) | (breaks2 << 32) | (breaks3 << 48));
+        if (breaks != 0)
+        {
+            return (index + trailingZeros(breaks));
+        }
+    }
+    return findLineBreakUTF8_swar(buffer, size, index);
+}
+
+// ==== AVX2 line break scanning ====
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findLineBreakUTF8_avx2(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    const __m256i lf = _mm256_set1_epi8(0x0a);
+    const __m256i cr = _mm256_set1_epi8(0x0d);
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+        const __m256i bytes0 = _mm256_loadu_si256(block + 0);
+        const __m256i bytes1 = _mm256_loadu_si256(block + 1);
+        const uint64_t breaks0 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(bytes0, lf), _mm256_cmpeq_epi8(bytes0, cr))));
+        const uint64_t breaks1 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(bytes1, lf), _mm256_cmpeq_epi8(bytes1, cr))));
+        const uint64_t breaks = (breaks0 | (breaks1 << 32));
+        if (breaks != 0)
+        {
+            return (index + trailingZeros(breaks));
+        }
+    }
+    return findLineBreakUTF8_swar(buffer, size, index);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== scalar (SWAR) line terminator candidate scanning ====
+
+static inline bool isPlainASCII(const uint64_t word) noexcept
+{   //  true if the 8 bytes are 0x01 to 0x09 or 0x0e to 0x7f
+    const uint64_t zeros = ((word - 0x0101010101010101ull) & ~word);
+    const uint64_t breaks = ((0x8d8d8d8d8d8d8d8dull - word) & (word + 0x7676767676767676ull));
+    return (((word | zeros | breaks) & 0x8080808080808080ull) == 0);
+}
+
+static inline bool isLineCandidateUTF8(const uint8_t* const buffer, const uint32_t index, const uint32_t size) noexcept
+{   //  a sequence truncated by the end of the buffer is a candidate
+    const uint8_t byte = buffer[index];
+    const uint32_t rest = (size - index - 1);
+    switch (byte)
+    {
+        case(0x00u):
+        case(0x0au):
+        case(0x0bu):
+        case(0x0cu):
+        case(0x0du):
+        {
+            return true;
+        }
+        case(0xc2u):
+        {   //  next line
+            return ((rest < 1) || (buffer[index + 1] == 0x85u));
+        }
+        case(0xe2u):
+        {   //  line or paragraph separator
+            return ((rest < 2) || ((buffer[index + 1] == 0x80u) && ((buffer[index + 2] | 0x01u) == 0xa9u)));
+        }
+        case(0xefu):
+        {   //  U+FDC0 to U+FDFF and U+FFC0 to U+FFFF (includes the non-characters)
+            return ((rest < 1) || ((buffer[index + 1] | 0x08u) == 0xbfu));
+        }
+        default:
+        {
+            return (byte >= 0xf0u);
+        }
+    }
+}
+
+static inline bool isLineCandidateBYTE(const uint8_t byte) noexcept
+{
+    return ((byte == 0x00u) || (byte >= 0x80u) || (static_cast<uint8_t>(byte - 0x0au) < 4));
+}
+
+static inline bool isLineCandidateUnit(const uint32_t unit) noexcept
+{
+    return ((unit == 0x0000u) || ((unit - 0x000au) < 4) || (unit == 0x0085u) || ((unit | 1) == 0x2029u) || (unit >= 0xd800u));
+}
+
+static uint32_t findLineCandidateUTF8_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index) noexcept
+{
+    while (index < size)
+    {
+        if ((size - index) >= 8)
+        {   //  skip 8 plain ASCII bytes at a time
+            uint64_t word;
+            ::memcpy(&word, &buffer[index], 8);
+            if (isPlainASCII(word))
+            {
+                index += 8;
+                continue;
+            }
+        }
+        if (isLineCandidateUTF8(buffer, index, size))
+        {
+            break;
+        }
+        ++index;
+    }
+    return index;
+}
+
+static uint32_t findLineCandidateBYTE_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index) noexcept
+{
+    for (; (size - index) >= 8; index += 8)
+    {
+        uint64_t word;
+        ::memcpy(&word, &buffer[index], 8);
+        if (!isPlainASCII(word))
+        {
+            break;
+        }
+    }
+    while ((index < size) && !isLineCandidateBYTE(buffer[index]))
+    {
+        ++index;
+    }
+    return index;
+}
+
+static uint32_t findLineCandidateUTF16_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index, const bool big_endian) noexcept
+{
+    const uint32_t high = big_endian ? 0 : 1;
+    for (; (size - index) >= 2; index += 2)
+    {
+        if (isLineCandidateUnit((static_cast<uint32_t>(buffer[index + high]) << 8) | buffer[index + (high ^ 1)]))
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+static uint32_t findLineCandidateUTF32_swar(const uint8_t* const buffer, const uint32_t size, uint32_t index, const bool big_endian) noexcept
+{
+    for (; (size - index) >= 4; index += 4)
+    {
+        const uint8_t* const unit = &buffer[index];
+        const uint32_t value = big_endian ?
+            ((static_cast<uint32_t>(unit[0]) << 24) | (static_cast<uint32_t>(unit[1]) << 16) | (static_cast<uint32_t>(unit[2]) << 8) | unit[3]) :
+            ((static_cast<uint32_t>(unit[3]) << 24) | (static_cast<uint32_t>(unit[2]) << 16) | (static_cast<uint32_t>(unit[1]) << 8) | unit[0]);
+        if (isLineCandidateUnit(value))
+        {
+            break;
+        }
+    }
+    return index;
+}
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+// ==== SSE4.2 line terminator candidate scanning ====
+
+SUITE_UTF_TARGET_SSE42 static inline uint64_t lineCandidatesUTF8_sse(const uint8_t* const block) noexcept
+{   //  reads 18 bytes
+    const __m128i bytes0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 0));
+    const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 1));
+    const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 2));
+    const __m128i controls = _mm_or_si128(_mm_cmpeq_epi8(bytes0, _mm_setzero_si128()), _mm_cmplt_epi8(_mm_add_epi8(bytes0, _mm_set1_epi8(0x76)), _mm_set1_epi8(-124)));
+    const __m128i nel = _mm_and_si128(_mm_cmpeq_epi8(bytes0, _mm_set1_epi8(static_cast<char>(0xc2u))), _mm_cmpeq_epi8(bytes1, _mm_set1_epi8(static_cast<char>(0x85u))));
+    const __m128i separators = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(bytes0, _mm_set1_epi8(static_cast<char>(0xe2u))), _mm_cmpeq_epi8(bytes1, _mm_set1_epi8(static_cast<char>(0x80u)))),
+                                             _mm_cmpeq_epi8(_mm_or_si128(bytes2, _mm_set1_epi8(0x01)), _mm_set1_epi8(static_cast<char>(0xa9u))));
+    const __m128i specials = _mm_and_si128(_mm_cmpeq_epi8(bytes0, _mm_set1_epi8(static_cast<char>(0xefu))), _mm_cmpeq_epi8(_mm_or_si128(bytes1, _mm_set1_epi8(0x08)), _mm_set1_epi8(static_cast<char>(0xbfu))));
+    const __m128i supplementary = _mm_cmpeq_epi8(_mm_max_epu8(bytes0, _mm_set1_epi8(static_cast<char>(0xf0u))), bytes0);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(controls, nel), _mm_or_si128(_mm_or_si128(separators, specials), supplementary))));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findLineCandidateUTF8_sse(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    uint32_t index = 0;
+    for (; (size - index) >= 66; index += 64)
+    {   //  the 2 bytes after the block are read for the multi-byte candidates
+        const uint8_t* const block = &buffer[index];
+        const uint64_t candidates = (lineCandidatesUTF8_sse(block) | (lineCandidatesUTF8_sse(block + 16) << 16) | (lineCandidatesUTF8_sse(block + 32) << 32) | (lineCandidatesUTF8_sse(block + 48) << 48));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateUTF8_swar(buffer, size, index);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint64_t lineCandidatesBYTE_sse(const __m128i bytes) noexcept
+{
+    const __m128i controls = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_setzero_si128()), _mm_cmplt_epi8(_mm_add_epi8(bytes, _mm_set1_epi8(0x76)), _mm_set1_epi8(-124)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(controls, bytes)));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findLineCandidateBYTE_sse(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+        const uint64_t candidates = (lineCandidatesBYTE_sse(_mm_loadu_si128(block + 0)) | (lineCandidatesBYTE_sse(_mm_loadu_si128(block + 1)) << 16) |
+                                     (lineCandidatesBYTE_sse(_mm_loadu_si128(block + 2)) << 32) | (lineCandidatesBYTE_sse(_mm_loadu_si128(block + 3)) << 48));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateBYTE_swar(buffer, size, index);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint64_t lineCandidatesUTF16_sse(const __m128i units) noexcept
+{   //  2 mask bits per code-unit
+    const __m128i controls = _mm_or_si128(_mm_cmpeq_epi16(units, _mm_setzero_si128()), _mm_and_si128(_mm_cmpgt_epi16(units, _mm_set1_epi16(0x0009)), _mm_cmplt_epi16(units, _mm_set1_epi16(0x000e))));
+    const __m128i separators = _mm_or_si128(_mm_cmpeq_epi16(units, _mm_set1_epi16(0x0085)), _mm_cmpeq_epi16(_mm_or_si128(units, _mm_set1_epi16(0x0001)), _mm_set1_epi16(0x2029)));
+    const __m128i surrogates = _mm_cmpeq_epi16(_mm_max_epu16(units, _mm_set1_epi16(static_cast<short>(0xd800u))), units);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(controls, separators), surrogates)));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findLineCandidateUTF16_sse(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const __m128i swap = big_endian ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+        const uint64_t candidates = (lineCandidatesUTF16_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 0), swap)) | (lineCandidatesUTF16_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 1), swap)) << 16) |
+                                     (lineCandidatesUTF16_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 2), swap)) << 32) | (lineCandidatesUTF16_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 3), swap)) << 48));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateUTF16_swar(buffer, size, index, big_endian);
+}
+
+SUITE_UTF_TARGET_SSE42 static inline uint64_t lineCandidatesUTF32_sse(const __m128i units) noexcept
+{   //  4 mask bits per code-unit
+    const __m128i controls = _mm_or_si128(_mm_cmpeq_epi32(units, _mm_setzero_si128()), _mm_and_si128(_mm_cmpgt_epi32(units, _mm_set1_epi32(0x00000009)), _mm_cmplt_epi32(units, _mm_set1_epi32(0x0000000e))));
+    const __m128i separators = _mm_or_si128(_mm_cmpeq_epi32(units, _mm_set1_epi32(0x00000085)), _mm_cmpeq_epi32(_mm_or_si128(units, _mm_set1_epi32(0x00000001)), _mm_set1_epi32(0x00002029)));
+    const __m128i surrogates = _mm_cmpeq_epi32(_mm_max_epu32(units, _mm_set1_epi32(0x0000d800)), units);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(controls, separators), surrogates)));
+}
+
+SUITE_UTF_TARGET_SSE42 static uint32_t findLineCandidateUTF32_sse(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const __m128i swap = big_endian ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) : _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m128i* const block = reinterpret_cast<const __m128i*>(&buffer[index]);
+        const uint64_t candidates = (lineCandidatesUTF32_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 0), swap)) | (lineCandidatesUTF32_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 1), swap)) << 16) |
+                                     (lineCandidatesUTF32_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 2), swap)) << 32) | (lineCandidatesUTF32_sse(_mm_shuffle_epi8(_mm_loadu_si128(block + 3), swap)) << 48));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateUTF32_swar(buffer, size, index, big_endian);
+}
+
+// ==== AVX2 line terminator candidate scanning ====
+
+SUITE_UTF_TARGET_AVX2 static inline uint64_t lineCandidatesUTF8_avx2(const uint8_t* const block) noexcept
+{   //  reads 34 bytes
+    const __m256i bytes0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 0));
+    const __m256i bytes1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 1));
+    const __m256i bytes2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 2));
+    const __m256i controls = _mm256_or_si256(_mm256_cmpeq_epi8(bytes0, _mm256_setzero_si256()), _mm256_cmpgt_epi8(_mm256_set1_epi8(-124), _mm256_add_epi8(bytes0, _mm256_set1_epi8(0x76))));
+    const __m256i nel = _mm256_and_si256(_mm256_cmpeq_epi8(bytes0, _mm256_set1_epi8(static_cast<char>(0xc2u))), _mm256_cmpeq_epi8(bytes1, _mm256_set1_epi8(static_cast<char>(0x85u))));
+    const __m256i separators = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(bytes0, _mm256_set1_epi8(static_cast<char>(0xe2u))), _mm256_cmpeq_epi8(bytes1, _mm256_set1_epi8(static_cast<char>(0x80u)))),
+                                                _mm256_cmpeq_epi8(_mm256_or_si256(bytes2, _mm256_set1_epi8(0x01)), _mm256_set1_epi8(static_cast<char>(0xa9u))));
+    const __m256i specials = _mm256_and_si256(_mm256_cmpeq_epi8(bytes0, _mm256_set1_epi8(static_cast<char>(0xefu))), _mm256_cmpeq_epi8(_mm256_or_si256(bytes1, _mm256_set1_epi8(0x08)), _mm256_set1_epi8(static_cast<char>(0xbfu))));
+    const __m256i supplementary = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes0, _mm256_set1_epi8(static_cast<char>(0xf0u))), bytes0);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(controls, nel), _mm256_or_si256(_mm256_or_si256(separators, specials), supplementary))));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findLineCandidateUTF8_avx2(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    uint32_t index = 0;
+    for (; (size - index) >= 66; index += 64)
+    {   //  the 2 bytes after the block are read for the multi-byte candidates
+        const uint64_t candidates = (lineCandidatesUTF8_avx2(&buffer[index]) | (lineCandidatesUTF8_avx2(&buffer[index + 32]) << 32));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateUTF8_swar(buffer, size, index);
+}
+
+SUITE_UTF_TARGET_AVX2 static inline uint64_t lineCandidatesBYTE_avx2(const __m256i bytes) noexcept
+{
+    const __m256i controls = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_setzero_si256()), _mm256_cmpgt_epi8(_mm256_set1_epi8(-124), _mm256_add_epi8(bytes, _mm256_set1_epi8(0x76))));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(controls, bytes)));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findLineCandidateBYTE_avx2(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+        const uint64_t candidates = (lineCandidatesBYTE_avx2(_mm256_loadu_si256(block + 0)) | (lineCandidatesBYTE_avx2(_mm256_loadu_si256(block + 1)) << 32));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateBYTE_swar(buffer, size, index);
+}
+
+SUITE_UTF_TARGET_AVX2 static inline uint64_t lineCandidatesUTF16_avx2(const __m256i units) noexcept
+{   //  2 mask bits per code-unit
+    const __m256i controls = _mm256_or_si256(_mm256_cmpeq_epi16(units, _mm256_setzero_si256()), _mm256_and_si256(_mm256_cmpgt_epi16(units, _mm256_set1_epi16(0x0009)), _mm256_cmpgt_epi16(_mm256_set1_epi16(0x000e), units)));
+    const __m256i separators = _mm256_or_si256(_mm256_cmpeq_epi16(units, _mm256_set1_epi16(0x0085)), _mm256_cmpeq_epi16(_mm256_or_si256(units, _mm256_set1_epi16(0x0001)), _mm256_set1_epi16(0x2029)));
+    const __m256i surrogates = _mm256_cmpeq_epi16(_mm256_max_epu16(units, _mm256_set1_epi16(static_cast<short>(0xd800u))), units);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(controls, separators), surrogates)));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findLineCandidateUTF16_avx2(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const __m256i swap = big_endian ? _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                                      _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+        const uint64_t candidates = (lineCandidatesUTF16_avx2(_mm256_shuffle_epi8(_mm256_loadu_si256(block + 0), swap)) | (lineCandidatesUTF16_avx2(_mm256_shuffle_epi8(_mm256_loadu_si256(block + 1), swap)) << 32));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateUTF16_swar(buffer, size, index, big_endian);
+}
+
+SUITE_UTF_TARGET_AVX2 static inline uint64_t lineCandidatesUTF32_avx2(const __m256i units) noexcept
+{   //  4 mask bits per code-unit
+    const __m256i controls = _mm256_or_si256(_mm256_cmpeq_epi32(units, _mm256_setzero_si256()), _mm256_and_si256(_mm256_cmpgt_epi32(units, _mm256_set1_epi32(0x00000009)), _mm256_cmpgt_epi32(_mm256_set1_epi32(0x0000000e), units)));
+    const __m256i separators = _mm256_or_si256(_mm256_cmpeq_epi32(units, _mm256_set1_epi32(0x00000085)), _mm256_cmpeq_epi32(_mm256_or_si256(units, _mm256_set1_epi32(0x00000001)), _mm256_set1_epi32(0x00002029)));
+    const __m256i surrogates = _mm256_cmpeq_epi32(_mm256_max_epu32(units, _mm256_set1_epi32(0x0000d800)), units);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(controls, separators), surrogates)));
+}
+
+SUITE_UTF_TARGET_AVX2 static uint32_t findLineCandidateUTF32_avx2(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    const __m256i swap = big_endian ? _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                                      _mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    uint32_t index = 0;
+    for (; (size - index) >= 64; index += 64)
+    {
+        const __m256i* const block = reinterpret_cast<const __m256i*>(&buffer[index]);
+        const uint64_t candidates = (lineCandidatesUTF32_avx2(_mm256_shuffle_epi8(_mm256_loadu_si256(block + 0), swap)) | (lineCandidatesUTF32_avx2(_mm256_shuffle_epi8(_mm256_loadu_si256(block + 1), swap)) << 32));
+        if (candidates != 0)
+        {
+            return (index + trailingZeros(candidates));
+        }
+    }
+    return findLineCandidateUTF32_swar(buffer, size, index, big_endian);
+}
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+// ==== kernel tier dispatch ====
+
+struct kernel_table
+{
+    uint32_t (*validSpanUTF8)(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept;
+    uint32_t (*convertUTF8toUTF16)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept;
+    uint32_t (*convertUTF16toUTF8)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_java) noexcept;
+    uint32_t (*convertCP1252toUTF8)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept;
+    uint32_t (*convertUTF8toCP1252)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool strict, const bool use_java) noexcept;
+    uint32_t (*convertBYTEtoUTF8)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept;
+    uint32_t (*convertUTF8toBYTE)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_ascii, const bool use_java) noexcept;
+    uint32_t (*convertBYTEtoUTF16)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept;
+    uint32_t (*convertUTF16toBYTE)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept;
+    uint32_t (*convertMUTF8toUTF8)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept;
+    uint32_t (*convertUTF8toMUTF8)(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept;
+    uint32_t (*countUTF8)(const uint8_t* const buffer, const uint32_t size) noexcept;
+    uint32_t (*countUTF16)(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+    uint32_t (*sizeUTF16fromUTF8)(const uint8_t* const buffer, const uint32_t size) noexcept;
+    uint32_t (*sizeUTF8fromUTF16)(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept;
+    uint32_t (*sizeFromUTF32)(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java, const bool utf16) noexcept;
+    uint32_t (*findNull)(const uint8_t* const buffer, const uint32_t unitSize) noexcept;     //  the buffer must be aligned to unitSize
+    uint32_t (*countNullUTF8)(const uint8_t* const buffer, uint32_t& bytes) noexcept;
+    uint32_t (*findLineBreakUTF8)(const uint8_t* const buffer, const uint32_t size) noexcept;
+    uint32_t (*findLineCandidateUTF8)(const uint8_t* const buffer, const uint32_t size) noexcept;
+    uint32_t (*findLineCandidateBYTE)(const uint8_t* const buffer, const uint32_t size) noexcept;
+    uint32_t (*findLineCandidateUTF16)(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+    uint32_t (*findLineCandidateUTF32)(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept;
+};
+
+static uint32_t validSpanUTF8_scalar(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+{
+    return validSpanUTF8_swar(buffer, size, 0, use_java);
+}
+
+static uint32_t findRewriteUTF8_scalar(const uint8_t* const buffer, const uint32_t size, const bool use_cesu, const bool use_java) noexcept
+{
+    return findRewriteUTF8_swar(buffer, size, 0, use_cesu, use_java);
+}
+
+static uint32_t convertMUTF8toUTF8_scalar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertMUTF8toUTF8_spans(&validSpanUTF8_scalar, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+static uint32_t convertUTF8toMUTF8_scalar(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t index, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    return convertUTF8toMUTF8_spans(&validSpanUTF8_scalar, &findRewriteUTF8_scalar, src, srcSize, dst, dstSize, index, written, use_cesu, use_java);
+}
+
+static uint32_t countUTF8_scalar(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    return countUTF8_swar(buffer, size, 0, 0);
+}
+
+static uint32_t countUTF16_scalar(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    return ((size >> 1) - pairsUTF16_swar(buffer, (size >> 1), 0, 0, big_endian));
+}
+
+static uint32_t sizeUTF16fromUTF8_scalar(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    return sizeUTF16fromUTF8_swar(buffer, size, 0, 0);
+}
+
+static uint32_t sizeUTF8fromUTF16_scalar(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept
+{
+    return sizeUTF8fromUTF16_swar(buffer, (size >> 1), 0, 0, big_endian, use_java);
+}
+
+static uint32_t sizeFromUTF32_scalar(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java, const bool utf16) noexcept
+{
+    return sizeFromUTF32_swar(buffer, (size >> 2), 0, 0, big_endian, use_java, utf16);
+}
+
+static uint32_t findLineBreakUTF8_scalar(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    return findLineBreakUTF8_swar(buffer, size, 0);
+}
+
+static uint32_t findLineCandidateUTF8_scalar(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    return findLineCandidateUTF8_swar(buffer, size, 0);
+}
+
+static uint32_t findLineCandidateBYTE_scalar(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    return findLineCandidateBYTE_swar(buffer, size, 0);
+}
+
+static uint32_t findLineCandidateUTF16_scalar(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    return findLineCandidateUTF16_swar(buffer, size, 0, big_endian);
+}
+
+static uint32_t findLineCandidateUTF32_scalar(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    return findLineCandidateUTF32_swar(buffer, size, 0, big_endian);
+}
+
+static const kernel_table kKernelsScalar =
+{
+    &validSpanUTF8_scalar, &convertUTF8toUTF16_swar, &convertUTF16toUTF8_swar, &convertCP1252toUTF8_swar, &convertUTF8toCP1252_swar,
+    &convertBYTEtoUTF8_swar, &convertUTF8toBYTE_swar, &convertBYTEtoUTF16_swar, &convertUTF16toBYTE_swar, &convertMUTF8toUTF8_scalar, &convertUTF8toMUTF8_scalar,
+    &countUTF8_scalar, &countUTF16_scalar,
+    &sizeUTF16fromUTF8_scalar, &sizeUTF8fromUTF16_scalar, &sizeFromUTF32_scalar, &findNull_swar, &countNullUTF8_swar,
+    &findLineBreakUTF8_scalar, &findLineCandidateUTF8_scalar, &findLineCandidateBYTE_scalar, &findLineCandidateUTF16_scalar, &findLineCandidateUTF32_scalar
+};
+
+#if defined(SUITE_UTF_SIMD_X86)
+
+static const kernel_table kKernelsSSE42 =
+{
+    &validSpanUTF8_sse, &convertUTF8toUTF16_sse, &convertUTF16toUTF8_sse, &convertCP1252toUTF8_sse, &convertUTF8toCP1252_sse,
+    &convertBYTEtoUTF8_sse, &convertUTF8toBYTE_sse, &convertBYTEtoUTF16_sse, &convertUTF16toBYTE_sse, &convertMUTF8toUTF8_sse, &convertUTF8toMUTF8_sse,
+    &countUTF8_sse, &countUTF16_sse,
+    &sizeUTF16fromUTF8_sse, &sizeUTF8fromUTF16_sse, &sizeFromUTF32_sse, &findNull_sse, &countNullUTF8_sse,
+    &findLineBreakUTF8_sse, &findLineCandidateUTF8_sse, &findLineCandidateBYTE_sse, &findLineCandidateUTF16_sse, &findLineCandidateUTF32_sse
+};
+
+static const kernel_table kKernelsAVX2 =
+{
+    &validSpanUTF8_avx2, &convertUTF8toUTF16_avx2, &convertUTF16toUTF8_avx2, &convertCP1252toUTF8_avx2, &convertUTF8toCP1252_avx2,
+    &convertBYTEtoUTF8_avx2, &convertUTF8toBYTE_avx2, &convertBYTEtoUTF16_avx2, &convertUTF16toBYTE_avx2, &convertMUTF8toUTF8_avx2, &convertUTF8toMUTF8_avx2,
+    &countUTF8_avx2, &countUTF16_avx2,
+    &sizeUTF16fromUTF8_avx2, &sizeUTF8fromUTF16_avx2, &sizeFromUTF32_avx2, &findNull_avx2, &countNullUTF8_avx2,
+    &findLineBreakUTF8_avx2, &findLineCandidateUTF8_avx2, &findLineCandidateBYTE_avx2, &findLineCandidateUTF16_avx2, &findLineCandidateUTF32_avx2
+};
+
+#if defined(SUITE_UTF_SIMD_X64)
+
+static const kernel_table kKernelsAVX512 =
+{   //  the CP1252, ISO-8859-1 and ASCII conversions, null terminator, line break and line terminator candidate scans are bound by memory bandwidth so they use the AVX2 kernels
+    &validSpanUTF8_avx512, &convertUTF8toUTF16_avx512, &convertUTF16toUTF8_avx512, &convertCP1252toUTF8_avx2, &convertUTF8toCP1252_avx2,
+    &convertBYTEtoUTF8_avx2, &convertUTF8toBYTE_avx2, &convertBYTEtoUTF16_avx2, &convertUTF16toBYTE_avx2, &convertMUTF8toUTF8_avx512, &convertUTF8toMUTF8_avx512,
+    &countUTF8_avx512, &countUTF16_avx512,
+    &sizeUTF16fromUTF8_avx512, &sizeUTF8fromUTF16_avx512, &sizeFromUTF32_avx512, &findNull_avx2, &countNullUTF8_avx2,
+    &findLineBreakUTF8_avx2, &findLineCandidateUTF8_avx2, &findLineCandidateBYTE_avx2, &findLineCandidateUTF16_avx2, &findLineCandidateUTF32_avx2
+};
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X64)
+
+#endif  //  #if defined(SUITE_UTF_SIMD_X86)
+
+static const kernel_table* const kTierKernels[static_cast<uint32_t>(SIMD_TIER::COUNT)] =
+{   //  tiers that are not available in the build are never selected
+    &kKernelsScalar,
+#if defined(SUITE_UTF_SIMD_X86)
+    &kKernelsSSE42,
+    &kKernelsAVX2,
+#if defined(SUITE_UTF_SIMD_X64)
+    &kKernelsAVX512
+#else
+    &kKernelsAVX2
+#endif
+#else
+    &kKernelsScalar,
+    &kKernelsScalar,
+    &kKernelsScalar
+#endif
+};
+
+static const char* const kTierNames[static_cast<uint32_t>(SIMD_TIER::COUNT)] = { "scalar", "sse42", "avx2", "avx512" };
+
+static SIMD_TIER detectBestTier() noexcept
+{
+    const uint32_t detected = features();
+#if defined(SUITE_UTF_SIMD_X64)
+    if ((detected & FEATURE_AVX512) != 0)
+    {
+        return SIMD_TIER::AVX512;
+    }
+#endif
+    if ((detected & FEATURE_AVX2) != 0)
+    {
+        return SIMD_TIER::AVX2;
+    }
+    if ((detected & FEATURE_SSE42) != 0)
+    {
+        return SIMD_TIER::SSE42;
+    }
+    return SIMD_TIER::Scalar;
+}
+
+static SIMD_TIER bestTier() noexcept
+{
+    static const SIMD_TIER best = detectBestTier();
+    return best;
+}
+
+static SIMD_TIER clampTier(const SIMD_TIER tier) noexcept
+{
+    const SIMD_TIER best = bestTier();
+    return ((static_cast<uint32_t>(tier) < static_cast<uint32_t>(best)) ? tier : best);
+}
+
+static SIMD_TIER initialTier() noexcept
+{   //  SUITE_UTF_SIMD_TIER=scalar|sse42|avx2|avx512 (case insensitive) forces the initial tier
+    char value[16] = {};
+#if defined(_MSC_VER)
+    size_t length = 0;
+    if ((getenv_s(&length, value, sizeof(value), "SUITE_UTF_SIMD_TIER") != 0) || (length == 0))
+    {
+        return bestTier();
+    }
+#else
+    const char* const variable = getenv("SUITE_UTF_SIMD_TIER");
+    if ((variable == nullptr) || (strlen(variable) >= sizeof(value)))
+    {
+        return bestTier();
+    }
+    strcpy(value, variable);
+#endif
+    for (uint32_t index = 0; value[index] != 0; ++index)
+    {
+        if ((value[index] >= 'A') && (value[index] <= 'Z'))
+        {
+            value[index] = static_cast<char>(value[index] + ('a' - 'A'));
+        }
+    }
+    for (uint32_t tier = 0; tier < static_cast<uint32_t>(SIMD_TIER::COUNT); ++tier)
+    {
+        if (strcmp(value, kTierNames[tier]) == 0)
+        {
+            return clampTier(static_cast<SIMD_TIER>(tier));
+        }
+    }
+    return bestTier();
+}
+
+static ::std::atomic<int32_t>& activeTier() noexcept
+{
+    static ::std::atomic<int32_t> active(static_cast<int32_t>(initialTier()));
+    return active;
+}
+
+static const kernel_table& kernels() noexcept
+{
+    return *kTierKernels[activeTier().load(::std::memory_order_relaxed)];
+}
+
+};  //  namespace internal
+
+// ==== CPU feature dispatch ====
+
+uint32_t getFeatures() noexcept
+{
+    return internal::features();
+}
+
+SIMD_TIER getBestTier() noexcept
+{
+    return internal::bestTier();
+}
+
+SIMD_TIER getTier() noexcept
+{
+    return static_cast<SIMD_TIER>(internal::activeTier().load(::std::memory_order_relaxed));
+}
+
+SIMD_TIER setTier(const SIMD_TIER tier) noexcept
+{
+    const SIMD_TIER active = internal::clampTier(tier);
+    internal::activeTier().store(static_cast<int32_t>(active), ::std::memory_order_relaxed);
+    return active;
+}
+
+const char* getTierName(const SIMD_TIER tier) noexcept
+{
+    return ((static_cast<uint32_t>(tier) < static_cast<uint32_t>(SIMD_TIER::COUNT)) ? internal::kTierNames[static_cast<uint32_t>(tier)] : "unknown");
+}
+
+// ==== bulk UTF8 validation kernel ====
+
+uint32_t validSpanUTF8(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 64)
+    {
+        return internal::kernels().validSpanUTF8(buffer, size, use_java);
+    }
+    return internal::validSpanUTF8_swar(buffer, size, 0, use_java);
+}
+
+// ==== bulk UTF8 to UTF16 conversion kernel ====
+
+uint32_t convertUTF8toUTF16(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertUTF8toUTF16(src, srcSize, dst, capacity, 0, written, big_endian, use_java);
+}
+
+// ==== bulk UTF16 to UTF8 conversion kernel ====
+
+uint32_t convertUTF16toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertUTF16toUTF8(src, srcSize, dst, capacity, 0, written, big_endian, use_java);
+}
+
+// ==== bulk CP1252 to UTF8 conversion kernel ====
+
+uint32_t convertCP1252toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertCP1252toUTF8(src, srcSize, dst, capacity, 0, written, strict, use_java);
+}
+
+// ==== bulk UTF8 to CP1252 conversion kernel ====
+
+uint32_t convertUTF8toCP1252(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool strict, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertUTF8toCP1252(src, srcSize, dst, capacity, 0, written, strict, use_java);
+}
+
+// ==== bulk ISO-8859-1 and ASCII conversion kernels ====
+
+uint32_t convertBYTEtoUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertBYTEtoUTF8(src, srcSize, dst, capacity, 0, written, use_ascii, use_java);
+}
+
+uint32_t convertUTF8toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_ascii, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertUTF8toBYTE(src, srcSize, dst, capacity, 0, written, use_ascii, use_java);
+}
+
+uint32_t convertBYTEtoUTF16(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertBYTEtoUTF16(src, srcSize, dst, capacity, 0, written, big_endian, use_ascii);
+}
+
+uint32_t convertUTF16toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool big_endian, const bool use_ascii) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertUTF16toBYTE(src, srcSize, dst, capacity, 0, written, big_endian, use_ascii);
+}
+
+// ==== bulk CESU8 and Java style UTF8 conversion kernels ====
+
+uint32_t convertMUTF8toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertMUTF8toUTF8(src, srcSize, dst, capacity, 0, written, use_cesu, use_java);
+}
+
+uint32_t convertUTF8toMUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, const bool use_cesu, const bool use_java) noexcept
+{
+    written = 0;
+    if (src == nullptr)
+    {
+        return 0;
+    }
+    const uint32_t capacity = (dst != nullptr) ? dstSize : 0;
+    return internal::kernels().convertUTF8toMUTF8(src, srcSize, dst, capacity, 0, written, use_cesu, use_java);
+}
+
+// ==== bulk code-point counting kernels ====
+
+uint32_t countUTF8(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 128)
+    {
+        return internal::kernels().countUTF8(buffer, size);
+    }
+    return internal::countUTF8_swar(buffer, size, 0, 0);
+}
+
+uint32_t countUTF16(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 128)
+    {
+        return internal::kernels().countUTF16(buffer, size, big_endian);
+    }
+    return ((size >> 1) - internal::pairsUTF16_swar(buffer, (size >> 1), 0, 0, big_endian));
+}
+
+// ==== bulk conversion size calculation kernels ====
+
+uint32_t sizeUTF16fromUTF8(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 128)
+    {
+        return internal::kernels().sizeUTF16fromUTF8(buffer, size);
+    }
+    return internal::sizeUTF16fromUTF8_swar(buffer, size, 0, 0);
+}
+
+uint32_t sizeUTF8fromUTF16(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 128)
+    {
+        return internal::kernels().sizeUTF8fromUTF16(buffer, size, big_endian, use_java);
+    }
+    return internal::sizeUTF8fromUTF16_swar(buffer, (size >> 1), 0, 0, big_endian, use_java);
+}
+
+uint32_t sizeUTF8fromUTF32(const uint8_t* const buffer, const uint32_t size, const bool big_endian, const bool use_java) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 128)
+    {
+        return internal::kernels().sizeFromUTF32(buffer, size, big_endian, use_java, false);
+    }
+    return internal::sizeFromUTF32_swar(buffer, (size >> 2), 0, 0, big_endian, use_java, false);
+}
+
+uint32_t sizeUTF16fromUTF32(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 128)
+    {
+        return internal::kernels().sizeFromUTF32(buffer, size, big_endian, false, true);
+    }
+    return internal::sizeFromUTF32_swar(buffer, (size >> 2), 0, 0, big_endian, false, true);
+}
+
+// ==== null terminator scanning kernels ====
+
+uint32_t findNullUTF8(const uint8_t* const buffer) noexcept
+{
+    return (buffer != nullptr) ? internal::kernels().findNull(buffer, 1) : 0;
+}
+
+uint32_t findNullUTF16(const uint8_t* const buffer) noexcept
+{   //  the block scans need a buffer aligned to the code-unit size
+    return (buffer != nullptr) ? (((reinterpret_cast<uintptr_t>(buffer) & 1) == 0) ? internal::kernels().findNull(buffer, 2) : internal::findNull_swar(buffer, 2)) : 0;
+}
+
+uint32_t findNullUTF32(const uint8_t* const buffer) noexcept
+{   //  the block scans need a buffer aligned to the code-unit size
+    return (buffer != nullptr) ? (((reinterpret_cast<uintptr_t>(buffer) & 3) == 0) ? internal::kernels().findNull(buffer, 4) : internal::findNull_swar(buffer, 4)) : 0;
+}
+
+uint32_t countNullUTF8(const uint8_t* const buffer, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    return internal::kernels().countNullUTF8(buffer, bytes);
+}
+
+// ==== line break scanning kernel ====
+
+uint32_t findLineBreakUTF8(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 64)
+    {
+        return internal::kernels().findLineBreakUTF8(buffer, size);
+    }
+    return internal::findLineBreakUTF8_swar(buffer, size, 0);
+}
+
+// ==== line terminator candidate scanning kernels ====
+
+uint32_t findLineCandidateUTF8(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 66)
+    {
+        return internal::kernels().findLineCandidateUTF8(buffer, size);
+    }
+    return internal::findLineCandidateUTF8_swar(buffer, size, 0);
+}
+
+uint32_t findLineCandidateBYTE(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 64)
+    {
+        return internal::kernels().findLineCandidateBYTE(buffer, size);
+    }
+    return internal::findLineCandidateBYTE_swar(buffer, size, 0);
+}
+
+uint32_t findLineCandidateUTF16(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 64)
+    {
+        return internal::kernels().findLineCandidateUTF16(buffer, size, big_endian);
+    }
+    return internal::findLineCandidateUTF16_swar(buffer, size, 0, big_endian);
+}
+
+uint32_t findLineCandidateUTF32(const uint8_t* const buffer, const uint32_t size, const bool big_endian) noexcept
+{
+    if (buffer == nullptr)
+    {
+        return 0;
+    }
+    if (size >= 64)
+    {
+        return internal::kernels().findLineCandidateUTF32(buffer, size, big_endian);
+    }
+    return internal::findLineCandidateUTF32_swar(buffer, size, 0, big_endian);
+}
+
+};  //  namespace simd
+
+};  //  namespace utf
+
+};  //  namespace unicode
@@ -51,6 +51,7 @@
 //          IUTF::getHandlerOther(UTF_OTHER_TYPE::CP1252).
 
 #include "utf_std.h"
+#include "utf_simd.h"
 #include "unicode_utilities.h"
 #include <string.h>
 
@@ -176,8 +177,8 @@ uint32_t lenCP1252(const unicode_t unicode) noexcept
 
 [[nodiscard]] bool setCP1252(uint8_t* const buffer, const uint32_t size, const unicode_t unicode, uint32_t& bytes) noexcept
 {
-    if ((buffer != nullptr) && (size >= 1) && (static_cast<uint32_t>(unicode) <= 0x000000ffu))
-    {
+    if ((buffer != nullptr) && (size >= 1))
+    {   //  the 27 code-points above 0xff mapped by CP1252 are encoded (as counted by lenCP1252())
         uint8_t cp1252;
         if (unicodeToCP1252(unicode, cp1252, CP1252Strictness::StrictUndefined))
         {
@@ -228,86 +229,17 @@ uint32_t lenCP1252(const unicode_t unicode) noexcept
     unicode = 0;
     if ((buffer != nullptr) && (size >= 1))
     {
-        uint8_t byte = buffer[0];
-        bytes = 1;
-        unicode = byte;
-        if (static_cast<uint8_t>(byte + 8) <= 0xc7u)
-        {   //  1 byte (7 bits: 0x00-0x7f) or unexpected continuation byte (0x80-0xbf) or illegal leading byte (0xf8-0xff)
-            if (byte <= 0x7fu)
-            {
-                return true;
-            }
-        }
-        else if (byte <= 0xdfu)
-        {   //  2 bytes (11 bits: 0xc0-0xdf)
-            if (size >= 2)
-            {
-                unicode_t value = (unicode & 0x1fu);
-                byte = buffer[1];
-                if ((byte & 0xc0u) == 0x80u)
-                {
-                    value = ((value << 6) + (byte & 0x3fu));
-                    if ((value >= 0x00000080u) || (use_java && (value == 0x00000000u)))
-                    {
-                        bytes = 2;
-                        unicode = value;
-                        return true;
-                    }
-                }
-            }
-        }
-        else if (byte <= 0xefu)
-        {   //  3 bytes (16 bits: 0xe0-0xef)
-            if (size >= 3)
-            {
-                unicode_t value = (unicode & 0x0fu);
-                byte = buffer[1];
-                if ((byte & 0xc0u) == 0x80u)
-                {
-                    value = ((value << 6) + (byte & 0x3fu));
-                    byte = buffer[2];
-                    if ((byte & 0xc0u) == 0x80u)
-                    {
-                        value = ((value << 6) + (byte & 0x3fu));
-                        if ((value >= 0x00000800u) && ((value & 0xfffff800u) != 0x0000d800u))
-                        {
-                            bytes = 3;
-                            unicode = value;
-                            return true;
-                        }
-                    }
-                }
-            }
+        if (internal::decodeDFA_UTF8(buffer, size, unicode, bytes))
+        {   //  well formed UTF8
+            return true;
         }
-        else
-        {   //  4 bytes (21 bits: 0xf0-0xf7)
-            if (size >= 4)
-            {
-                unicode_t value = (unicode & 0x07u);
-                byte = buffer[1];
-                if ((byte & 0xc0u) == 0x80u)
-                {
-                    value = ((value << 6) + (byte & 0x3fu));
-                    byte = buffer[2];
-                    if ((byte & 0xc0u) == 0x80u)
-                    {
-                        value = ((value << 6) + (byte & 0x3fu));
-                        byte = buffer[3];
-                        if ((byte & 0xc0u) == 0x80u)
-                        {
-                            value = ((value << 6) + (byte & 0x3fu));
-                            if ((value >= 0x00010000u) && (value <= 0x0010ffffu))
-                            {
-                                bytes = 4;
-                                unicode = value;
-                                return true;
-                            }
-                        }
-                    }
-                }
-            }
+        if (use_java && (buffer[0] == 0xc0u) && (size >= 2) && (buffer[1] == 0x80u))
+        {   //  Java style 2 byte encoding of NULL
+            bytes = 2;
+            return true;
         }
-        unicode |= 0x80000000u;
+        bytes = 1;
+        unicode = (0x80000000u + buffer[0]);
     }
     return false;
 }
@@ -556,187 +488,57 @@ uint32_t lenCP1252(const unicode_t unicode) noexcept
 
 uint32_t strsizeUTF8(const uint8_t* const buffer) noexcept
 {
-    uint32_t index = 0;
-    if (buffer != nullptr)
-    {
-        while (buffer[index])
-        {
-            ++index;
-        }
-    }
-    return index;
+    return simd::findNullUTF8(buffer);
 }
 
 uint32_t strsizeUTF16(const uint8_t* const buffer) noexcept
 {
-    uint32_t index = 0;
-    if (buffer != nullptr)
-    {
-        while (buffer[index + 0] || buffer[index + 1])
-        {
-            index += 2;
-        }
-    }
-    return index;
+    return simd::findNullUTF16(buffer);
 }
 
 uint32_t strsizeUTF32(const uint8_t* const buffer) noexcept
 {
-    uint32_t index = 0;
-    if (buffer != nullptr)
-    {
-        while (buffer[index + 0] || buffer[index + 1] || buffer[index + 2] || buffer[index + 3])
-        {
-            index += 4;
-        }
-    }
-    return index;
+    return simd::findNullUTF32(buffer);
 }
 
 // ==== quick UTF null (0) terminated code-point counting functions ====
 
 uint32_t strlenUTF8(const uint8_t* const buffer) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        uint8_t byte = 0;
-        for (uint32_t index = 0; (byte = buffer[index]) != 0; ++index)
-        {
-            if ((byte & 0xc0u) != 0x80u)
-            {
-                ++count;
-            }
-        }
-    }
-    return count;
+    uint32_t bytes = 0;
+    return simd::countNullUTF8(buffer, bytes);
 }
 
 uint32_t strlenUTF16le(const uint8_t* const buffer) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        uint16_t value = 0;
-        for (uint32_t index = 0; (value = ((static_cast<uint16_t>(buffer[index + 1]) << 8) + buffer[index + 0])) != 0; index += 2)
-        {
-            if ((value & 0xfc00u) == 0xd800u)
-            {
-                value = ((static_cast<uint16_t>(buffer[index + 3]) << 8) + buffer[index + 2]);
-                if ((value & 0xfc00u) == 0xdc00u)
-                {
-                    index += 2;
-                }
-            }
-            ++count;
-        }
-    }
-    return count;
+    return simd::countUTF16(buffer, simd::findNullUTF16(buffer), false);
 }
 
 uint32_t strlenUTF16be(const uint8_t* const buffer) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        uint16_t value = 0;
-        for (uint32_t index = 0; (value = ((static_cast<uint16_t>(buffer[index + 0]) << 8) + buffer[index + 1])) != 0; index += 2)
-        {
-            if ((value & 0xfc00u) == 0xd800u)
-            {
-                value = ((static_cast<uint16_t>(buffer[index + 2]) << 8) + buffer[index + 3]);
-                if ((value & 0xfc00u) == 0xdc00u)
-                {
-                    index += 2;
-                }
-            }
-            ++count;
-        }
-    }
-    return count;
+    return simd::countUTF16(buffer, simd::findNullUTF16(buffer), true);
 }
 
 uint32_t strlenUTF32(const uint8_t* const buffer) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        for (uint32_t index = 0; buffer[index + 0] || buffer[index + 1] || buffer[index + 2] || buffer[index + 3]; index += 4)
-        {
-            ++count;
-        }
-    }
-    return count;
+    return (simd::findNullUTF32(buffer) >> 2);
 }
 
 // ==== quick UTF fixed buffer size code-point counting functions ====
 
 uint32_t strlenUTF8(const uint8_t* const buffer, const uint32_t size) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t index = 0;
-        for (uint32_t limit = size; limit; --limit)
-        {
-            if ((buffer[index] & 0xc0u) != 0x80u)
-            {
-                ++count;
-            }
-            ++index;
-        }
-    }
-    return count;
+    return simd::countUTF8(buffer, size);
 }
 
 uint32_t strlenUTF16le(const uint8_t* const buffer, const uint32_t size) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t index = 0;
-        for (uint32_t limit = size; limit >= 2; limit -= 2)
-        {
-            uint16_t value = ((static_cast<uint16_t>(buffer[index + 1]) << 8) + buffer[index + 0]);
-            if (((value & 0xfc00u) == 0xd800u) && (limit >= 4))
-            {
-                value = ((static_cast<uint16_t>(buffer[index + 3]) << 8) + buffer[index + 2]);
-                if ((value & 0xfc00u) == 0xdc00u)
-                {
-                    index += 2;
-                    limit -= 2;
-                }
-            }
-            index += 2;
-            ++count;
-        }
-    }
-    return count;
+    return simd::countUTF16(buffer, size, false);
 }
 
 uint32_t strlenUTF16be(const uint8_t* const buffer, const uint32_t size) noexcept
 {
-    uint32_t count = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t index = 0;
-        for (uint32_t limit = size; limit >= 2; limit -= 2)
-        {
-            uint16_t value = ((static_cast<uint16_t>(buffer[index + 0]) << 8) + buffer[index + 1]);
-            if (((value & 0xfc00u) == 0xd800u) && (limit >= 4))
-            {
-                value = ((static_cast<uint16_t>(buffer[index + 2]) << 8) + buffer[index + 3]);
-                if ((value & 0xfc00u) == 0xdc00u)
-                {
-                    index += 2;
-                    limit -= 2;
-                }
-            }
-            index += 2;
-            ++count;
-        }
-    }
-    return count;
+    return simd::countUTF16(buffer, size, true);
 }
 
 // ==== quick UTF null (0) terminated format conversion size calculation functions (excludes the size of the null terminator) ====
@@ -744,98 +546,38 @@ uint32_t strlenUTF16be(const uint8_t* const buffer, const uint32_t size) noexcep
 
 uint32_t strsizeUTF8fromUTF16le(const uint8_t* const buffer) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t bytes = 0;
-        unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
-        {
-            if (getUTF16le(&buffer[index], 4, unicode, bytes))
-            {
-                if (unicode)
-                {
-                    needs += lenUTF8(unicode, false);
-                }
-            }
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF16(buffer, strsizeUTF16(buffer), false);
 }
 
 uint32_t strsizeUTF8fromUTF16be(const uint8_t* const buffer) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t bytes = 0;
-        unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
-        {
-            if (getUTF16be(&buffer[index], 4, unicode, bytes))
-            {
-                if (unicode)
-                {
-                    needs += lenUTF8(unicode, false);
-                }
-            }
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF16(buffer, strsizeUTF16(buffer), true);
 }
 
 uint32_t strsizeUTF8fromUTF32le(const uint8_t* const buffer) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t bytes = 0;
-        unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
-        {
-            if (getUTF32le(&buffer[index], 4, unicode, bytes))
-            {
-                if (unicode)
-                {
-                    needs += lenUTF8(unicode, false);
-                }
-            }
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF32(buffer, strsizeUTF32(buffer), false);
 }
 
 uint32_t strsizeUTF8fromUTF32be(const uint8_t* const buffer) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t bytes = 0;
-        unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
-        {
-            if (getUTF32be(&buffer[index], 4, unicode, bytes))
-            {
-                if (unicode)
-                {
-                    needs += lenUTF8(unicode, false);
-                }
-            }
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF32(buffer, strsizeUTF32(buffer), true);
 }
 
 uint32_t strsizeUTF16fromUTF8(const uint8_t* const buffer, const bool use_java) noexcept
 {
     uint32_t needs = 0;
     if (buffer != nullptr)
-    {
+    {   //  the valid leading span is sized in bulk and the remainder one code-point at a time (getUTF8() is given the bytes
+        //  up to and including the terminator, it may read the whole of the size it is given)
+        const uint32_t size = strsizeUTF8(buffer);
+        const uint32_t span = simd::validSpanUTF8(buffer, size, use_java);
+        needs = simd::sizeUTF16fromUTF8(buffer, span);
         uint32_t bytes = 0;
         unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
+        for (uint32_t index = span; unicode; index += bytes)
         {
-            if (getUTF8(&buffer[index], 4, unicode, bytes, use_java))
+            if (getUTF8(&buffer[index], (size + 1 - index), unicode, bytes, use_java))
             {
                 if (unicode)
                 {
@@ -854,44 +596,12 @@ uint32_t strsizeUTF16fromUTF8(const uint8_t* const buffer, const bool use_java)
 
 uint32_t strsizeUTF16fromUTF32le(const uint8_t* const buffer) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t bytes = 0;
-        unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
-        {
-            if (getUTF32le(&buffer[index], 4, unicode, bytes))
-            {
-                if (unicode)
-                {
-                    needs += lenUTF16(unicode);
-                }
-            }
-        }
-    }
-    return needs;
+    return simd::sizeUTF16fromUTF32(buffer, strsizeUTF32(buffer), false);
 }
 
 uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t bytes = 0;
-        unicode_t unicode = -1;
-        for (uint32_t index = 0; unicode; index += bytes)
-        {
-            if (getUTF32be(&buffer[index], 4, unicode, bytes))
-            {
-                if (unicode)
-                {
-                    needs += lenUTF16(unicode);
-                }
-            }
-        }
-    }
-    return needs;
+    return simd::sizeUTF16fromUTF32(buffer, strsizeUTF32(buffer), true);
 }
 
 // ==== quick UTF fixed buffer size format conversion size calculation functions ====
@@ -899,89 +609,39 @@ uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer) noexcept
 
 uint32_t strsizeUTF8fromUTF16le(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t limit = size;
-        uint32_t bytes = 0;
-        unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
-        {
-            if (getUTF16le(&buffer[index], limit, unicode, bytes))
-            {
-                needs += lenUTF8(unicode, use_java);
-            }
-            else if (unicode == 0)
-            {
-                break;
-            }
-            limit -= bytes;
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF16(buffer, size, false, use_java);
 }
 
 uint32_t strsizeUTF8fromUTF16be(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t limit = size;
-        uint32_t bytes = 0;
-        unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
-        {
-            if (getUTF16be(&buffer[index], limit, unicode, bytes))
-            {
-                needs += lenUTF8(unicode, use_java);
-            }
-            else if (unicode == 0)
-            {
-                break;
-            }
-            limit -= bytes;
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF16(buffer, size, true, use_java);
 }
 
 uint32_t strsizeUTF8fromUTF32le(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
-    {
-        uint32_t limit = size;
-        uint32_t bytes = 0;
-        unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
-        {
-            if (getUTF32le(&buffer[index], limit, unicode, bytes))
-            {
-                needs += lenUTF8(unicode, use_java);
-            }
-            else if (unicode == 0)
-            {
-                break;
-            }
-            limit -= bytes;
-        }
-    }
-    return needs;
+    return simd::sizeUTF8fromUTF32(buffer, size, false, use_java);
 }
 
 uint32_t strsizeUTF8fromUTF32be(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+{
+    return simd::sizeUTF8fromUTF32(buffer, size, true, use_java);
+}
+
+uint32_t strsizeUTF16fromUTF8(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
 {
     uint32_t needs = 0;
     if (buffer != nullptr)
-    {
-        uint32_t limit = size;
+    {   //  the valid leading span is sized in bulk and the remainder one code-point at a time
+        const uint32_t span = simd::validSpanUTF8(buffer, size, use_java);
+        needs = simd::sizeUTF16fromUTF8(buffer, span);
+        uint32_t limit = (size - span);
         uint32_t bytes = 0;
         unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
+        for (uint32_t index = span; index < size; index += bytes)
         {
-            if (getUTF32be(&buffer[index], limit, unicode, bytes))
+            if (getUTF8(&buffer[index], limit, unicode, bytes, use_java))
             {
-                needs += lenUTF8(unicode, use_java);
+                needs += lenUTF16(unicode);
             }
             else if (unicode == 0)
             {
@@ -993,76 +653,501 @@ uint32_t strsizeUTF8fromUTF32be(const uint8_t* const buffer, const uint32_t size
     return needs;
 }
 
-uint32_t strsizeUTF16fromUTF8(const uint8_t* const buffer, const uint32_t size, const bool use_java) noexcept
+uint32_t strsizeUTF16fromUTF32le(const uint8_t* const buffer, const uint32_t size) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
+    return simd::sizeUTF16fromUTF32(buffer, size, false);
+}
+
+uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer, const uint32_t size) noexcept
+{
+    return simd::sizeUTF16fromUTF32(buffer, size, true);
+}
+
+// ==== quick UTF fixed buffer size bulk validation functions ====
+
+[[nodiscard]] bool validateUTF8(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes, const bool use_java) noexcept
+{
+    bytes = 0;
+    if (buffer != nullptr)
     {
-        uint32_t limit = size;
-        uint32_t bytes = 0;
-        unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
+        bytes = simd::validSpanUTF8(buffer, size, use_java);
+        return (bytes == size);
+    }
+    return false;
+}
+
+// ==== quick UTF fixed buffer size bulk format conversion functions ====
+
+[[nodiscard]] bool convertUTF8toUTF16le(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF8toUTF16(src, srcSize, dst, dstSize, written, false, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF8toUTF16be(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF8toUTF16(src, srcSize, dst, dstSize, written, true, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF16leToUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF16toUTF8(src, srcSize, dst, dstSize, written, false, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF16beToUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF16toUTF8(src, srcSize, dst, dstSize, written, true, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertCP1252toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool strict, const bool use_java) noexcept
+{
+    consumed = simd::convertCP1252toUTF8(src, srcSize, dst, dstSize, written, strict, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF8toCP1252(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool strict, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF8toCP1252(src, srcSize, dst, dstSize, written, strict, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertBYTEtoUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii, const bool use_java) noexcept
+{
+    consumed = simd::convertBYTEtoUTF8(src, srcSize, dst, dstSize, written, use_ascii, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF8toBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF8toBYTE(src, srcSize, dst, dstSize, written, use_ascii, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertBYTEtoUTF16le(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii) noexcept
+{
+    consumed = simd::convertBYTEtoUTF16(src, srcSize, dst, dstSize, written, false, use_ascii);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertBYTEtoUTF16be(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii) noexcept
+{
+    consumed = simd::convertBYTEtoUTF16(src, srcSize, dst, dstSize, written, true, use_ascii);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF16leToBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii) noexcept
+{
+    consumed = simd::convertUTF16toBYTE(src, srcSize, dst, dstSize, written, false, use_ascii);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF16beToBYTE(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_ascii) noexcept
+{
+    consumed = simd::convertUTF16toBYTE(src, srcSize, dst, dstSize, written, true, use_ascii);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertMUTF8toUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_cesu, const bool use_java) noexcept
+{
+    consumed = simd::convertMUTF8toUTF8(src, srcSize, dst, dstSize, written, use_cesu, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+[[nodiscard]] bool convertUTF8toMUTF8(const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written, uint32_t& consumed, const bool use_cesu, const bool use_java) noexcept
+{
+    consumed = simd::convertUTF8toMUTF8(src, srcSize, dst, dstSize, written, use_cesu, use_java);
+    return (src != nullptr) && (consumed == srcSize);
+}
+
+// ==== quick UTF fixed buffer size bulk decode and encode functions ====
+
+[[nodiscard]] bool decodeBlockBYTE(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, const bool use_ascii) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        uint32_t extra = 0;
+        if (!getBYTE(&buffer[bytes], (size - bytes), unicodes[count], extra, use_ascii))
         {
-            if (getUTF8(&buffer[index], limit, unicode, bytes, use_java))
-            {
-                needs += lenUTF16(unicode);
-            }
-            else if (unicode == 0)
-            {
-                break;
-            }
-            limit -= bytes;
+            return false;
         }
+        ++count;
+        bytes += extra;
     }
-    return needs;
+    return true;
 }
 
-uint32_t strsizeUTF16fromUTF32le(const uint8_t* const buffer, const uint32_t size) noexcept
+[[nodiscard]] bool decodeBlockCP1252(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
     {
-        uint32_t limit = size;
-        uint32_t bytes = 0;
-        unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        if (buffer[bytes] <= 0x7fu)
+        {   //  1 byte (ASCII range is unchanged by code-page 1252)
+            unicodes[count] = static_cast<unicode_t>(buffer[bytes]);
+            ++count;
+            ++bytes;
+            continue;
+        }
+        uint32_t extra = 0;
+        if (!getCP1252(&buffer[bytes], (size - bytes), unicodes[count], extra))
         {
-            if (getUTF32le(&buffer[index], limit, unicode, bytes))
-            {
-                needs += lenUTF16(unicode);
-            }
-            else if (unicode == 0)
-            {
-                break;
-            }
-            limit -= bytes;
+            return false;
         }
+        ++count;
+        bytes += extra;
     }
-    return needs;
+    return true;
 }
 
-uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer, const uint32_t size) noexcept
+[[nodiscard]] bool decodeBlockUTF8(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, const bool use_java) noexcept
 {
-    uint32_t needs = 0;
-    if (buffer != nullptr)
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
     {
-        uint32_t limit = size;
-        uint32_t bytes = 0;
-        unicode_t unicode = 0;
-        for (uint32_t index = 0; index < size; index += bytes)
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        if (buffer[bytes] <= 0x7fu)
+        {   //  1 byte (7 bits: 0x00-0x7f)
+            unicodes[count] = static_cast<unicode_t>(buffer[bytes]);
+            ++count;
+            ++bytes;
+            continue;
+        }
+        uint32_t extra = 0;
+        if (!getUTF8(&buffer[bytes], (size - bytes), unicodes[count], extra, use_java))
         {
-            if (getUTF32be(&buffer[index], limit, unicode, bytes))
-            {
-                needs += lenUTF16(unicode);
-            }
-            else if (unicode == 0)
-            {
-                break;
-            }
-            limit -= bytes;
+            return false;
         }
+        ++count;
+        bytes += extra;
     }
-    return needs;
+    return true;
+}
+
+[[nodiscard]] bool decodeBlockUTF16le(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        uint32_t extra = 0;
+        if (!getUTF16le(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool decodeBlockUTF16be(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        uint32_t extra = 0;
+        if (!getUTF16be(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool decodeBlockUTF32le(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        uint32_t extra = 0;
+        if (!getUTF32le(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool decodeBlockUTF32be(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        uint32_t extra = 0;
+        if (!getUTF32be(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockBYTE(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_ascii) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        uint32_t extra = 0;
+        if (!setBYTE(&buffer[bytes], (size - bytes), unicodes[count], extra, use_ascii))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockCP1252(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        if (((static_cast<uint32_t>(unicodes[count]) - 1u) < 0x0000007fu) && (bytes < size))
+        {   //  1 byte (ASCII range excluding NULL is unchanged by code-page 1252)
+            buffer[bytes] = static_cast<uint8_t>(unicodes[count]);
+            ++count;
+            ++bytes;
+            continue;
+        }
+        uint32_t extra = 0;
+        if (!setCP1252(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockUTF8(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_java) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        if (((static_cast<uint32_t>(unicodes[count]) - 1u) < 0x0000007fu) && (bytes < size))
+        {   //  1 byte (7 bits: 0x01-0x7f, NULL may be 2 bytes for Java modified UTF8)
+            buffer[bytes] = static_cast<uint8_t>(unicodes[count]);
+            ++count;
+            ++bytes;
+            continue;
+        }
+        uint32_t extra = 0;
+        if (!setUTF8(&buffer[bytes], (size - bytes), unicodes[count], extra, use_java))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockUTF16le(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        uint32_t extra = 0;
+        if (!setUTF16le(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockUTF16be(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        uint32_t extra = 0;
+        if (!setUTF16be(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockUTF32le(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        uint32_t extra = 0;
+        if (!setUTF32le(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool encodeBlockUTF32be(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        uint32_t extra = 0;
+        if (!setUTF32be(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+// ==== encoded unicode code-point handling functions abstraction interface default bulk functions ====
+
+[[nodiscard]] bool IUTF::validate(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes) const noexcept
+{   //  attempts to read the entire buffer and returns false on any read fails
+    bytes = 0;
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+    while (bytes < size)
+    {
+        unicode_t unicode;
+        uint32_t extra = 0;
+        if (!get(&buffer[bytes], (size - bytes), unicode, extra))
+        {
+            return false;
+        }
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool IUTF::decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept
+{   //  reads code-points until the buffer or the output is exhausted and returns false on any read fails
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        return false;
+    }
+    while ((bytes < size) && (count < capacity))
+    {
+        uint32_t extra = 0;
+        if (!get(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
+}
+
+[[nodiscard]] bool IUTF::encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept
+{   //  writes code-points until the input is exhausted and returns false on any write fails
+    count = 0;
+    bytes = 0;
+    if ((buffer == nullptr) || ((unicodes == nullptr) && (length != 0)))
+    {
+        return false;
+    }
+    while (count < length)
+    {
+        uint32_t extra = 0;
+        if (!set(&buffer[bytes], (size - bytes), unicodes[count], extra))
+        {
+            return false;
+        }
+        ++count;
+        bytes += extra;
+    }
+    return true;
 }
 
 // ==== encoded unicode code-point handling functions abstraction interface utility functions ====
@@ -1141,21 +1226,64 @@ uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer, const uint32_t siz
 }
 
 [[nodiscard]] bool IUTF::validate(const utf_text& text) const noexcept
-{   //  attempts to read the entire buffer and returns false on any read fails
-    if ((text.buffer == nullptr) || (text.offset < text.length))
+{   //  validates the remainder of the buffer from the current offset
+    if ((text.buffer == nullptr) || (text.offset > text.length))
     {
         return false;
     }
-    utf_text scan = text;
-    while (scan.offset < scan.length)
+    uint32_t bytes = 0;
+    return validate(&text.buffer[text.offset], (text.length - text.offset), bytes);
+}
+
+[[nodiscard]] bool IUTF::decodeBlock(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept
+{
+    if (text.length >= text.offset)
     {
-        unicode_t unicode;
-        if (!read(scan, unicode))
-        {
-            return false;
-        }
+        return decodeBlock(&text.buffer[text.offset], (text.length - text.offset), unicodes, capacity, count, bytes);
+    }
+    count = 0;
+    bytes = 0;
+    return false;
+}
+
+[[nodiscard]] bool IUTF::encodeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept
+{
+    if (text.length >= text.offset)
+    {
+        return encodeBlock(&text.buffer[text.offset], (text.length - text.offset), unicodes, length, count, bytes);
+    }
+    count = 0;
+    bytes = 0;
+    return false;
+}
+
+[[nodiscard]] bool IUTF::readBlock(utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count) const noexcept
+{
+    uint32_t bytes = 0;
+    bool success = decodeBlock(text, unicodes, capacity, count, bytes);
+    text.offset += bytes;
+    return success;
+}
+
+[[nodiscard]] bool IUTF::writeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count) const noexcept
+{
+    uint32_t bytes = 0;
+    bool success = encodeBlock(text, unicodes, length, count, bytes);
+    text.offset += bytes;
+    return success;
+}
+
+static uint32_t lineSpan(const UTF_TYPE utfType, const uint8_t* const buffer, const uint32_t size) noexcept
+{   //  returns the byte length of the leading code-points that are not line terminators and decode successfully
+    switch (utfType)
+    {
+        case(UTF_TYPE::UTF8):       return simd::validSpanUTF8(buffer, simd::findLineCandidateUTF8(buffer, size));
+        case(UTF_TYPE::UTF16le):    return simd::findLineCandidateUTF16(buffer, size, false);
+        case(UTF_TYPE::UTF16be):    return simd::findLineCandidateUTF16(buffer, size, true);
+        case(UTF_TYPE::UTF32le):    return simd::findLineCandidateUTF32(buffer, size, false);
+        case(UTF_TYPE::UTF32be):    return simd::findLineCandidateUTF32(buffer, size, true);
+        default:                    return simd::findLineCandidateBYTE(buffer, size);
     }
-    return true;
 }
 
 [[nodiscard]] bool IUTF::getNLF(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept
@@ -1218,14 +1346,16 @@ uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer, const uint32_t siz
     bool success = (text.buffer != nullptr) && (text.offset <= text.length);
     if (success)
     {
+        const UTF_TYPE type = utfType();
         utf_text scan;
         scan.length = (text.length - text.offset);
         scan.offset = 0;
         scan.buffer = &text.buffer[text.offset];
         unicode_t unicode;
         success = false;
+        scan.offset = lineSpan(type, scan.buffer, scan.length);
         while (getNLF(scan, unicode, bytes))
-        {
+        {   //  only the candidates found by the bulk kernels are decoded
             if ((unicode == 0x000au) || (unicode == 0x0000u))
             {
                 bytes += scan.offset;
@@ -1236,6 +1366,7 @@ uint32_t strsizeUTF16fromUTF32be(const uint8_t* const buffer, const uint32_t siz
                 break;
             }
             scan.offset += bytes;
+            scan.offset += lineSpan(type, &scan.buffer[scan.offset], (scan.length - scan.offset));
         };
     }
     return success;
@@ -1265,6 +1396,9 @@ class CUTF8 : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return strsizeUTF8(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return strlenUTF8(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { return strlenUTF8(buffer, size); }
+    virtual [[nodiscard]] bool  validate(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes) const noexcept { return validateUTF8(buffer, size, bytes, false); }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockUTF8(buffer, size, unicodes, capacity, count, bytes, false); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockUTF8(buffer, size, unicodes, length, count, bytes, false); }
 };
 
 class CJUTF8 : public IUTF
@@ -1281,6 +1415,9 @@ class CJUTF8 : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return strsizeUTF8(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return strlenUTF8(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { return strlenUTF8(buffer, size); }
+    virtual [[nodiscard]] bool  validate(const uint8_t* const buffer, const uint32_t size, uint32_t& bytes) const noexcept { return validateUTF8(buffer, size, bytes, true); }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockUTF8(buffer, size, unicodes, capacity, count, bytes, true); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockUTF8(buffer, size, unicodes, length, count, bytes, true); }
 };
 
 class CUTF16le : public IUTF
@@ -1297,6 +1434,8 @@ class CUTF16le : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return strsizeUTF16(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return strlenUTF16le(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { return strlenUTF16le(buffer, size); }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockUTF16le(buffer, size, unicodes, capacity, count, bytes); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockUTF16le(buffer, size, unicodes, length, count, bytes); }
 };
 
 class CUTF16be : public IUTF
@@ -1313,6 +1452,8 @@ class CUTF16be : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return strsizeUTF16(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return strlenUTF16be(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { return strlenUTF16be(buffer, size); }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockUTF16be(buffer, size, unicodes, capacity, count, bytes); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockUTF16be(buffer, size, unicodes, length, count, bytes); }
 };
 
 class CUTF32le : public IUTF
@@ -1329,6 +1470,8 @@ class CUTF32le : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return strsizeUTF32(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return strlenUTF32(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { (void)(buffer); return size >> 2; }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockUTF32le(buffer, size, unicodes, capacity, count, bytes); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockUTF32le(buffer, size, unicodes, length, count, bytes); }
 };
 
 class CUTF32be : public IUTF
@@ -1345,6 +1488,8 @@ class CUTF32be : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return strsizeUTF32(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return strlenUTF32(buffer); }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { (void)(buffer); return size >> 2; }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockUTF32be(buffer, size, unicodes, capacity, count, bytes); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockUTF32be(buffer, size, unicodes, length, count, bytes); }
 };
 
 class CBYTE : public IUTF
@@ -1361,6 +1506,8 @@ class CBYTE : public IUTF
     virtual uint32_t            strsize(const uint8_t* const buffer) const noexcept { return buffer ? static_cast<uint32_t>(::strlen(reinterpret_cast<const char* const>(buffer))) : 0; }
     virtual uint32_t            strlen(const uint8_t* const buffer) const noexcept { return buffer ? static_cast<uint32_t>(::strlen(reinterpret_cast<const char* const>(buffer))) : 0; }
     virtual uint32_t            strlen(const uint8_t* const buffer, const uint32_t size) const noexcept { (void)(buffer); return size; }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockBYTE(buffer, size, unicodes, capacity, count, bytes, false); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockBYTE(buffer, size, unicodes, length, count, bytes, false); }
 };
 
 class CASCII : public CBYTE
@@ -1368,6 +1515,8 @@ class CASCII : public CBYTE
     virtual uint32_t            len(const unicode_t unicode) const noexcept { return lenBYTE(unicode, true); }
     virtual [[nodiscard]] bool  get(const uint8_t* const buffer, const uint32_t size, unicode_t& unicode, uint32_t& bytes) const noexcept { return getBYTE(buffer, size, unicode, bytes, true); }
     virtual [[nodiscard]] bool  set(uint8_t* const buffer, const uint32_t size, const unicode_t unicode, uint32_t& bytes) const noexcept { return setBYTE(buffer, size, unicode, bytes, true); }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return decodeBlockBYTE(buffer, size, unicodes, capacity, count, bytes, true); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return encodeBlockBYTE(buffer, size, unicodes, length, count, bytes, true); }
 };
 
 class CCP1252 : public CBYTE
@@ -1375,6 +1524,8 @@ class CCP1252 : public CBYTE
     virtual uint32_t            len(const unicode_t unicode) const noexcept { return std::lenCP1252(unicode); }
     virtual [[nodiscard]] bool  get(const uint8_t* const buffer, const uint32_t size, unicode_t& unicode, uint32_t& bytes) const noexcept { return std::getCP1252(buffer, size, unicode, bytes); }
     virtual [[nodiscard]] bool  set(uint8_t* const buffer, const uint32_t size, const unicode_t unicode, uint32_t& bytes) const noexcept { return std::setCP1252(buffer, size, unicode, bytes); }
+    virtual [[nodiscard]] bool  decodeBlock(const uint8_t* const buffer, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes) const noexcept { return std::decodeBlockCP1252(buffer, size, unicodes, capacity, count, bytes); }
+    virtual [[nodiscard]] bool  encodeBlock(uint8_t* const buffer, const uint32_t size, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return std::encodeBlockCP1252(buffer, size, unicodes, length, count, bytes); }
 };
 
 // ==== quick UTF abstracted handler request functions ====
@@ -80,6 +80,11 @@
 
 #include "utf_toolkit.h"
 #include "unicode_utilities.h"
+#include "utf_helpers.h"
+#include "utf_simd.h"
+#include <string.h>
+#include <atomic>
+#include <thread>
 
 namespace unicode
 {
@@ -93,99 +98,94 @@ namespace toolkit
 namespace internal
 {
 
-/// internal low level UTF8 fetch function
-/// 
-///     This is a helper function for the decodeUTF8() function and only returns a subset of the error codes.
-/// 
-///     The coalesce flag controls the bytes count set when handling sequences with an illegal or invalid lead byte:
-/// 
-///         coalesce == false   :   bytes = 1
-///         coalesce == true    :   bytes = offset to the next valid lead byte or buffer end (limit)
-/// 
-[[nodiscard]] cp_errors fetchUTF8(const uint8_t* const buffer, const uint32_t size, unicode_t& unicode, uint32_t& bytes, const bool coalesce) noexcept
+// ==== kernel and block loop function types for the runtime flag dispatch tables ====
+
+using encodeFunction = cp_errors (*)(utf_text& text, const unicode_t unicode, uint32_t& bytes) noexcept;
+using decodeFunction = cp_errors (*)(const utf_text& text, unicode_t& unicode, uint32_t& bytes) noexcept;
+using decodeBlockFunction = cp_errors (*)(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed) noexcept;
+using encodeBlockFunction = cp_errors (*)(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept;
+
+// ==== block decoding and encoding loops (the 'ascii' flag enables copying 0x01-0x7f bytes directly) ====
+
+template<decodeFunction decode, bool ascii>
+[[nodiscard]] cp_errors decodeBlock(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed) noexcept
 {
-    cp_errors errors;
+    count = 0;
     bytes = 0;
-    unicode = 0;
-    if (size < 1)
+    failed = 0;
+    cp_errors errors = get_errors(text);
+    if ((unicodes == nullptr) && (capacity != 0))
     {
-        errors = cp_errors::bits::ReadExhausted;
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
     }
-    else
+    if (errors.no_error())
     {
-        uint8_t byte = buffer[0];
-        unicode = static_cast<unicode_t>(byte);
-        if (static_cast<uint8_t>(byte + 2) <= 0xc1u)
-        {   //  1 byte (7 bits: 0x00-0x7f) or unexpected continuation byte (0x80-0xbf) or illegal leading byte (0xfe-0xff)
-            bytes = 1;
-            if (byte > 0x7fu)
-            {
-                errors |= ((cp_errors::bits::Failed | cp_errors::bits::NotDecodable) | ((byte >= 0xfeu) ? cp_errors::bits::DisallowedByte : cp_errors::bits::UnexpectedByte));
-                if (coalesce)
-                {
-                    uint32_t count = size;
-                    for (uint32_t index = 1; index < count; ++index)
-                    {
-                        byte = buffer[index];
-                        if (((byte & 0xc0u) != 0x80u) && (byte < 0xfeu))
-                        {
-                            count = index;
-                            break;
-                        }
-                    }
-                    bytes = count;
-                }
-            }
-        }
-        else
+        utf_text scan = text;
+        bool failing = false;
+        while ((scan.offset < scan.length) && (count < capacity))
         {
-            uint32_t count = 0;
-            if (byte <= 0xefu)
-            {   //  2 bytes (11 bits: 0xc0-0xdf) or 3 bytes (16 bits: 0xe0-0xef)
-                count = static_cast<uint32_t>((byte >> 5) & 3);
+            if (ascii && (static_cast<uint8_t>(scan.buffer[scan.offset] - 1) < 0x7fu))
+            {   //  1 byte (7 bits: 0x01-0x7f) decodes to itself without warnings
+                unicodes[count] = static_cast<unicode_t>(scan.buffer[scan.offset]);
+                ++count;
+                ++scan.offset;
+                continue;
             }
-            else if (byte <= 0xf7u)
-            {   //  4 bytes (21 bits: 0xf0-0xf7)
-                count = 4;
+            unicode_t unicode = 0;
+            uint32_t extra = 0;
+            cp_errors check = decode(scan, unicode, extra);
+            if (check.error() && !failing)
+            {   //  first failing sequence (keep its byte index)
+                failing = true;
+                failed = (scan.offset - text.offset);
             }
             else
-            {   //  extended encoding: 5 bytes (26 bits: 0xf8-0xfb) or 6 bytes (31 bits: 0xfc-0xfd)
-                count = static_cast<uint32_t>(((byte >> 2) & 7) - 1);
-                errors |= cp_errors::bits::ExtendedUTF8;
-            }
-            if (count > size)
-            {   //  truncated continuation
-                count = size;
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable | cp_errors::bits::ReadTruncated);
-            }
-            unicode_t value = (static_cast<unicode_t>(byte) & ((unicode_t(1) << (7 - count)) - 1));
-            for (uint32_t index = 1; index < count; ++index)
             {
-                byte = buffer[index];
-                if ((byte & 0xc0u) != 0x80u)
-                {
-                    errors.clear(cp_errors::bits::ReadTruncated);
-                    errors |= ((cp_errors::bits::Failed | cp_errors::bits::NotDecodable) | ((byte >= 0xfeu) ? cp_errors::bits::DisallowedByte : cp_errors::bits::UnexpectedByte));
-                    errors.set_byte_index(index);
-                    count = index;
-                    break;
-                }
-                value = ((value << 6) | (byte & 0x3fu));
+                check.set_byte_index(errors.get_byte_index());
             }
-            bytes = count;
-            if (errors.no_error())
+            errors |= check;
+            if (extra == 0)
+            {   //  buffer error
+                break;
+            }
+            unicodes[count] = unicode;
+            ++count;
+            scan.offset += extra;
+        }
+        bytes = (scan.offset - text.offset);
+        if (!failing)
+        {
+            failed = bytes;
+        }
+    }
+    return errors;
+}
+
+template<encodeFunction encode>
+[[nodiscard]] cp_errors encodeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) noexcept
+{
+    count = 0;
+    bytes = 0;
+    cp_errors errors = get_errors(text);
+    if ((unicodes == nullptr) && (length != 0))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
+    }
+    if (errors.no_error())
+    {
+        utf_text scan = text;
+        while (count < length)
+        {
+            uint32_t extra = 0;
+            errors |= encode(scan, unicodes[count], extra);
+            if (errors.error())
             {
-                unicode = value;
-                if (count > 1)
-                {   //  possible overlong
-                    int32_t n = (static_cast<int32_t>(count | (count << 2)) - 11);
-                    if ((value >> static_cast<uint32_t>((n & ((~n) >> 31)) + 7)) == 0)
-                    {   //  the unicode character used an overlong or modified encoding: a 2 byte UTF8 encoding of U+0000 is a common exception to the overlong encoding rule notably used in Java
-                        errors |= (((value == 0) && (count == 2)) ? cp_errors::bits::ModifiedUTF8 : cp_errors::bits::OverlongUTF8);
-                    }
-                }
+                break;
             }
+            ++count;
+            scan.offset += extra;
         }
+        bytes = (scan.offset - text.offset);
     }
     return errors;
 }
@@ -638,937 +638,1391 @@ void stepSeqUTF8st(const uint8_t* const buffer, const uint32_t offset, const uin
     }
 }
 
-};  //  namespace internal
+// ==== internal UTF8 step and back fast paths ====
 
-// ==== encoded code-point length functions ====
+//  Notes:
+//  
+//  Well-formed sequences (as accepted by getUTF8()) are a single code-point for the non-strict, non-cesu sequence
+//  scanners, so a well-formed span can be skipped by counting lead bytes 64 at a time with the bulk kernels. The
+//  scalar scanners still handle malformed bytes and the sequences around the target.
+
+constexpr uint32_t kSkipBlock = 64;     //  lead byte counting block size
+constexpr uint32_t kSkipWindow = 1024;  //  validation window size
+
+uint32_t stepSpanUTF8(const uint8_t* const buffer, const uint32_t limit, const uint32_t count, uint32_t& points) noexcept
+{   //  skips up to count well-formed sequences forward from buffer, returns the bytes skipped
+    uint32_t offset = 0;
+    points = 0;
+    while ((points < count) && ((limit - offset) >= kSkipBlock))
+    {
+        const uint32_t window = (((limit - offset) < kSkipWindow) ? (limit - offset) : kSkipWindow);
+        const uint32_t span = simd::validSpanUTF8(&buffer[offset], window);
+        if (span == 0)
+        {
+            break;
+        }
+        const uint32_t leads = simd::countUTF8(&buffer[offset], span);
+        if ((points + leads) > count)
+        {   //  the target is in the span, find the lead byte that follows the last sequence skipped
+            uint32_t need = (count - points);
+            uint32_t index = offset;
+            uint32_t leading = 0;
+            while (((offset + span) - index) >= kSkipBlock)
+            {
+                leading = simd::countUTF8(&buffer[index], kSkipBlock);
+                if (leading > need)
+                {
+                    break;
+                }
+                need -= leading;
+                index += kSkipBlock;
+            }
+            while (!isLeadUTF8(buffer[index]) || (need != 0))
+            {
+                need -= (isLeadUTF8(buffer[index]) ? 1 : 0);
+                ++index;
+            }
+            points = count;
+            return index;
+        }
+        points += leads;
+        offset += span;
+    }
+    return offset;
+}
 
-uint32_t lenUTF8(const unicode_t unicode, const bool use_cesu, const bool use_java) noexcept
-{
-    uint32_t bytes = 0;
-    if (static_cast<uint32_t>(unicode) <= 0x7fffffffu)
-    {   //  is an encodable unicode value
-        if (unicode <= 0x0000007fu)
-        {   //  1 byte (7 bits)
-            bytes = ((use_java && (unicode == 0x00000000u)) ? 2 : 1);
+uint32_t backSpanUTF8(const uint8_t* const buffer, const uint32_t offset, const uint32_t limit, const uint32_t count, uint32_t& points) noexcept
+{   //  skips up to count well-formed sequences backward from buffer[offset] (limit bytes are available), returns the bytes skipped
+    const uint32_t first = (offset - limit);
+    uint32_t end = offset;
+    points = 0;
+    while ((points < count) && ((end - first) >= kSkipBlock))
+    {
+        const uint32_t window = (((end - first) < kSkipWindow) ? (end - first) : kSkipWindow);
+        uint32_t begin = (end - window);
+        bool malformed = false;
+        while (begin < end)
+        {   //  find the well-formed span that ends at end (starting on a lead byte)
+            while ((begin < end) && !isLeadUTF8(buffer[begin]))
+            {
+                ++begin;
+            }
+            const uint32_t span = simd::validSpanUTF8(&buffer[begin], end - begin);
+            if ((begin + span) == end)
+            {
+                break;
+            }
+            begin += (span + 1);
+            malformed = true;
         }
-        else if (unicode <= 0x000007ffu)
-        {   //  2 bytes (11 bits)
-            bytes = 2;
+        if (begin == end)
+        {
+            break;
         }
-        else if (unicode <= 0x0000ffffu)
-        {   //  3 bytes (16 bits)
-            bytes = 3;
+        const uint32_t leads = simd::countUTF8(&buffer[begin], end - begin);
+        if ((points + leads) > count)
+        {   //  the target is in the span, find the lead byte of the last sequence skipped
+            uint32_t need = (count - points);
+            uint32_t index = end;
+            while ((index - begin) >= kSkipBlock)
+            {
+                const uint32_t leading = simd::countUTF8(&buffer[index - kSkipBlock], kSkipBlock);
+                if (leading >= need)
+                {
+                    break;
+                }
+                need -= leading;
+                index -= kSkipBlock;
+            }
+            while (need != 0)
+            {
+                --index;
+                need -= (isLeadUTF8(buffer[index]) ? 1 : 0);
+            }
+            points = count;
+            return (offset - index);
         }
-        else if (unicode <= 0x0010ffffu)
-        {   //  4 bytes (standard UTF8: 21 bits) or 6 bytes (CESU UTF8: UTF16 surrogates encoded as 2 UTF8 characters)
-            bytes = (use_cesu ? 6 : 4);
+        points += leads;
+        end = begin;
+        if (malformed)
+        {   //  malformed bytes precede the span
+            break;
         }
-        else if (unicode <= 0x001fffffu)
-        {   //  4 bytes (21 bits)
-            bytes = 4;
+    }
+    return (offset - end);
+}
+
+// ==== multi-threaded chunk helpers ====
+
+constexpr uint32_t kChunkBytes = 0x00040000u;  //  minimum source bytes per chunk (256KB)
+constexpr uint32_t kChunkLimit = 64;           //  maximum chunks per call
+
+static uint32_t syncChunk(const IUTFTK& handler, const utf_text& text, uint32_t offset) noexcept
+{   //  moves a chunk boundary forward to the start of a code-point as a sequential scan without errors would find it
+    const uint32_t unit = handler.unitSize();
+    const int32_t subType = static_cast<int32_t>(handler.utfSubType());
+    offset -= ((offset - text.offset) & (unit - 1));
+    uint32_t previous = offset;
+    if (subType <= static_cast<int32_t>(UTF_SUB_TYPE::JCESU8st))
+    {   //  UTF8 family: advance to the next lead byte and find the lead byte before it (at most 6 bytes back)
+        while ((offset < text.length) && !isLeadUTF8(text.buffer[offset]))
+        {
+            ++offset;
         }
-        else if (unicode <= 0x03ffffffu)
-        {   //  5 bytes (26 bits)
-            bytes = 5;
+        previous = offset;
+        for (uint32_t back = 0; (back < 6) && (previous > text.offset); ++back)
+        {
+            if (isLeadUTF8(text.buffer[--previous]))
+            {
+                break;
+            }
         }
-        else
-        {   //  6 bytes (31 bits)
-            bytes = 6;
+    }
+    else if ((subType <= static_cast<int32_t>(UTF_SUB_TYPE::CESU4be)) && (offset > text.offset))
+    {   //  UTF16 and UTF32 families: the previous code-unit
+        previous = offset - unit;
+    }
+    if (previous < offset)
+    {   //  a surrogate pair (or an over-long sequence) can start before the boundary and end beyond it
+        utf_text scan = text;
+        scan.offset = previous;
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        static_cast<void>(handler.get(scan, unicode, bytes));
+        if ((previous + bytes) > offset)
+        {
+            offset = previous + bytes;
         }
     }
-    return bytes;
+    return offset;
 }
 
-uint32_t lenUTF16(const unicode_t unicode, const bool use_ucs2) noexcept
-{
-    uint32_t bytes = 0;
-    if (static_cast<uint32_t>(unicode) <= 0x0010ffffu)
+static uint32_t splitChunks(const IUTFTK& handler, const utf_text& text, const uint32_t threads, uint32_t& workers, uint32_t* const bounds) noexcept
+{   //  splits the text into chunks starting on code-point boundaries, returns the chunk count (chunk n is bounds[n] to bounds[n + 1])
+    workers = (threads ? threads : static_cast<uint32_t>(::std::thread::hardware_concurrency()));
+    workers = (workers ? workers : 1);
+    uint32_t count = (text.length - text.offset) / kChunkBytes;
+    count = ((count < (workers << 2)) ? count : (workers << 2));
+    count = ((count < kChunkLimit) ? count : kChunkLimit);
+    count = (((workers > 1) && (count > 1)) ? count : 1);
+    uint32_t chunks = 0;
+    bounds[0] = text.offset;
+    for (uint32_t index = 1; index <= count; ++index)
     {
-        if (unicode <= 0x0000ffffu)
+        uint32_t end = text.length;
+        if (index < count)
         {
-            bytes = 2;
+            end = syncChunk(handler, text, text.offset + static_cast<uint32_t>((static_cast<uint64_t>(text.length - text.offset) * index) / count));
         }
-        else if (!use_ucs2)
+        if (end > bounds[chunks])
         {
-            bytes = 4;
+            bounds[++chunks] = end;
         }
     }
-    return bytes;
+    workers = ((workers < chunks) ? workers : chunks);
+    return chunks;
 }
 
-uint32_t lenUTF32(const unicode_t unicode, const bool use_cesu, const bool use_ucs4) noexcept
-{
-    uint32_t bytes = 0;
-    if (static_cast<uint32_t>(unicode) <= uint32_t(use_ucs4 ? 0x7fffffffu : 0x0010ffffu))
+template<typename job_t>
+static void workChunks(job_t* const job, const uint32_t count, ::std::atomic<uint32_t>* const next) noexcept
+{   //  runs chunks until there are none left
+    for (uint32_t index = next->fetch_add(1u); index < count; index = next->fetch_add(1u))
     {
-        bytes = ((use_cesu && (unicode >= 0x00010000u) && (unicode <= 0x0010ffffu)) ? 8 : 4);
+        job->run(index);
     }
-    return bytes;
 }
 
-// ==== low level code-point encoding functions ====
-
-[[nodiscard]] cp_errors encodeBYTE(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool use_ascii) noexcept
-{
-    bytes = 0;
-    cp_errors errors = get_errors(text);
-    if (unicode <= 0x00000000u)
+template<typename job_t>
+static void runChunks(job_t& job, const uint32_t count, const uint32_t workers) noexcept
+{   //  runs every chunk on the calling thread and up to workers - 1 worker threads, the chunks are handed out in order
+    ::std::atomic<uint32_t> next(0u);
+    ::std::thread pool[kChunkLimit];
+    uint32_t started = 0;
+    try
+    {
+        for (; (started + 1) < workers; ++started)
+        {
+            pool[started] = ::std::thread(workChunks<job_t>, &job, count, &next);
+        }
+    }
+    catch (...)
+    {   //  could not start a thread, the calling thread and any workers already started finish the chunks
+    }
+    workChunks(&job, count, &next);
+    for (uint32_t index = 0; index < started; ++index)
     {
-        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : cp_errors::bits::DelimitString);
+        pool[index].join();
     }
-    else if (static_cast<uint32_t>(unicode) > (use_ascii ? 0x0000007fu : 0x000000ffu))
+}
+
+// ==== multi-threaded validation helpers ====
+
+struct validate_chunk
+{
+    uint32_t    start;      //  offset of the first code-point in the chunk
+    uint32_t    end;        //  offset of the first code-point in the next chunk
+    uint32_t    stop;       //  offset of the failing code-point or the first code-point at or beyond end
+    cp_errors   errors;     //  accumulated warnings and errors
+};
+
+static void scanValidate(const IUTFTK& handler, const utf_text& text, validate_chunk& chunk) noexcept
+{   //  reads code-points from chunk.start until at or beyond chunk.end accumulating warnings, stops on any errors
+    utf_text scan = text;
+    scan.offset = chunk.start;
+    chunk.errors = cp_errors();
+    while (scan.offset < chunk.end)
     {
-        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::NotEnoughBits);
-        if (unicode >= 0x0000d800u)
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        chunk.errors |= handler.get(scan, unicode, bytes);
+        if (chunk.errors.error())
         {
-            if (unicode > 0x0010ffffu)
-            {
-                errors |= cp_errors::bits::ExtendedUCS4;
-            }
-            else if (unicode >= 0x0000fdd0u)
-            {
-                if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-                {
-                    errors |= cp_errors::bits::NonCharacter;
-                }
-                if (unicode > 0x0000ffffu)
-                {
-                    errors |= cp_errors::bits::Supplementary;
-                }
-            }
-            else if ((unicode & 0xfffff800u) == 0x0000d800u)
-            {
-                errors |= ((unicode & 0x00000400u) ? cp_errors::bits::LowSurrogate : cp_errors::bits::HighSurrogate);
-            }
+            break;
         }
+        scan.offset += bytes;
     }
-    if (errors.no_error())
+    chunk.stop = scan.offset;
+}
+
+struct validate_job
+{
+    const IUTFTK&       handler;
+    const utf_text&     text;
+    validate_chunk*     chunks;
+    void run(const uint32_t index) noexcept { scanValidate(handler, text, chunks[index]); }
+};
+
+// ==== multi-threaded transcoding helpers ====
+
+struct transcode_chunk
+{
+    uint32_t    start;      //  source offset of the first code-point in the chunk
+    uint32_t    end;        //  source offset of the first code-point in the next chunk
+    uint32_t    stop;       //  source offset of the failing code-point or the first code-point at or beyond end
+    uint64_t    size;       //  encoded size of the chunk (pass 1)
+    uint32_t    output;     //  destination offset of the chunk (pass 2)
+    uint32_t    limit;      //  destination offset the bulk kernels may write up to (pass 2)
+    uint32_t    written;    //  destination offset after the last code-point written (pass 2)
+    bool        failed;     //  the chunk failed to decode (pass 1)
+    cp_errors   errors;     //  accumulated warnings and errors (pass 2)
+};
+
+static void sizeTranscode(const IUTFTK& srcHandler, const IUTFTK& dstHandler, const utf_text& src, transcode_chunk& chunk) noexcept
+{   //  sums the encoded lengths of the code-points from chunk.start until at or beyond chunk.end, stops on any errors
+    //  (len() is 0 for code-points that set() writes with a warning, so those are sized by encoding them)
+    uint8_t sequence[8];
+    utf_text scratch;
+    scratch.length = 8;
+    scratch.offset = 0;
+    scratch.buffer = sequence;
+    utf_text scan = src;
+    scan.offset = chunk.start;
+    chunk.size = 0;
+    chunk.failed = false;
+    while (scan.offset < chunk.end)
     {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < 1)
-        {   //  buffer overflow
-            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        if (srcHandler.get(scan, unicode, bytes).error())
+        {
+            chunk.failed = true;
+            break;
         }
-        else
+        uint32_t size = dstHandler.len(unicode);
+        if (size == 0)
         {
-            uint8_t* const buffer = &text.buffer[text.offset];
-            buffer[0] = static_cast<uint8_t>(unicode);
-            bytes = 1;
+            static_cast<void>(dstHandler.set(scratch, unicode, size));
         }
+        chunk.size += size;
+        scan.offset += bytes;
     }
-    return errors;
 }
 
-[[nodiscard]] cp_errors encodeUTF8(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool use_cesu, const bool use_java) noexcept
+inline bool isUTF8SubType(const UTF_SUB_TYPE utfSubType) noexcept
 {
-    bytes = 0;
-    cp_errors errors = get_errors(text);
-    if (unicode <= 0x00000000u)
+    return (static_cast<int32_t>(utfSubType) <= static_cast<int32_t>(UTF_SUB_TYPE::JCESU8st));
+}
+
+inline bool isUTF16SubType(const UTF_SUB_TYPE utfSubType) noexcept
+{   //  UTF16 and UCS2 encode the code-points up to 0xff identically
+    return ((static_cast<int32_t>(utfSubType) >= static_cast<int32_t>(UTF_SUB_TYPE::UTF16le)) && (static_cast<int32_t>(utfSubType) <= static_cast<int32_t>(UTF_SUB_TYPE::UCS2be)));
+}
+
+inline bool isBigEndianSubType(const UTF_SUB_TYPE utfSubType) noexcept
+{   //  only valid for the UTF16 and UCS2 sub-types
+    return ((utfSubType == UTF_SUB_TYPE::UTF16be) || (utfSubType == UTF_SUB_TYPE::UCS2be));
+}
+
+inline bool isBYTESubType(const UTF_SUB_TYPE utfSubType) noexcept
+{
+    return ((static_cast<int32_t>(utfSubType) >= static_cast<int32_t>(UTF_SUB_TYPE::BYTE)) && (static_cast<int32_t>(utfSubType) <= static_cast<int32_t>(UTF_SUB_TYPE::ASCIIns)));
+}
+
+inline bool isASCIISubType(const UTF_SUB_TYPE utfSubType) noexcept
+{
+    return ((utfSubType == UTF_SUB_TYPE::ASCII) || (utfSubType == UTF_SUB_TYPE::ASCIIns));
+}
+
+inline bool isCP1252SubType(const UTF_SUB_TYPE utfSubType) noexcept
+{
+    return ((utfSubType == UTF_SUB_TYPE::CP1252) || (utfSubType == UTF_SUB_TYPE::CP1252ns) || (utfSubType == UTF_SUB_TYPE::CP1252st));
+}
+
+static bool hasBulkTranscode(const UTF_SUB_TYPE srcType, const UTF_SUB_TYPE dstType) noexcept
+{   //  true if there is a bulk kernel for the pair of sub-types
+    if (isCP1252SubType(srcType) || isBYTESubType(srcType))
     {
-        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : (use_java ? cp_errors::bits::ModifiedUTF8 : cp_errors::bits::DelimitString));
+        return (isUTF8SubType(dstType) || (isBYTESubType(srcType) && isUTF16SubType(dstType)));
     }
-    else if (unicode >= 0x0000d800u)
+    if (isCP1252SubType(dstType) || isBYTESubType(dstType))
     {
-        if (unicode > 0x0010ffffu)
+        return (isUTF8SubType(srcType) || (isBYTESubType(dstType) && isUTF16SubType(srcType)));
+    }
+    return false;
+}
+
+static uint32_t bulkTranscode(const UTF_SUB_TYPE srcType, const UTF_SUB_TYPE dstType, const uint8_t* const src, const uint32_t srcSize, uint8_t* const dst, const uint32_t dstSize, uint32_t& written) noexcept
+{   //  converts the leading code-points that get() and set() convert with no errors or warnings, returns the source bytes consumed
+    //  (the span must not contain NULL, the kernels stop at any form that the quick functions reject)
+    if (isCP1252SubType(srcType))
+    {   //  CP1252 and CP1252ns decode every byte, the Java and CESU variants of UTF8 encode the BMP without NULL as UTF8 does
+        return simd::convertCP1252toUTF8(src, srcSize, dst, dstSize, written, (srcType == UTF_SUB_TYPE::CP1252st), false);
+    }
+    if (isCP1252SubType(dstType))
+    {
+        return simd::convertUTF8toCP1252(src, srcSize, dst, dstSize, written, (dstType == UTF_SUB_TYPE::CP1252st), false);
+    }
+    if (isBYTESubType(srcType))
+    {   //  ASCII and ASCIIns stop at the first byte above 0x7f and leave it to get() to report
+        if (isUTF16SubType(dstType))
         {
-            errors |= ((unicode > 0x001fffffu) ? (cp_errors::bits::ExtendedUTF8 | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm) : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+            return simd::convertBYTEtoUTF16(src, srcSize, dst, dstSize, written, isBigEndianSubType(dstType), isASCIISubType(srcType));
         }
-        else if (unicode >= 0x0000fdd0u)
+        return simd::convertBYTEtoUTF8(src, srcSize, dst, dstSize, written, isASCIISubType(srcType), false);
+    }
+    if (isUTF16SubType(srcType))
+    {
+        return simd::convertUTF16toBYTE(src, srcSize, dst, dstSize, written, isBigEndianSubType(srcType), isASCIISubType(dstType));
+    }
+    return simd::convertUTF8toBYTE(src, srcSize, dst, dstSize, written, isASCIISubType(dstType), false);
+}
+
+static uint32_t findDelimiter(const uint8_t* const buffer, uint32_t offset, const uint32_t end, const bool wide) noexcept
+{   //  returns the offset of the first NULL code-unit (16-bit if wide) at or after offset or end if there is none
+    if (!wide)
+    {
+        const void* const found = ::memchr(&buffer[offset], 0, (end - offset));
+        return ((found != nullptr) ? static_cast<uint32_t>(static_cast<const uint8_t*>(found) - buffer) : end);
+    }
+    while ((end - offset) >= 8)
+    {   //  skip 4 code-units at a time while none of them are NULL
+        uint64_t word;
+        ::memcpy(&word, &buffer[offset], 8);
+        if (((word - 0x0001000100010001ull) & ~word & 0x8000800080008000ull) != 0)
         {
-            if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+            break;
+        }
+        offset += 8;
+    }
+    while ((end - offset) >= 2)
+    {
+        if ((buffer[offset] | buffer[offset + 1]) == 0)
+        {
+            return offset;
+        }
+        offset += 2;
+    }
+    return end;
+}
+
+static void scanTranscode(const IUTFTK& srcHandler, const IUTFTK& dstHandler, const utf_text& src, const utf_text& dst, transcode_chunk& chunk) noexcept
+{   //  transcodes code-points from chunk.start until at or beyond chunk.end writing from chunk.output, stops on any errors
+    //  (the bulk kernels may write beyond what they convert, so they are given the space up to chunk.limit and not beyond)
+    const UTF_SUB_TYPE srcType = srcHandler.utfSubType();
+    const UTF_SUB_TYPE dstType = dstHandler.utfSubType();
+    const bool wide = isUTF16SubType(srcType);
+    const uint32_t misaligned = (((src.length | chunk.start) & (wide ? 1u : 0u)) | ((dst.length | chunk.output) & (isUTF16SubType(dstType) ? 1u : 0u)));
+    const bool bulk = (hasBulkTranscode(srcType, dstType) && (misaligned == 0));    //  get() and set() report misaligned UTF16 buffers
+    utf_text scan = src;
+    utf_text fill = dst;
+    scan.offset = chunk.start;
+    fill.offset = chunk.output;
+    chunk.errors = cp_errors();
+    uint32_t delimiter = scan.offset;
+    while (scan.offset < chunk.end)
+    {
+        if (bulk)
+        {   //  the bulk kernels convert up to the next NULL (which get() and set() report as a warning) or the first form they reject
+            if (delimiter <= scan.offset)
             {
-                errors |= cp_errors::bits::NonCharacter;
+                delimiter = findDelimiter(scan.buffer, scan.offset, chunk.end, wide);
             }
-            if (unicode > 0x0000ffffu)
+            uint32_t written = 0;
+            const uint32_t space = ((chunk.limit > fill.offset) ? (chunk.limit - fill.offset) : 0);
+            scan.offset += bulkTranscode(srcType, dstType, &scan.buffer[scan.offset], (delimiter - scan.offset), &fill.buffer[fill.offset], space, written);
+            fill.offset += written;
+            if (scan.offset >= chunk.end)
             {
-                errors |= (use_cesu ? (cp_errors::bits::Supplementary | cp_errors::bits::SurrogatePair) : cp_errors::bits::Supplementary);
+                break;
             }
         }
-        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        chunk.errors |= srcHandler.get(scan, unicode, bytes);
+        if (chunk.errors.error())
         {
-            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+            break;
+        }
+        uint32_t written = 0;
+        chunk.errors |= dstHandler.set(fill, unicode, written);
+        if (chunk.errors.error())
+        {
+            break;
         }
+        scan.offset += bytes;
+        fill.offset += written;
     }
-    if (errors.no_error())
+    chunk.stop = scan.offset;
+    chunk.written = fill.offset;
+}
+
+struct transcode_job
+{
+    const IUTFTK&       srcHandler;
+    const IUTFTK&       dstHandler;
+    const utf_text&     src;
+    const utf_text&     dst;
+    transcode_chunk*    chunks;
+    bool                encode;     //  false for pass 1 (sizes), true for pass 2 (encoding)
+    void run(const uint32_t index) noexcept
     {
-        const uint32_t limit = (text.length - text.offset);
-        uint8_t* const buffer = &text.buffer[text.offset];
-        if (unicode <= 0x0000007fu)
-        {   //  1 byte (standard UTF8: 7 bits) or 2 bytes (modified NULL: 11 bits)
-            if (errors.any(cp_errors::bits::ModifiedUTF8))
-            {   //  2 bytes (modified NULL: 11 bits)
-                if (limit < 2)
-                {   //  buffer overflow
-                    errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-                }
-                else
-                {
-                    buffer[0] = 0xc0u;
-                    buffer[1] = 0x80u;
-                    bytes = 2;
-                }
-            }
-            else
-            {   //  1 byte (standard UTF8: 7 bits)
-                if (limit < 1)
-                {   //  buffer overflow
-                    errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-                }
-                else
-                {
-                    buffer[0] = static_cast<uint8_t>(unicode);
-                    bytes = 1;
-                }
-            }
-        }
-        else if (unicode <= 0x000007ffu)
-        {   //  2 bytes (11 bits)
-            if (limit < 2)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                buffer[0] = (static_cast<uint8_t>(unicode >> 6) | 0xc0u);
-                buffer[1] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
-                bytes = 2;
-            }
-        }
-        else if (unicode <= 0x0000ffffu)
-        {   //  3 bytes (16 bits)
-            if (limit < 3)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                buffer[0] = (static_cast<uint8_t>(unicode >> 12) | 0xe0u);
-                buffer[1] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
-                buffer[2] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
-                bytes = 3;
-            }
-        }
-        else if ((unicode <= 0x0010ffffu) && errors.any(cp_errors::bits::SurrogatePair))
-        {   //  6 bytes (CESU UTF8: UTF16 surrogates encoded as 2 UTF8 characters)
-            if (limit < 6)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                unicode_t surrogate = (unicode - 0x00010000u);
-                surrogate = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
-                buffer[0] = ((static_cast<uint8_t>(surrogate >> 12) & 0x0fu) | 0xe0u);
-                buffer[1] = ((static_cast<uint8_t>(surrogate >> 6) & 0x3fu) | 0x80u);
-                buffer[2] = ((static_cast<uint8_t>(surrogate) & 0x3fu) | 0x80u);
-                buffer[3] = ((static_cast<uint8_t>(surrogate >> 28) & 0x0fu) | 0xe0u);
-                buffer[4] = ((static_cast<uint8_t>(surrogate >> 22) & 0x3fu) | 0x80u);
-                buffer[5] = ((static_cast<uint8_t>(surrogate >> 16) & 0x3fu) | 0x80u);
-                bytes = 6;
-            }
-        }
-        else if (unicode <= 0x001fffffu)
-        {   //  4 bytes (21 bits)
-            if (limit < 4)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                buffer[0] = (static_cast<uint8_t>(unicode >> 18) | 0xf0u);
-                buffer[1] = ((static_cast<uint8_t>(unicode >> 12) & 0x3fu) | 0x80u);
-                buffer[2] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
-                buffer[3] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
-                bytes = 4;
-            }
-        }
-        else if (unicode <= 0x03ffffffu)
-        {   //  5 bytes (26 bits)
-            if (limit < 5)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                buffer[0] = (static_cast<uint8_t>(unicode >> 24) | 0xf8u);
-                buffer[1] = ((static_cast<uint8_t>(unicode >> 18) & 0x3fu) | 0x80u);
-                buffer[2] = ((static_cast<uint8_t>(unicode >> 12) & 0x3fu) | 0x80u);
-                buffer[3] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
-                buffer[4] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
-                bytes = 5;
-            }
+        if (encode)
+        {
+            scanTranscode(srcHandler, dstHandler, src, dst, chunks[index]);
         }
         else
-        {   //  6 bytes (31 bits)
-            if (limit < 6)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                buffer[0] = (static_cast<uint8_t>(unicode >> 30) | 0xfcu);
-                buffer[1] = ((static_cast<uint8_t>(unicode >> 24) & 0x3fu) | 0x80u);
-                buffer[2] = ((static_cast<uint8_t>(unicode >> 18) & 0x3fu) | 0x80u);
-                buffer[3] = ((static_cast<uint8_t>(unicode >> 12) & 0x3fu) | 0x80u);
-                buffer[4] = ((static_cast<uint8_t>(unicode >> 6) & 0x3fu) | 0x80u);
-                buffer[5] = ((static_cast<uint8_t>(unicode) & 0x3fu) | 0x80u);
-                bytes = 6;
-            }
+        {
+            sizeTranscode(srcHandler, dstHandler, src, chunks[index]);
         }
     }
-    return errors;
+};
+
+// ==== line splitting helpers ====
+
+uint32_t candidateSpan(const UTF_SUB_TYPE utfSubType, const uint8_t* const buffer, const uint32_t size) noexcept
+{   //  returns the byte offset of the first line terminator candidate (the UTF8 bytes before it are not validated)
+    switch (utfSubType)
+    {
+        case(UTF_SUB_TYPE::UTF8):
+        case(UTF_SUB_TYPE::UTF8ns):
+        case(UTF_SUB_TYPE::UTF8st):
+        case(UTF_SUB_TYPE::JUTF8):
+        case(UTF_SUB_TYPE::JUTF8ns):
+        case(UTF_SUB_TYPE::JUTF8st):
+        case(UTF_SUB_TYPE::CESU8):
+        case(UTF_SUB_TYPE::CESU8ns):
+        case(UTF_SUB_TYPE::CESU8st):
+        case(UTF_SUB_TYPE::JCESU8):
+        case(UTF_SUB_TYPE::JCESU8ns):
+        case(UTF_SUB_TYPE::JCESU8st):   return simd::findLineCandidateUTF8(buffer, size);
+        case(UTF_SUB_TYPE::UTF16le):
+        case(UTF_SUB_TYPE::UCS2le):     return simd::findLineCandidateUTF16(buffer, size, false);
+        case(UTF_SUB_TYPE::UTF16be):
+        case(UTF_SUB_TYPE::UCS2be):     return simd::findLineCandidateUTF16(buffer, size, true);
+        case(UTF_SUB_TYPE::UTF32le):
+        case(UTF_SUB_TYPE::UCS4le):
+        case(UTF_SUB_TYPE::CESU32le):
+        case(UTF_SUB_TYPE::CESU4le):    return simd::findLineCandidateUTF32(buffer, size, false);
+        case(UTF_SUB_TYPE::UTF32be):
+        case(UTF_SUB_TYPE::UCS4be):
+        case(UTF_SUB_TYPE::CESU32be):
+        case(UTF_SUB_TYPE::CESU4be):    return simd::findLineCandidateUTF32(buffer, size, true);
+        default:                        return simd::findLineCandidateBYTE(buffer, size);
+    }
 }
 
-[[nodiscard]] cp_errors encodeUTF8n(utf_text& text, const unicode_t unicode, const uint32_t bytes, const bool use_java) noexcept
+uint32_t lineSpan(const UTF_SUB_TYPE utfSubType, const uint8_t* const buffer, const uint32_t size) noexcept
+{   //  returns the byte length of the leading code-points that are not line terminators and decode with no errors or warnings
+    const uint32_t span = candidateSpan(utfSubType, buffer, size);
+    return (isUTF8SubType(utfSubType) ? simd::validSpanUTF8(buffer, span) : span);
+}
+
+// ==== multi-threaded line table helpers ====
+
+struct line_chunk
 {
-    cp_errors errors = get_errors(text);
-    if (static_cast<uint32_t>(bytes - 1) < 6)
-    {
-        if (unicode == 0x00000000u)
+    uint32_t    start;      //  offset of the first code-point in the chunk
+    uint32_t    end;        //  offset of the first code-point in the next chunk
+    uint32_t    stop;       //  offset of the failing code-point or the first code-point at or beyond end
+    uint32_t    lines;      //  count of line starts found in the chunk (line terminators that do not end the text)
+    uint32_t    last;       //  offset after the last line terminator in the chunk or 0 if there is none
+    uint32_t    output;     //  table index of the first line start found in the chunk
+    cp_errors   errors;     //  accumulated warnings and errors
+};
+
+static void scanLines(const IUTFTK& handler, const utf_text& text, line_chunk& chunk, uint32_t* const offsets, const uint32_t capacity) noexcept
+{   //  finds the line terminators from chunk.start until at or beyond chunk.end with getNLF(), stops on any errors
+    const UTF_SUB_TYPE sub_type = handler.utfSubType();
+    utf_text scan = text;
+    scan.offset = chunk.start;
+    chunk.lines = 0;
+    chunk.last = 0;
+    chunk.errors = cp_errors();
+    while (scan.offset < chunk.end)
+    {   //  only the candidates found by the bulk kernels are decoded, a terminator pair may end beyond chunk.end
+        scan.offset += lineSpan(sub_type, &text.buffer[scan.offset], (chunk.end - scan.offset));
+        if (scan.offset >= chunk.end)
         {
-            errors |= ((bytes < 2) ? cp_errors::bits::DelimitString : ((bytes > 2) ? (cp_errors::bits::OverlongUTF8 | cp_errors::bits::IrregularForm) : (use_java ? cp_errors::bits::ModifiedUTF8 : (cp_errors::bits::ModifiedUTF8 | cp_errors::bits::IrregularForm))));
+            break;
         }
-        else
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        chunk.errors |= handler.getNLF(scan, unicode, bytes);
+        if (chunk.errors.error())
         {
-            int32_t n = (static_cast<int32_t>(bytes | (bytes << 2)) - 6);
-            if ((unicode >> static_cast<uint32_t>((n & ((~n) >> 31)) + 7)) != 0)
-            {
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::NotEnoughBits);
-            }
-            else if (bytes > 1)
+            break;
+        }
+        scan.offset += bytes;
+        if ((unicode == 0x000au) || (unicode == 0x0000u))
+        {
+            chunk.last = scan.offset;
+            if (scan.offset < text.length)
             {
-                n -= 5;
-                if ((unicode >> static_cast<uint32_t>((n & ((~n) >> 31)) + 7)) == 0)
+                const uint32_t index = chunk.output + chunk.lines;
+                if ((offsets != nullptr) && (index < capacity))
                 {
-                    errors |= (cp_errors::bits::OverlongUTF8 | cp_errors::bits::IrregularForm);
+                    offsets[index] = scan.offset;
                 }
+                ++chunk.lines;
             }
         }
     }
-    else
+    chunk.stop = scan.offset;
+}
+
+struct line_job
+{
+    const IUTFTK&       handler;
+    const utf_text&     text;
+    uint32_t*           offsets;
+    uint32_t            capacity;
+    line_chunk*         chunks;
+    bool                write;      //  false for pass 1 (counts), true for pass 2 (line starts)
+    void run(const uint32_t index) noexcept { scanLines(handler, text, chunks[index], (write ? offsets : nullptr), capacity); }
+};
+
+// ==== line ending normalisation helpers ====
+
+static cp_errors encodeNLF(const IUTFTK& handler, const NLF_TYPE terminator, uint8_t* const sequence, uint32_t& size) noexcept
+{   //  encodes the replacement line terminator (at most 2 code-points of at most 8 bytes each)
+    static const unicode_t kTerminators[static_cast<uint32_t>(NLF_TYPE::COUNT)][2] =
     {
-        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::BadSizeUTF8);
-    }
-    if (unicode < 0x00000000u)
+        { 0x000au, 0 }, { 0x000du, 0 }, { 0x000du, 0x000au }, { 0x0085u, 0 }, { 0x2028u, 0 }, { 0x2029u, 0 }
+    };
+    utf_text text;
+    text.length = 16;
+    text.offset = 0;
+    text.buffer = sequence;
+    size = 0;
+    const uint32_t index = static_cast<uint32_t>(terminator);
+    if (index >= static_cast<uint32_t>(NLF_TYPE::COUNT))
     {
-        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits);
+        return cp_errors(cp_errors::bits::Failed | cp_errors::bits::NotEncodable);
     }
-    else if (unicode >= 0x0000d800u)
+    cp_errors errors = cp_errors();
+    for (uint32_t point = 0; (point < 2) && kTerminators[index][point] && errors.no_error(); ++point)
     {
-        if (unicode > 0x0010ffffu)
+        uint32_t bytes = 0;
+        errors |= handler.set(text, kTerminators[index][point], bytes);
+        text.offset += bytes;
+    }
+    size = text.offset;
+    return errors;
+}
+
+static cp_errors normalizeNLF(const IUTFTK& handler, utf_text& src, utf_text& dst, const uint8_t* const sequence, const uint32_t size) noexcept
+{   //  copies spans without line terminators and rewrites the terminators found by getNLF(), stops on any errors (dst may overlap src behind it)
+    const UTF_SUB_TYPE sub_type = handler.utfSubType();
+    cp_errors errors = cp_errors();
+    while (src.offset < src.length)
+    {   //  the spans found by the bulk kernels are copied as they are, they are limited to the space left in dst
+        const uint32_t space = (dst.length - dst.offset);
+        const uint32_t left = (src.length - src.offset);
+        const uint32_t span = lineSpan(sub_type, &src.buffer[src.offset], ((left < space) ? left : space));
+        ::memmove(&dst.buffer[dst.offset], &src.buffer[src.offset], span);
+        src.offset += span;
+        dst.offset += span;
+        if (src.offset >= src.length)
         {
-            errors |= ((unicode > 0x001fffffu) ? (cp_errors::bits::ExtendedUTF8 | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm) : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+            break;
         }
-        else if (unicode >= 0x0000fdd0u)
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        errors |= handler.getNLF(src, unicode, bytes);
+        if (errors.error())
         {
-            if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-            {
-                errors |= cp_errors::bits::NonCharacter;
-            }
-            if (unicode > 0x0000ffffu)
-            {
-                errors |= cp_errors::bits::Supplementary;
-            }
+            break;
         }
-        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        const bool replace = (unicode == 0x000au);
+        const uint32_t write = (replace ? size : bytes);
+        if (write > (dst.length - dst.offset))
         {
-            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
-        }
-    }
-    if (errors.no_error())
-    {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < bytes)
-        {   //  buffer overflow
             errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+            break;
         }
-        else
-        {
-            uint8_t* const buffer = &text.buffer[text.offset];
-            unicode_t value = unicode;
-            for (uint32_t index = (bytes - 1); index; --index)
-            {
-                buffer[index] = ((static_cast<uint8_t>(value) & 0x3fu) | 0x80u);
-                value >>= 6;
-            }
-            uint8_t mask = ((bytes > 1) ? (0x7fu >> bytes) : 0x7fu);
-            buffer[0] = ((static_cast<uint8_t>(value) & mask) | (~mask << 1));
-        }
+        ::memmove(&dst.buffer[dst.offset], (replace ? sequence : &src.buffer[src.offset]), write);
+        src.offset += bytes;
+        dst.offset += write;
     }
     return errors;
 }
 
-[[nodiscard]] cp_errors encodeUTF16(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool le, const bool use_ucs2) noexcept
+// ==== sanitising transcoder helpers ====
+
+inline uint32_t spanForm(const UTF_SUB_TYPE utfSubType) noexcept
+{   //  sub-types of the same form (UTF8, UTF16le, UTF16be, UTF32le, UTF32be or byte) encode the code-points of a lineSpan() identically
+    const int32_t value = static_cast<int32_t>(utfSubType);
+    if (isUTF8SubType(utfSubType))
+    {
+        return 0;
+    }
+    if (value < static_cast<int32_t>(UTF_SUB_TYPE::UTF32le))
+    {
+        return (1 + static_cast<uint32_t>(value & 1));
+    }
+    if (value < static_cast<int32_t>(UTF_SUB_TYPE::BYTE))
+    {
+        return (3 + static_cast<uint32_t>(value & 1));
+    }
+    return 5;
+}
+
+static bool hasSanitizeSpan(const UTF_SUB_TYPE srcType, const UTF_SUB_TYPE dstType) noexcept
+{   //  true if the spans that decode cleanly can be copied or converted by a bulk kernel
+    return (hasBulkTranscode(srcType, dstType) || (spanForm(srcType) == spanForm(dstType)) ||
+            (isUTF8SubType(srcType) && isUTF16SubType(dstType)) || (isUTF16SubType(srcType) && isUTF8SubType(dstType)));
+}
+
+struct sanitize_scan
 {
-    bytes = 0;
-    cp_errors errors = get_errors(text, 1);
-    if (unicode <= 0x00000000u)
+    uint32_t    delimiter;  //  offset of the next NULL code-unit (the bulk transcode kernels stop before it)
+    uint32_t    candidate;  //  offset of the next line terminator candidate (the lineSpan() forms stop before it)
+};
+
+static uint32_t cleanSpan(const UTF_SUB_TYPE srcType, const utf_text& src, sanitize_scan& scan) noexcept
+{   //  returns the lineSpan() from src.offset, the line terminator candidate offset is cached
+    if (scan.candidate <= src.offset)
     {
-        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : cp_errors::bits::DelimitString);
+        scan.candidate = (src.offset + candidateSpan(srcType, &src.buffer[src.offset], (src.length - src.offset)));
     }
-    else if (unicode >= 0x0000d800u)
+    const uint32_t span = (scan.candidate - src.offset);
+    return (isUTF8SubType(srcType) ? simd::validSpanUTF8(&src.buffer[src.offset], span) : span);
+}
+
+static void sanitizeSpan(const UTF_SUB_TYPE srcType, const UTF_SUB_TYPE dstType, utf_text& src, utf_text& dst, sanitize_scan& scan) noexcept
+{   //  copies or converts the leading code-points that decode with no errors or warnings (and that fit in dst), the scan offsets are cached
+    //  so a source with many repairs is not scanned again to the next NULL or line terminator candidate after each one
+    const uint8_t* const buffer = &src.buffer[src.offset];
+    uint8_t* const target = &dst.buffer[dst.offset];
+    const uint32_t space = (dst.length - dst.offset);
+    uint32_t consumed = 0;
+    uint32_t written = 0;
+    if (hasBulkTranscode(srcType, dstType))
     {
-        if (unicode > 0x0010ffffu)
-        {
-            errors |= (cp_errors::bits::Failed | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::NotEnoughBits);
-        }
-        else if (unicode >= 0x0000fdd0u)
-        {
-            if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-            {
-                errors |= cp_errors::bits::NonCharacter;
-            }
-            if (unicode > 0x0000ffffu)
-            {
-                errors |= (use_ucs2 ? (cp_errors::bits::Failed | cp_errors::bits::Supplementary | cp_errors::bits::NotEnoughBits) : (cp_errors::bits::Supplementary | cp_errors::bits::SurrogatePair));
-            }
-        }
-        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        if (scan.delimiter <= src.offset)
         {
-            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+            scan.delimiter = findDelimiter(src.buffer, src.offset, src.length, isUTF16SubType(srcType));
         }
+        consumed = bulkTranscode(srcType, dstType, buffer, (scan.delimiter - src.offset), target, space, written);
     }
-    if (errors.no_error())
+    else
     {
-        const uint32_t limit = (text.length - text.offset);
-        uint8_t* const buffer = &text.buffer[text.offset];
-        if (errors.any(cp_errors::bits::SurrogatePair))
-        {   //  surrogate pair
-            if (limit < 4)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
+        const uint32_t span = cleanSpan(srcType, src, scan);
+        if (spanForm(srcType) == spanForm(dstType))
+        {   //  the code-units are the same, only whole UTF8 sequences are copied when dst is short (the other forms are aligned)
+            consumed = ((span < space) ? span : space);
+            if (isUTF8SubType(srcType) && (consumed < span))
             {
-                unicode_t surrogate = (unicode - 0x00010000u);
-                surrogate = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
-                if (le)
+                while ((consumed > 0) && ((buffer[consumed] & 0xc0u) == 0x80u))
                 {
-                    buffer[0] = static_cast<uint8_t>(surrogate);
-                    buffer[1] = static_cast<uint8_t>(surrogate >> 8);
-                    buffer[2] = static_cast<uint8_t>(surrogate >> 16);
-                    buffer[3] = static_cast<uint8_t>(surrogate >> 24);
+                    --consumed;
                 }
-                else
-                {
-                    buffer[0] = static_cast<uint8_t>(surrogate >> 8);
-                    buffer[1] = static_cast<uint8_t>(surrogate);
-                    buffer[2] = static_cast<uint8_t>(surrogate >> 24);
-                    buffer[3] = static_cast<uint8_t>(surrogate >> 16);
-                }
-                bytes = 4;
             }
+            ::memcpy(target, buffer, consumed);
+            written = consumed;
+        }
+        else if (isUTF16SubType(dstType))
+        {
+            consumed = simd::convertUTF8toUTF16(buffer, span, target, space, written, isBigEndianSubType(dstType), false);
         }
         else
-        {   //  simple UTF16
-            if (limit < 2)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                if (le)
-                {
-                    buffer[0] = static_cast<uint8_t>(unicode);
-                    buffer[1] = static_cast<uint8_t>(unicode >> 8);
-                }
-                else
-                {
-                    buffer[0] = static_cast<uint8_t>(unicode >> 8);
-                    buffer[1] = static_cast<uint8_t>(unicode);
-                }
-                bytes = 2;
-            }
+        {
+            consumed = simd::convertUTF16toUTF8(buffer, span, target, space, written, isBigEndianSubType(srcType), false);
         }
     }
-    return errors;
+    src.offset += consumed;
+    dst.offset += written;
 }
 
-[[nodiscard]] cp_errors encodeUTF32(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool le, const bool use_cesu, const bool use_ucs4) noexcept
+struct sanitize_replacement
 {
-    bytes = 0;
-    cp_errors errors = get_errors(text, 3);
-    if (unicode <= 0x00000000u)
+    uint8_t     sequence[8];    //  the encoded replacement or fallback
+    uint32_t    size;           //  the size of the encoded sequence
+    bool        fallback;       //  true if the sequence is the fallback
+    cp_errors   errors;         //  the errors and warnings of encoding the sequence
+};
+
+static void encodeReplacement(const IUTFTK& handler, const sanitize_policy& policy, sanitize_replacement& replacement) noexcept
+{   //  encodes the replacement (or the fallback if the replacement is not encodable) once, a code-point is at most 8 bytes
+    utf_text text;
+    text.length = 8;
+    text.offset = 0;
+    text.buffer = replacement.sequence;
+    replacement.size = 0;
+    replacement.fallback = false;
+    replacement.errors = handler.set(text, policy.replacement, replacement.size);
+    if (replacement.errors.error())
     {
-        errors |= (unicode ? cp_errors::bits::InvalidPoint : cp_errors::bits::DelimitString);
+        replacement.fallback = true;
+        replacement.errors = handler.set(text, policy.fallback, replacement.size);
     }
-    else if (unicode >= 0x0000d800u)
+}
+
+static cp_errors sanitizeStep(const IUTFTK& srcHandler, const IUTFTK& dstHandler, utf_text& src, utf_text& dst, const sanitize_policy& policy, const sanitize_replacement& replacement, sanitize_stats& stats) noexcept
+{   //  transcodes or replaces a single code-point, returns the errors if it stops
+    unicode_t unicode;
+    uint32_t bytes = 0;
+    const cp_errors decoded = srcHandler.get(src, unicode, bytes);
+    if (decoded.buffer_error() || (bytes == 0))
     {
-        if (unicode > 0x0010ffffu)
+        return decoded;
+    }
+    uint32_t* repair = nullptr;
+    if (decoded.error())
+    {   //  illegal, invalid or truncated sequences (bytes is the length of the sequence as the sub-type defines it)
+        repair = &stats.malformed;
+        if (decoded.any(cp_errors::bits::ReadTruncated))
         {
-            errors |= (use_ucs4 ? cp_errors::bits::ExtendedUCS4 : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+            ++stats.truncated;
         }
-        else if (unicode >= 0x0000fdd0u)
+    }
+    else if (policy.irregular_forms && decoded.any(cp_errors::bits::IrregularForm))
+    {
+        repair = &stats.irregular_forms;
+    }
+    else if (policy.non_characters && decoded.any(cp_errors::bits::NonCharacter))
+    {
+        repair = &stats.non_characters;
+    }
+    uint32_t written = 0;
+    if (repair == nullptr)
+    {
+        const cp_errors encoded = dstHandler.set(dst, unicode, written);
+        if (encoded.error())
         {
-            if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-            {
-                errors |= cp_errors::bits::NonCharacter;
-            }
-            if (unicode > 0x0000ffffu)
+            if (!policy.unencodable || encoded.any(cp_errors::bits::WriteOverflow) || encoded.buffer_error())
             {
-                errors |= (use_cesu ? (cp_errors::bits::Supplementary | cp_errors::bits::SurrogatePair) : cp_errors::bits::Supplementary);
+                return encoded;
             }
+            repair = &stats.unencodable;
         }
-        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+    }
+    if (repair != nullptr)
+    {   //  the pre-encoded replacement is written as set() would write it
+        if (replacement.errors.error())
         {
-            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+            return replacement.errors;
         }
-    }
-    if (errors.no_error())
-    {
-        const uint32_t limit = (text.length - text.offset);
-        uint8_t* const buffer = &text.buffer[text.offset];
-        if (errors.any(cp_errors::bits::SurrogatePair))
-        {   //  surrogate pair
-            if (limit < 8)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                unicode_t surrogate = (unicode - 0x00010000u);
-                surrogate = ((((surrogate >> 10) | (surrogate << 16)) & 0x03ff03ffu) | 0xdc00d800u);
-                if (le)
-                {
-                    buffer[0] = static_cast<uint8_t>(surrogate);
-                    buffer[1] = static_cast<uint8_t>(surrogate >> 8);
-                    buffer[2] = buffer[3] = static_cast<uint8_t>(0);
-                    buffer[4] = static_cast<uint8_t>(surrogate >> 16);
-                    buffer[5] = static_cast<uint8_t>(surrogate >> 24);
-                    buffer[6] = buffer[7] = static_cast<uint8_t>(0);
-                }
-                else
-                {
-                    buffer[0] = buffer[1] = static_cast<uint8_t>(0);
-                    buffer[2] = static_cast<uint8_t>(surrogate >> 8);
-                    buffer[3] = static_cast<uint8_t>(surrogate);
-                    buffer[4] = buffer[5] = static_cast<uint8_t>(0);
-                    buffer[6] = static_cast<uint8_t>(surrogate >> 24);
-                    buffer[7] = static_cast<uint8_t>(surrogate >> 16);
-                }
-                bytes = 8;
-            }
+        const cp_errors errors = get_errors(dst, (dstHandler.unitSize() - 1));
+        if (errors.error())
+        {
+            return errors;
         }
-        else
-        {   //  simple UTF32
-            if (limit < 4)
-            {   //  buffer overflow
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
-            }
-            else
-            {
-                if (le)
-                {
-                    buffer[0] = static_cast<uint8_t>(unicode);
-                    buffer[1] = static_cast<uint8_t>(unicode >> 8);
-                    buffer[2] = static_cast<uint8_t>(unicode >> 16);
-                    buffer[3] = static_cast<uint8_t>(unicode >> 24);
-                }
-                else
-                {
-                    buffer[0] = static_cast<uint8_t>(unicode >> 24);
-                    buffer[1] = static_cast<uint8_t>(unicode >> 16);
-                    buffer[2] = static_cast<uint8_t>(unicode >> 8);
-                    buffer[3] = static_cast<uint8_t>(unicode);
-                }
-                bytes = 4;
-            }
+        if (replacement.size > (dst.length - dst.offset))
+        {
+            return (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow) | replacement.errors;
         }
+        ::memcpy(&dst.buffer[dst.offset], replacement.sequence, replacement.size);
+        written = replacement.size;
+        ++(*repair);
+        ++stats.replaced;
+        stats.fallbacks += (replacement.fallback ? 1 : 0);
     }
-    return errors;
+    src.offset += bytes;
+    dst.offset += written;
+    return cp_errors();
 }
 
-[[nodiscard]] cp_errors encodeCP1252(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool strict) noexcept
-{
-    bytes = 0;
-    uint8_t cp1252 = 0;
-    cp_errors errors = get_errors(text);
-    if (unicode <= 0x00000000u)
+// ==== borrowing helpers ====
+
+static bool verbatimStep(const IUTFTK& handler, utf_text& text, const sanitize_policy& policy) noexcept
+{   //  decodes a single code-point, returns true (advancing text.offset) if sanitize() would write its bytes unchanged
+    unicode_t unicode;
+    uint32_t bytes = 0;
+    const cp_errors decoded = handler.get(text, unicode, bytes);
+    if (decoded.error() || (bytes == 0) || (policy.irregular_forms && decoded.any(cp_errors::bits::IrregularForm)) ||
+        (policy.non_characters && decoded.any(cp_errors::bits::NonCharacter)))
     {
-        errors |= (unicode ? (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits) : cp_errors::bits::DelimitString);
+        return false;
+    }
+    uint8_t sequence[8];
+    utf_text encoded;
+    encoded.length = 8;
+    encoded.offset = 0;
+    encoded.buffer = sequence;
+    uint32_t written = 0;
+    if (handler.set(encoded, unicode, written).error() || (written != bytes) || (::memcmp(&text.buffer[text.offset], sequence, bytes) != 0))
+    {   //  overlong or otherwise irregular sequences that are transcoded are re-encoded
+        return false;
+    }
+    text.offset += bytes;
+    return true;
+}
+
+static uint32_t verbatimSanitize(const IUTFTK& handler, const utf_text& src, const sanitize_policy& policy) noexcept
+{   //  returns the offset of the first code-point that sanitize() would not copy unchanged (src.length if there are none)
+    const UTF_SUB_TYPE sub_type = handler.utfSubType();
+    if (((src.length | src.offset) & (handler.unitSize() - 1)) != 0)
+    {   //  misaligned buffers are left to sanitize() to report
+        return src.offset;
     }
-    else if (!unicodeToCP1252(unicode, cp1252, (strict ? CP1252Strictness::StrictUndefined : CP1252Strictness::WindowsCompatible)))
+    utf_text text = src;
+    sanitize_scan scan = { text.offset, text.offset };
+    while (text.offset < text.length)
     {
-        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable);
-        if (unicode >= 0x0000d800u)
+        text.offset += cleanSpan(sub_type, text, scan);
+        if ((text.offset < text.length) && !verbatimStep(handler, text, policy))
         {
-            if (unicode > 0x0010ffffu)
-            {
-                errors |= cp_errors::bits::ExtendedUCS4;
-            }
-            else if (unicode >= 0x0000fdd0u)
-            {
-                if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-                {
-                    errors |= cp_errors::bits::NonCharacter;
-                }
-                if (unicode > 0x0000ffffu)
-                {
-                    errors |= cp_errors::bits::Supplementary;
-                }
-            }
-            else if ((unicode & 0xfffff800u) == 0x0000d800u)
-            {
-                errors |= ((unicode & 0x00000400u) ? cp_errors::bits::LowSurrogate : cp_errors::bits::HighSurrogate);
-            }
+            break;
         }
     }
-    if (errors.no_error())
+    return text.offset;
+}
+
+static uint32_t verbatimNLF(const IUTFTK& handler, const utf_text& src, const uint8_t* const sequence, const uint32_t size, cp_errors& errors) noexcept
+{   //  returns the offset of the first code-point that normalizeNLF() would not copy unchanged (src.length if there are none), the
+    //  warnings of the code-points read are added to errors
+    const UTF_SUB_TYPE sub_type = handler.utfSubType();
+    utf_text text = src;
+    while (text.offset < text.length)
     {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < 1)
-        {   //  buffer overflow
-            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        text.offset += lineSpan(sub_type, &text.buffer[text.offset], (text.length - text.offset));
+        if (text.offset >= text.length)
+        {
+            break;
         }
-        else
+        unicode_t unicode;
+        uint32_t bytes = 0;
+        const cp_errors decoded = handler.getNLF(text, unicode, bytes);
+        if (decoded.error() || ((unicode == 0x000au) && ((bytes != size) || (::memcmp(&text.buffer[text.offset], sequence, size) != 0))))
         {
-            uint8_t* const buffer = &text.buffer[text.offset];
-            buffer[0] = cp1252;
-            bytes = 1;
+            break;
         }
+        errors |= decoded;
+        text.offset += bytes;
     }
-    return errors;
+    return text.offset;
 }
 
-// ==== low level code-point decoding functions ====
+static void copyVerbatim(utf_text& src, utf_text& dst, const uint32_t verbatim) noexcept
+{   //  copies the bytes before verbatim in one pass if they fit in dst (otherwise the caller writes them as it would without borrowing)
+    const uint32_t span = (verbatim - src.offset);
+    if (span <= (dst.length - dst.offset))
+    {
+        ::memcpy(&dst.buffer[dst.offset], &src.buffer[src.offset], span);
+        src.offset += span;
+        dst.offset += span;
+    }
+}
 
-[[nodiscard]] cp_errors decodeBYTE(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool use_ascii, const bool coalesce) noexcept
+// ==== position index helpers ====
+
+inline bool isLineBreak(const uint8_t byte) noexcept
 {
-    bytes = 0;
-    unicode = 0;
-    cp_errors errors = get_errors(text);
-    if (errors.no_error())
+    return ((byte == 0x0au) || (byte == 0x0du));
+}
+
+uint32_t unitsUTF8(const uint8_t* const buffer, const uint32_t size) noexcept
+{   //  counts the UTF16 code-units of a span without line breaks (each byte rejected by getUTF8() counts as 1)
+    uint32_t units = 0;
+    uint32_t offset = 0;
+    while (offset < size)
     {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < 1)
-        {   //  buffer over-run
-            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
-        }
-        else
+        const uint32_t span = simd::validSpanUTF8(&buffer[offset], size - offset);
+        units += (simd::sizeUTF16fromUTF8(&buffer[offset], span) >> 1);
+        offset += span;
+        if (offset < size)
         {
-            uint8_t* const buffer = &text.buffer[text.offset];
-            unicode = static_cast<unicode_t>(buffer[0]);
-            bytes = 1;
-            if (use_ascii && (unicode & 0x00000080u))
-            {
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable | cp_errors::bits::DisallowedByte);
-                if (coalesce)
-                {
-                    uint32_t count = limit;
-                    for (uint32_t index = 1; index < count; ++index)
-                    {
-                        if ((buffer[index] & 0x80u) != 0x80u)
-                        {
-                            count = index;
-                            break;
-                        }
-                    }
-                    bytes = count;
-                }
-            }
-            else if (unicode == 0x00000000u)
-            {
-                errors |= cp_errors::bits::DelimitString;
-            }
+            ++units;
+            ++offset;
         }
     }
-    return errors;
+    return units;
 }
 
-[[nodiscard]] cp_errors decodeUTF8(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool use_cesu, const bool use_java, const bool strict, const bool coalesce) noexcept
-{
-    bytes = 0;
-    unicode = 0;
-    cp_errors errors = get_errors(text);
-    if (errors.no_error())
+uint32_t columnUTF8(const uint8_t* const buffer, uint32_t offset, const uint32_t limit, const uint32_t target, const uint32_t end, uint32_t& column) noexcept
+{   //  advances a sequence at a time until limit, a line break or the column target, returns the offset reached
+    while ((offset < limit) && (column < target))
     {
-        const uint32_t limit = (text.length - text.offset);
-        uint8_t* const buffer = &text.buffer[text.offset];
-        errors |= internal::fetchUTF8(buffer, limit, unicode, bytes, (coalesce && !strict));
-        if (errors.no_error())
-        {   //  successfully read a UTF8 code-point
-            if (unicode >= 0x0000d800u)
-            {
-                if (unicode > 0x0010ffffu)
-                {
-                    errors |= cp_errors::bits::ExtendedUCS4;
-                }
-                else if (unicode >= 0x0000fdd0u)
-                {
-                    if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-                    {
-                        errors |= cp_errors::bits::NonCharacter;
-                    }
-                    if (unicode > 0x0000ffffu)
-                    {
-                        errors |= cp_errors::bits::Supplementary;
-                    }
-                }
-                else if ((unicode & 0xfffff800u) == 0x0000d800u)
-                {   //  found a surrogate
-                    if (unicode & 0x00000400u)
-                    {   //  found an unpaired low surrogate
-                        errors |= cp_errors::bits::LowSurrogate;
-                    }
-                    else
-                    {   //  found an unpaired or leading high surrogate
-                        errors |= cp_errors::bits::HighSurrogate;
-                        if (use_cesu)
-                        {   //  found a leading high surrogate
-                            uint32_t extra = 0;
-                            unicode_t lowbits = 0;
-                            cp_errors check = internal::fetchUTF8(&buffer[bytes], (limit - bytes), lowbits, extra, false);
-                            if (check & (cp_errors::bits::ReadTruncated | cp_errors::bits::ReadExhausted))
-                            {
-                                errors |= cp_errors::bits::TruncatedPair;
-                            }
-                            else if (check.no_error())
-                            {
-                                if ((lowbits & 0xfffffc00u) == 0x0000dc00u)
-                                {   //  found low surrogate (valid surrogate pair)
-                                    unicode = (((unicode & 0x000003ffu) << 10) + (lowbits & 0x000003ffu) + 0x00010000u);
-                                    bytes += extra;
-                                    errors |= check;
-                                    errors ^= (cp_errors::bits::SurrogatePair | cp_errors::bits::Supplementary | cp_errors::bits::HighSurrogate);
-                                    if ((unicode & 0x0000fffeu) == 0x0000fffeu)
-                                    {
-                                        errors |= cp_errors::bits::NonCharacter;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            else if ((unicode == 0x00000000u) && (errors.none(cp_errors::bits::ModifiedUTF8 | cp_errors::bits::OverlongUTF8)))
-            {
-                errors |= cp_errors::bits::DelimitString;
-            }
-            if (errors.any((use_java ? cp_errors::bits::None : cp_errors::bits::ModifiedUTF8) | (cp_errors::bits::OverlongUTF8 | cp_errors::bits::ExtendedUTF8 | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::HighSurrogate | cp_errors::bits::LowSurrogate)))
+        const uint8_t byte = buffer[offset];
+        if (byte < 0x80u)
+        {
+            if (isLineBreak(byte))
             {
-                errors |= cp_errors::bits::IrregularForm;
-                if (strict)
-                {
-                    errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable);
-                    unicode = static_cast<unicode_t>(buffer[0]);
-                    bytes = 1;
-                }
+                break;
             }
+            ++column;
+            ++offset;
+            continue;
         }
-        else if (strict && (bytes > 1))
+        unicode_t unicode = 0;
+        uint32_t bytes = 0;
+        const uint32_t units = (std::getUTF8(&buffer[offset], end - offset, unicode, bytes) && (bytes == 4)) ? 2 : 1;
+        if (((offset + bytes) > limit) || ((column + units) > target))
         {
-            bytes = 1;
+            break;
         }
+        column += units;
+        offset += bytes;
     }
-    return errors;
+    return offset;
 }
 
-[[nodiscard]] cp_errors decodeUTF16(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool le, const bool use_ucs2) noexcept
+};  //  namespace internal
+
+// ==== encoded code-point length functions ====
+
+uint32_t lenUTF8(const unicode_t unicode, const bool use_cesu, const bool use_java) noexcept
 {
-    bytes = 0;
-    unicode = 0;
-    cp_errors errors = get_errors(text, 1);
-    if (errors.no_error())
-    {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < 2)
-        {   //  buffer over-run
-            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+    uint32_t bytes = 0;
+    if (static_cast<uint32_t>(unicode) <= 0x7fffffffu)
+    {   //  is an encodable unicode value
+        if (unicode <= 0x0000007fu)
+        {   //  1 byte (7 bits)
+            bytes = ((use_java && (unicode == 0x00000000u)) ? 2 : 1);
         }
-        else
-        {
-            uint8_t* const buffer = &text.buffer[text.offset];
-            unicode = (le ? ((static_cast<unicode_t>(buffer[1]) << 8) + buffer[0]) : ((static_cast<unicode_t>(buffer[0]) << 8) + buffer[1]));
+        else if (unicode <= 0x000007ffu)
+        {   //  2 bytes (11 bits)
             bytes = 2;
-            if (unicode >= 0x0000d800u)
-            {
-                if (unicode >= 0x0000fdd0u)
-                {
-                    if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-                    {
-                        errors |= cp_errors::bits::NonCharacter;
-                    }
-                }
-                else if ((unicode & 0xfffff800u) == 0x0000d800u)
-                {   //  found a surrogate
-                    errors |= cp_errors::bits::IrregularForm;
-                    if (unicode & 0x00000400u)
-                    {   //  found an unpaired low surrogate
-                        errors |= cp_errors::bits::LowSurrogate;
-                    }
-                    else
-                    {   //  found an unpaired or leading high surrogate
-                        errors |= cp_errors::bits::HighSurrogate;
-                        if (!use_ucs2)
-                        {   //  found a leading high surrogate
-                            if (limit < 4)
-                            {   //  truncated surrogate pair
-                                errors |= cp_errors::bits::TruncatedPair;
-                            }
-                            else
-                            {
-                                unicode_t lowbits = (le ? ((static_cast<unicode_t>(buffer[3]) << 8) + buffer[2]) : ((static_cast<unicode_t>(buffer[2]) << 8) + buffer[3]));
-                                if ((lowbits & 0xfffffc00u) == 0x0000dc00u)
-                                {   //  found low surrogate (valid surrogate pair)
-                                    unicode = (((unicode & 0x000003ffu) << 10) + (lowbits & 0x000003ffu) + 0x00010000u);
-                                    bytes = 4;
-                                    errors ^= (cp_errors::bits::SurrogatePair | cp_errors::bits::Supplementary | cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm);
-                                    if ((unicode & 0x0000fffeu) == 0x0000fffeu)
-                                    {
-                                        errors |= cp_errors::bits::NonCharacter;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            else if (unicode == 0x00000000u)
-            {
-                errors |= cp_errors::bits::DelimitString;
-            }
+        }
+        else if (unicode <= 0x0000ffffu)
+        {   //  3 bytes (16 bits)
+            bytes = 3;
+        }
+        else if (unicode <= 0x0010ffffu)
+        {   //  4 bytes (standard UTF8: 21 bits) or 6 bytes (CESU UTF8: UTF16 surrogates encoded as 2 UTF8 characters)
+            bytes = (use_cesu ? 6 : 4);
+        }
+        else if (unicode <= 0x001fffffu)
+        {   //  4 bytes (21 bits)
+            bytes = 4;
+        }
+        else if (unicode <= 0x03ffffffu)
+        {   //  5 bytes (26 bits)
+            bytes = 5;
+        }
+        else
+        {   //  6 bytes (31 bits)
+            bytes = 6;
         }
     }
-    return errors;
+    return bytes;
 }
 
-[[nodiscard]] cp_errors decodeUTF32(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool le, const bool use_cesu, const bool use_ucs4) noexcept
+uint32_t lenUTF16(const unicode_t unicode, const bool use_ucs2) noexcept
 {
-    bytes = 0;
-    unicode = 0;
-    cp_errors errors = get_errors(text, 3);
-    if (errors.no_error())
+    uint32_t bytes = 0;
+    if (static_cast<uint32_t>(unicode) <= 0x0010ffffu)
     {
-        const uint32_t limit = (text.length - text.offset);
-        uint8_t* const buffer = &text.buffer[text.offset];
-        if (limit < 4)
-        {   //  buffer over-run
-            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+        if (unicode <= 0x0000ffffu)
+        {
+            bytes = 2;
         }
-        else
+        else if (!use_ucs2)
         {
-            unicode = (le ?
-                ((((((static_cast<unicode_t>(buffer[3]) << 8) + buffer[2]) << 8) + buffer[1]) << 8) + buffer[0]) :
-                ((((((static_cast<unicode_t>(buffer[0]) << 8) + buffer[1]) << 8) + buffer[2]) << 8) + buffer[3]));
             bytes = 4;
-            if (unicode <= 0x00000000u)
-            {
-                errors |= (unicode ? (cp_errors::bits::InvalidPoint | cp_errors::bits::IrregularForm) : cp_errors::bits::DelimitString);
-            }
-            else if (unicode >= 0x0000d800u)
-            {
-                if (unicode > 0x0010ffffu)
-                {
-                    errors |= (use_ucs4 ? cp_errors::bits::ExtendedUCS4 : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
-                }
-                else if (unicode >= 0x0000fdd0u)
-                {
-                    if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
-                    {
-                        errors |= cp_errors::bits::NonCharacter;
-                    }
-                    if (unicode > 0x0000ffffu)
-                    {
-                        errors |= cp_errors::bits::Supplementary;
-                    }
-                }
-                else if ((unicode & 0xfffff800u) == 0x0000d800u)
-                {   //  found a surrogate
-                    errors |= cp_errors::bits::IrregularForm;
-                    if (unicode & 0x00000400u)
-                    {   //  found an unpaired low surrogate
-                        errors |= cp_errors::bits::LowSurrogate;
-                    }
-                    else
-                    {   //  found an unpaired or leading high surrogate
-                        errors |= cp_errors::bits::HighSurrogate;
-                        if (use_cesu)
-                        {   //  found a leading high surrogate
-                            if (limit < 8)
-                            {   //  truncated surrogate pair
-                                errors |= cp_errors::bits::TruncatedPair;
-                            }
-                            else
-                            {
-                                unicode_t lowbits = (le ?
-                                    ((((((static_cast<unicode_t>(buffer[7]) << 8) + buffer[6]) << 8) + buffer[5]) << 8) + buffer[4]) :
-                                    ((((((static_cast<unicode_t>(buffer[4]) << 8) + buffer[5]) << 8) + buffer[6]) << 8) + buffer[7]));
-                                if ((lowbits & 0xfffffc00u) == 0x0000dc00u)
-                                {   //  found low surrogate (valid surrogate pair)
-                                    unicode = (((unicode & 0x000003ffu) << 10) + (lowbits & 0x000003ffu) + 0x00010000u);
-                                    bytes = 8;
-                                    errors ^= (cp_errors::bits::SurrogatePair | cp_errors::bits::Supplementary | cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm);
-                                    if ((unicode & 0x0000fffeu) == 0x0000fffeu)
-                                    {
-                                        errors |= cp_errors::bits::NonCharacter;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
         }
     }
-    return errors;
+    return bytes;
 }
 
-[[nodiscard]] cp_errors decodeCP1252(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool strict, const bool coalesce) noexcept
+uint32_t lenUTF32(const unicode_t unicode, const bool use_cesu, const bool use_ucs4) noexcept
+{
+    uint32_t bytes = 0;
+    if (static_cast<uint32_t>(unicode) <= uint32_t(use_ucs4 ? 0x7fffffffu : 0x0010ffffu))
+    {
+        bytes = ((use_cesu && (unicode >= 0x00010000u) && (unicode <= 0x0010ffffu)) ? 8 : 4);
+    }
+    return bytes;
+}
+
+// ==== low level code-point encoding functions ====
+
+[[nodiscard]] cp_errors encodeBYTE(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool use_ascii) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::encodeFunction kernels[2] =
+    {
+        &encodeBYTE<false>,
+        &encodeBYTE<true>
+    };
+    return kernels[(use_ascii ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors encodeUTF8(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool use_cesu, const bool use_java) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::encodeFunction kernels[4] =
+    {
+        &encodeUTF8<false, false>,
+        &encodeUTF8<false, true>,
+        &encodeUTF8<true, false>,
+        &encodeUTF8<true, true>
+    };
+    return kernels[(use_cesu ? 2u : 0u) | (use_java ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors encodeUTF8n(utf_text& text, const unicode_t unicode, const uint32_t bytes, const bool use_java) noexcept
 {
-    bytes = 0;
-    unicode = 0;
     cp_errors errors = get_errors(text);
-    if (errors.no_error())
+    if (static_cast<uint32_t>(bytes - 1) < 6)
     {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < 1)
-        {   //  buffer over-run
-            errors |= (limit ? (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated) : cp_errors::bits::ReadExhausted);
+        if (unicode == 0x00000000u)
+        {
+            errors |= ((bytes < 2) ? cp_errors::bits::DelimitString : ((bytes > 2) ? (cp_errors::bits::OverlongUTF8 | cp_errors::bits::IrregularForm) : (use_java ? cp_errors::bits::ModifiedUTF8 : (cp_errors::bits::ModifiedUTF8 | cp_errors::bits::IrregularForm))));
         }
         else
         {
-            CP1252Strictness strictness = strict ? CP1252Strictness::StrictUndefined : CP1252Strictness::WindowsCompatible;
-            uint8_t* const buffer = &text.buffer[text.offset];
-            uint8_t cp1252 = buffer[0];
-            bytes = 1;
-            if (!cp1252ToUnicode(cp1252, unicode, strictness))
+            int32_t n = (static_cast<int32_t>(bytes | (bytes << 2)) - 6);
+            if ((unicode >> static_cast<uint32_t>((n & ((~n) >> 31)) + 7)) != 0)
             {
-                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotDecodable);
-                if (coalesce)
-                {
-                    uint32_t count = limit;
-                    for (uint32_t index = 1; index < count; ++index)
-                    {
-                        cp1252 = buffer[index];
-                        if (cp1252ToUnicode(cp1252, unicode, strictness))
-                        {
-                            unicode = 0;
-                            count = index;
-                            break;
-                        }
-                    }
-                    bytes = count;
-                }
+                errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::NotEnoughBits);
             }
-            else if (unicode == 0x00000000u)
+            else if (bytes > 1)
             {
-                errors |= cp_errors::bits::DelimitString;
+                n -= 5;
+                if ((unicode >> static_cast<uint32_t>((n & ((~n) >> 31)) + 7)) == 0)
+                {
+                    errors |= (cp_errors::bits::OverlongUTF8 | cp_errors::bits::IrregularForm);
+                }
             }
         }
     }
-    return errors;
-}
-
-// ==== low level utf byte order marker and NULL code-point fast encoding functions ====
-
-[[nodiscard]] cp_errors encodeUTF8_BOM(utf_text& text, uint32_t& bytes) noexcept
-{
-    bytes = 0;
-    cp_errors errors = get_errors(text);
-    if (errors.no_error())
+    else
     {
-        const uint32_t limit = (text.length - text.offset);
-        if (limit < 3)
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::BadSizeUTF8);
+    }
+    if (unicode < 0x00000000u)
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::NotEncodable | cp_errors::bits::InvalidPoint | cp_errors::bits::NotEnoughBits);
+    }
+    else if (unicode >= 0x0000d800u)
+    {
+        if (unicode > 0x0010ffffu)
+        {
+            errors |= ((unicode > 0x001fffffu) ? (cp_errors::bits::ExtendedUTF8 | cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm) : (cp_errors::bits::ExtendedUCS4 | cp_errors::bits::IrregularForm));
+        }
+        else if (unicode >= 0x0000fdd0u)
+        {
+            if ((unicode <= 0x0000fdefu) || ((unicode & 0x0000fffeu) == 0x0000fffeu))
+            {
+                errors |= cp_errors::bits::NonCharacter;
+            }
+            if (unicode > 0x0000ffffu)
+            {
+                errors |= cp_errors::bits::Supplementary;
+            }
+        }
+        else if ((unicode & 0xfffff800u) == 0x0000d800u)
+        {
+            errors |= ((unicode & 0x00000400u) ? (cp_errors::bits::LowSurrogate | cp_errors::bits::IrregularForm) : (cp_errors::bits::HighSurrogate | cp_errors::bits::IrregularForm));
+        }
+    }
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < bytes)
+        {   //  buffer overflow
+            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        }
+        else
+        {
+            uint8_t* const buffer = &text.buffer[text.offset];
+            unicode_t value = unicode;
+            for (uint32_t index = (bytes - 1); index; --index)
+            {
+                buffer[index] = ((static_cast<uint8_t>(value) & 0x3fu) | 0x80u);
+                value >>= 6;
+            }
+            uint8_t mask = ((bytes > 1) ? (0x7fu >> bytes) : 0x7fu);
+            buffer[0] = ((static_cast<uint8_t>(value) & mask) | (~mask << 1));
+        }
+    }
+    return errors;
+}
+
+[[nodiscard]] cp_errors encodeUTF16(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool le, const bool use_ucs2) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::encodeFunction kernels[4] =
+    {
+        &encodeUTF16<false, false>,
+        &encodeUTF16<false, true>,
+        &encodeUTF16<true, false>,
+        &encodeUTF16<true, true>
+    };
+    return kernels[(le ? 2u : 0u) | (use_ucs2 ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors encodeUTF32(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool le, const bool use_cesu, const bool use_ucs4) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::encodeFunction kernels[8] =
+    {
+        &encodeUTF32<false, false, false>,
+        &encodeUTF32<false, false, true>,
+        &encodeUTF32<false, true, false>,
+        &encodeUTF32<false, true, true>,
+        &encodeUTF32<true, false, false>,
+        &encodeUTF32<true, false, true>,
+        &encodeUTF32<true, true, false>,
+        &encodeUTF32<true, true, true>
+    };
+    return kernels[(le ? 4u : 0u) | (use_cesu ? 2u : 0u) | (use_ucs4 ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors encodeCP1252(utf_text& text, const unicode_t unicode, uint32_t& bytes, const bool strict) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::encodeFunction kernels[2] =
+    {
+        &encodeCP1252<false>,
+        &encodeCP1252<true>
+    };
+    return kernels[(strict ? 1u : 0u)](text, unicode, bytes);
+}
+
+// ==== low level code-point decoding functions ====
+
+[[nodiscard]] cp_errors decodeBYTE(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool use_ascii, const bool coalesce) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::decodeFunction kernels[4] =
+    {
+        &decodeBYTE<false, false>,
+        &decodeBYTE<false, true>,
+        &decodeBYTE<true, false>,
+        &decodeBYTE<true, true>
+    };
+    return kernels[(use_ascii ? 2u : 0u) | (coalesce ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors decodeUTF8(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool use_cesu, const bool use_java, const bool strict, const bool coalesce) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::decodeFunction kernels[16] =
+    {
+        &decodeUTF8<false, false, false, false>,
+        &decodeUTF8<false, false, false, true>,
+        &decodeUTF8<false, false, true, false>,
+        &decodeUTF8<false, false, true, true>,
+        &decodeUTF8<false, true, false, false>,
+        &decodeUTF8<false, true, false, true>,
+        &decodeUTF8<false, true, true, false>,
+        &decodeUTF8<false, true, true, true>,
+        &decodeUTF8<true, false, false, false>,
+        &decodeUTF8<true, false, false, true>,
+        &decodeUTF8<true, false, true, false>,
+        &decodeUTF8<true, false, true, true>,
+        &decodeUTF8<true, true, false, false>,
+        &decodeUTF8<true, true, false, true>,
+        &decodeUTF8<true, true, true, false>,
+        &decodeUTF8<true, true, true, true>
+    };
+    return kernels[(use_cesu ? 8u : 0u) | (use_java ? 4u : 0u) | (strict ? 2u : 0u) | (coalesce ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors decodeUTF16(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool le, const bool use_ucs2) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::decodeFunction kernels[4] =
+    {
+        &decodeUTF16<false, false>,
+        &decodeUTF16<false, true>,
+        &decodeUTF16<true, false>,
+        &decodeUTF16<true, true>
+    };
+    return kernels[(le ? 2u : 0u) | (use_ucs2 ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors decodeUTF32(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool le, const bool use_cesu, const bool use_ucs4) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::decodeFunction kernels[8] =
+    {
+        &decodeUTF32<false, false, false>,
+        &decodeUTF32<false, false, true>,
+        &decodeUTF32<false, true, false>,
+        &decodeUTF32<false, true, true>,
+        &decodeUTF32<true, false, false>,
+        &decodeUTF32<true, false, true>,
+        &decodeUTF32<true, true, false>,
+        &decodeUTF32<true, true, true>
+    };
+    return kernels[(le ? 4u : 0u) | (use_cesu ? 2u : 0u) | (use_ucs4 ? 1u : 0u)](text, unicode, bytes);
+}
+
+[[nodiscard]] cp_errors decodeCP1252(const utf_text& text, unicode_t& unicode, uint32_t& bytes, const bool strict, const bool coalesce) noexcept
+{   //  dispatches to the compile-time specialised kernel
+    static const internal::decodeFunction kernels[4] =
+    {
+        &decodeCP1252<false, false>,
+        &decodeCP1252<false, true>,
+        &decodeCP1252<true, false>,
+        &decodeCP1252<true, true>
+    };
+    return kernels[(strict ? 2u : 0u) | (coalesce ? 1u : 0u)](text, unicode, bytes);
+}
+
+// ==== low level code-point block decoding and encoding functions ====
+
+[[nodiscard]] cp_errors decodeBlockBYTE(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool use_ascii, const bool coalesce) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::decodeBlockFunction loops[4] =
+    {
+        &internal::decodeBlock<&decodeBYTE<false, false>, true>,
+        &internal::decodeBlock<&decodeBYTE<false, true>, true>,
+        &internal::decodeBlock<&decodeBYTE<true, false>, true>,
+        &internal::decodeBlock<&decodeBYTE<true, true>, true>
+    };
+    return loops[(use_ascii ? 2u : 0u) | (coalesce ? 1u : 0u)](text, unicodes, capacity, count, bytes, failed);
+}
+
+[[nodiscard]] cp_errors decodeBlockUTF8(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool use_cesu, const bool use_java, const bool strict, const bool coalesce) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::decodeBlockFunction loops[16] =
+    {
+        &internal::decodeBlock<&decodeUTF8<false, false, false, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, false, false, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, false, true, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, false, true, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, true, false, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, true, false, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, true, true, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<false, true, true, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, false, false, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, false, false, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, false, true, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, false, true, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, true, false, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, true, false, true>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, true, true, false>, true>,
+        &internal::decodeBlock<&decodeUTF8<true, true, true, true>, true>
+    };
+    return loops[(use_cesu ? 8u : 0u) | (use_java ? 4u : 0u) | (strict ? 2u : 0u) | (coalesce ? 1u : 0u)](text, unicodes, capacity, count, bytes, failed);
+}
+
+[[nodiscard]] cp_errors decodeBlockUTF16(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool le, const bool use_ucs2) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::decodeBlockFunction loops[4] =
+    {
+        &internal::decodeBlock<&decodeUTF16<false, false>, false>,
+        &internal::decodeBlock<&decodeUTF16<false, true>, false>,
+        &internal::decodeBlock<&decodeUTF16<true, false>, false>,
+        &internal::decodeBlock<&decodeUTF16<true, true>, false>
+    };
+    return loops[(le ? 2u : 0u) | (use_ucs2 ? 1u : 0u)](text, unicodes, capacity, count, bytes, failed);
+}
+
+[[nodiscard]] cp_errors decodeBlockUTF32(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool le, const bool use_cesu, const bool use_ucs4) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::decodeBlockFunction loops[8] =
+    {
+        &internal::decodeBlock<&decodeUTF32<false, false, false>, false>,
+        &internal::decodeBlock<&decodeUTF32<false, false, true>, false>,
+        &internal::decodeBlock<&decodeUTF32<false, true, false>, false>,
+        &internal::decodeBlock<&decodeUTF32<false, true, true>, false>,
+        &internal::decodeBlock<&decodeUTF32<true, false, false>, false>,
+        &internal::decodeBlock<&decodeUTF32<true, false, true>, false>,
+        &internal::decodeBlock<&decodeUTF32<true, true, false>, false>,
+        &internal::decodeBlock<&decodeUTF32<true, true, true>, false>
+    };
+    return loops[(le ? 4u : 0u) | (use_cesu ? 2u : 0u) | (use_ucs4 ? 1u : 0u)](text, unicodes, capacity, count, bytes, failed);
+}
+
+[[nodiscard]] cp_errors decodeBlockCP1252(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed, const bool strict, const bool coalesce) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::decodeBlockFunction loops[4] =
+    {
+        &internal::decodeBlock<&decodeCP1252<false, false>, true>,
+        &internal::decodeBlock<&decodeCP1252<false, true>, true>,
+        &internal::decodeBlock<&decodeCP1252<true, false>, true>,
+        &internal::decodeBlock<&decodeCP1252<true, true>, true>
+    };
+    return loops[(strict ? 2u : 0u) | (coalesce ? 1u : 0u)](text, unicodes, capacity, count, bytes, failed);
+}
+
+[[nodiscard]] cp_errors encodeBlockBYTE(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_ascii) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::encodeBlockFunction loops[2] =
+    {
+        &internal::encodeBlock<&encodeBYTE<false>>,
+        &internal::encodeBlock<&encodeBYTE<true>>
+    };
+    return loops[(use_ascii ? 1u : 0u)](text, unicodes, length, count, bytes);
+}
+
+[[nodiscard]] cp_errors encodeBlockUTF8(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool use_cesu, const bool use_java) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::encodeBlockFunction loops[4] =
+    {
+        &internal::encodeBlock<&encodeUTF8<false, false>>,
+        &internal::encodeBlock<&encodeUTF8<false, true>>,
+        &internal::encodeBlock<&encodeUTF8<true, false>>,
+        &internal::encodeBlock<&encodeUTF8<true, true>>
+    };
+    return loops[(use_cesu ? 2u : 0u) | (use_java ? 1u : 0u)](text, unicodes, length, count, bytes);
+}
+
+[[nodiscard]] cp_errors encodeBlockUTF16(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool le, const bool use_ucs2) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::encodeBlockFunction loops[4] =
+    {
+        &internal::encodeBlock<&encodeUTF16<false, false>>,
+        &internal::encodeBlock<&encodeUTF16<false, true>>,
+        &internal::encodeBlock<&encodeUTF16<true, false>>,
+        &internal::encodeBlock<&encodeUTF16<true, true>>
+    };
+    return loops[(le ? 2u : 0u) | (use_ucs2 ? 1u : 0u)](text, unicodes, length, count, bytes);
+}
+
+[[nodiscard]] cp_errors encodeBlockUTF32(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool le, const bool use_cesu, const bool use_ucs4) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::encodeBlockFunction loops[8] =
+    {
+        &internal::encodeBlock<&encodeUTF32<false, false, false>>,
+        &internal::encodeBlock<&encodeUTF32<false, false, true>>,
+        &internal::encodeBlock<&encodeUTF32<false, true, false>>,
+        &internal::encodeBlock<&encodeUTF32<false, true, true>>,
+        &internal::encodeBlock<&encodeUTF32<true, false, false>>,
+        &internal::encodeBlock<&encodeUTF32<true, false, true>>,
+        &internal::encodeBlock<&encodeUTF32<true, true, false>>,
+        &internal::encodeBlock<&encodeUTF32<true, true, true>>
+    };
+    return loops[(le ? 4u : 0u) | (use_cesu ? 2u : 0u) | (use_ucs4 ? 1u : 0u)](text, unicodes, length, count, bytes);
+}
+
+[[nodiscard]] cp_errors encodeBlockCP1252(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes, const bool strict) noexcept
+{   //  dispatches to the compile-time specialised block loop
+    static const internal::encodeBlockFunction loops[2] =
+    {
+        &internal::encodeBlock<&encodeCP1252<false>>,
+        &internal::encodeBlock<&encodeCP1252<true>>
+    };
+    return loops[(strict ? 1u : 0u)](text, unicodes, length, count, bytes);
+}
+
+// ==== low level utf byte order marker and NULL code-point fast encoding functions ====
+
+[[nodiscard]] cp_errors encodeUTF8_BOM(utf_text& text, uint32_t& bytes) noexcept
+{
+    bytes = 0;
+    cp_errors errors = get_errors(text);
+    if (errors.no_error())
+    {
+        const uint32_t limit = (text.length - text.offset);
+        if (limit < 3)
         {   //  buffer overflow
             errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
         }
@@ -1798,6 +2252,8 @@ uint32_t backUTF8(utf_text& text, const uint32_t count, const bool use_cesu, con
         uint32_t limit = offset;
         uint32_t bytes = 0;
         uint32_t extra = 0;
+        uint32_t slow = 0;
+        const bool fast = (!use_cesu && !strict);
         while ((points < count) && (limit > 0))
         {
             if (bytes)
@@ -1809,6 +2265,20 @@ uint32_t backUTF8(utf_text& text, const uint32_t count, const bool use_cesu, con
             }
             else
             {
+                if (fast && (slow == 0) && (limit >= internal::kSkipBlock))
+                {   //  skip well-formed sequences with the bulk kernels
+                    uint32_t skipped = 0;
+                    const uint32_t span = internal::backSpanUTF8(buffer, offset, limit, count - points, skipped);
+                    points += skipped;
+                    offset -= span;
+                    limit -= span;
+                    if (span < internal::kSkipBlock)
+                    {   //  malformed bytes, use the scalar scanner for a while
+                        slow = internal::kSkipBlock;
+                    }
+                    continue;
+                }
+                slow -= ((slow != 0) ? 1 : 0);
                 strict ? internal::backSeqUTF8st(buffer, offset, limit, bytes, extra, use_cesu, use_java) : internal::backSeqUTF8(buffer, offset, limit, bytes, extra, use_cesu);
                 if (extra)
                 {
@@ -1848,6 +2318,8 @@ uint32_t stepUTF8(utf_text& text, const uint32_t count, const bool use_cesu, con
         uint32_t limit = (text.length - offset);
         uint32_t bytes = 0;
         uint32_t extra = 0;
+        uint32_t slow = 0;
+        const bool fast = (!use_cesu && !strict);
         while ((points < count) && (limit > 0))
         {
             if (extra)
@@ -1873,6 +2345,20 @@ uint32_t stepUTF8(utf_text& text, const uint32_t count, const bool use_cesu, con
             }
             else
             {
+                if (fast && (slow == 0) && (limit >= internal::kSkipBlock))
+                {   //  skip well-formed sequences with the bulk kernels
+                    uint32_t skipped = 0;
+                    const uint32_t span = internal::stepSpanUTF8(&buffer[offset], limit, count - points, skipped);
+                    points += skipped;
+                    offset += span;
+                    limit -= span;
+                    if (span < internal::kSkipBlock)
+                    {   //  malformed bytes, use the scalar scanner for a while
+                        slow = internal::kSkipBlock;
+                    }
+                    continue;
+                }
+                slow -= ((slow != 0) ? 1 : 0);
                 strict ? internal::stepSeqUTF8st(buffer, offset, limit, bytes, extra, use_cesu, use_java) : internal::stepSeqUTF8(buffer, offset, limit, bytes, extra, use_cesu);
                 if (bytes)
                 {
@@ -2317,6 +2803,134 @@ uint32_t stepCP1252(utf_text& text, const uint32_t count, const bool strict, con
     return errors;
 }
 
+[[nodiscard]] cp_errors IUTFTK::validate(const utf_text& text, uint32_t& failed, const uint32_t threads) const noexcept
+{   //  validates chunks of the buffer in parallel, the merged result is identical to the single threaded validate()
+    failed = 0;
+    cp_errors errors = get_errors(text);
+    if (errors.no_error())
+    {
+        uint32_t bounds[internal::kChunkLimit + 1];
+        internal::validate_chunk chunks[internal::kChunkLimit];
+        uint32_t workers = 0;
+        const uint32_t count = internal::splitChunks(*this, text, threads, workers, bounds);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            chunks[index].start = bounds[index];
+            chunks[index].end = bounds[index + 1];
+        }
+        internal::validate_job job = { *this, text, chunks };
+        internal::runChunks(job, count, workers);
+        uint32_t offset = text.offset;
+        for (uint32_t index = 0; index < count; ++index)
+        {   //  merge in order, a chunk that did not start where the previous chunk stopped is scanned again from there
+            internal::validate_chunk& merge = chunks[index];
+            if (merge.start != offset)
+            {
+                merge.start = offset;
+                internal::scanValidate(*this, text, merge);
+            }
+            errors |= merge.errors;
+            offset = merge.stop;
+            if (errors.error() || (offset >= text.length))
+            {
+                break;
+            }
+        }
+        failed = offset - text.offset;
+    }
+    return errors;
+}
+
+[[nodiscard]] cp_errors IUTFTK::decodeBlock(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed) const noexcept
+{   //  reads code-points until the buffer or the output is exhausted accumulating warnings and errors
+    count = 0;
+    bytes = 0;
+    failed = 0;
+    cp_errors errors = get_errors(text);
+    if ((unicodes == nullptr) && (capacity != 0))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
+    }
+    if (errors.no_error())
+    {
+        utf_text scan = text;
+        bool failing = false;
+        while ((scan.offset < scan.length) && (count < capacity))
+        {
+            unicode_t unicode = 0;
+            uint32_t extra = 0;
+            cp_errors check = get(scan, unicode, extra);
+            if (check.error() && !failing)
+            {   //  first failing sequence (keep its byte index)
+                failing = true;
+                failed = (scan.offset - text.offset);
+            }
+            else
+            {
+                check.set_byte_index(errors.get_byte_index());
+            }
+            errors |= check;
+            if (extra == 0)
+            {   //  buffer error
+                break;
+            }
+            unicodes[count] = unicode;
+            ++count;
+            scan.offset += extra;
+        }
+        bytes = (scan.offset - text.offset);
+        if (!failing)
+        {
+            failed = bytes;
+        }
+    }
+    return errors;
+}
+
+[[nodiscard]] cp_errors IUTFTK::encodeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept
+{   //  writes code-points until the input is exhausted accumulating warnings, fails immediately on any errors
+    count = 0;
+    bytes = 0;
+    cp_errors errors = get_errors(text);
+    if ((unicodes == nullptr) && (length != 0))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
+    }
+    if (errors.no_error())
+    {
+        utf_text scan = text;
+        while (count < length)
+        {
+            uint32_t extra = 0;
+            errors |= set(scan, unicodes[count], extra);
+            if (errors.error())
+            {
+                break;
+            }
+            ++count;
+            scan.offset += extra;
+        }
+        bytes = (scan.offset - text.offset);
+    }
+    return errors;
+}
+
+[[nodiscard]] cp_errors IUTFTK::readBlock(utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& failed) const noexcept
+{
+    uint32_t bytes = 0;
+    cp_errors errors = decodeBlock(text, unicodes, capacity, count, bytes, failed);
+    text.offset += bytes;
+    return errors;
+}
+
+[[nodiscard]] cp_errors IUTFTK::writeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count) const noexcept
+{
+    uint32_t bytes = 0;
+    cp_errors errors = encodeBlock(text, unicodes, length, count, bytes);
+    text.offset += bytes;
+    return errors;
+}
+
 [[nodiscard]] cp_errors IUTFTK::getNLF(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept
 {
     bytes = 0;
@@ -2376,13 +2990,15 @@ uint32_t stepCP1252(utf_text& text, const uint32_t count, const bool strict, con
     cp_errors errors = get_errors(text);
     if (errors.no_error())
     {
+        const UTF_SUB_TYPE sub_type = utfSubType();
         utf_text scan;
         scan.length = (text.length - text.offset);
         scan.offset = 0;
         scan.buffer = &text.buffer[text.offset];
         unicode_t unicode;
+        scan.offset = internal::lineSpan(sub_type, scan.buffer, scan.length);
         while ((errors |= getNLF(scan, unicode, bytes)).no_error())
-        {
+        {   //  only the candidates found by the bulk kernels are decoded
             if ((unicode == 0x000au) || (unicode == 0x0000u))
             {
                 bytes += scan.offset;
@@ -2392,6 +3008,7 @@ uint32_t stepCP1252(utf_text& text, const uint32_t count, const bool strict, con
                 break;
             }
             scan.offset += bytes;
+            scan.offset += internal::lineSpan(sub_type, &scan.buffer[scan.offset], (scan.length - scan.offset));
         };
     }
     return errors;
@@ -2405,502 +3022,960 @@ uint32_t stepCP1252(utf_text& text, const uint32_t count, const bool strict, con
     return errors;
 }
 
-// ==== concrete classes for encoded unicode code-point handling ====
-
-struct CUTF_UTF8 : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF8; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, false, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, false, false, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, false, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, false, false, true); }
-};
-
-struct CUTF_UTF8ns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF8ns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, false, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, false, false, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, false, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, false, false, false); }
-};
-
-struct CUTF_UTF8st : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF8st; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, false, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, false, false, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, false, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, false, true, false); }
-};
+// ==== multi-threaded transcoding function ====
 
-struct CUTF_JUTF8 : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::JUTF8; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, false, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, false, true, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, false, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, false, false, true); }
-};
+[[nodiscard]] cp_errors transcode(const IUTFTK& srcHandler, const IUTFTK& dstHandler, utf_text& src, utf_text& dst, const uint32_t threads) noexcept
+{   //  pass 1 sizes the chunks in parallel, a prefix sum places them and pass 2 encodes them in parallel directly into dst
+    cp_errors errors = get_errors(src);
+    errors |= get_errors(dst);
+    if (errors.no_error())
+    {
+        uint32_t bounds[internal::kChunkLimit + 1];
+        internal::transcode_chunk chunks[internal::kChunkLimit];
+        uint32_t workers = 0;
+        uint32_t count = internal::splitChunks(srcHandler, src, threads, workers, bounds);
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            chunks[index].start = bounds[index];
+            chunks[index].end = bounds[index + 1];
+            chunks[index].output = dst.offset;
+            chunks[index].limit = dst.length;
+        }
+        internal::transcode_job job = { srcHandler, dstHandler, src, dst, chunks, false };
+        uint32_t encoded = count;
+        if (count > 1)
+        {   //  pass 1: encoded chunk sizes and the prefix sum of the output offsets (up to the first chunk that fails), the chunks
+            //  are encoded concurrently so each is limited to its own output
+            internal::runChunks(job, count, workers);
+            uint64_t output = dst.offset;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                chunks[index].output = static_cast<uint32_t>((output < dst.length) ? output : dst.length);
+                output += chunks[index].size;
+                chunks[index].limit = static_cast<uint32_t>((output < dst.length) ? output : dst.length);
+                if (chunks[index].failed)
+                {
+                    encoded = index + 1;
+                    break;
+                }
+            }
+        }
+        job.encode = true;
+        internal::runChunks(job, encoded, workers);
+        uint32_t offset = src.offset;
+        uint32_t output = dst.offset;
+        bool serial = false;
+        for (uint32_t index = 0; index < count; ++index)
+        {   //  merge in order, a chunk that was not encoded where the previous chunk stopped is transcoded again from there (with
+            //  no limit, so the chunks after it are transcoded again too)
+            internal::transcode_chunk& merge = chunks[index];
+            if (serial || (index >= encoded) || (merge.start != offset) || (merge.output != output))
+            {
+                serial = true;
+                merge.start = offset;
+                merge.output = output;
+                merge.limit = dst.length;
+                internal::scanTranscode(srcHandler, dstHandler, src, dst, merge);
+            }
+            errors |= merge.errors;
+            offset = merge.stop;
+            output = merge.written;
+            if (errors.error() || (offset >= src.length))
+            {
+                break;
+            }
+        }
+        src.offset = offset;
+        dst.offset = output;
+    }
+    return errors;
+}
 
-struct CUTF_JUTF8ns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::JUTF8ns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, false, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, false, true, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, false, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, false, false, false); }
-};
+// ==== multi-threaded line table function ====
 
-struct CUTF_JUTF8st : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::JUTF8st; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, false, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, false, true, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, false, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, false, true, false); }
-};
+[[nodiscard]] cp_errors build_line_table(const IUTFTK& handler, const utf_text& text, uint32_t* const offsets, const uint32_t capacity, uint32_t& count, const uint32_t threads) noexcept
+{   //  pass 1 counts the line starts of the chunks in parallel, a prefix sum places them and pass 2 writes them in parallel
+    count = 0;
+    cp_errors errors = get_errors(text);
+    if (errors.no_error() && (text.offset < text.length))
+    {
+        uint32_t bounds[internal::kChunkLimit + 1];
+        internal::line_chunk chunks[internal::kChunkLimit];
+        uint32_t workers = 0;
+        uint32_t chunked = internal::splitChunks(handler, text, threads, workers, bounds);
+        for (uint32_t index = 0; index < chunked; ++index)
+        {
+            chunks[index].start = bounds[index];
+            chunks[index].end = bounds[index + 1];
+            chunks[index].output = 1;
+        }
+        internal::line_job job = { handler, text, offsets, capacity, chunks, false };
+        if (chunked > 1)
+        {   //  pass 1: line counts merged in order, a chunk that did not start where the previous chunk stopped (a CR LF
+            //  pair split by the boundary or coalesced invalid bytes) is counted again from there
+            internal::runChunks(job, chunked, workers);
+            uint32_t offset = text.offset;
+            uint32_t output = 1;
+            for (uint32_t index = 0; index < chunked; ++index)
+            {
+                internal::line_chunk& merge = chunks[index];
+                if (merge.start != offset)
+                {
+                    merge.start = offset;
+                    internal::scanLines(handler, text, merge, nullptr, 0);
+                }
+                merge.output = output;
+                output += merge.lines;
+                offset = merge.stop;
+                if (merge.errors.error() || (offset >= text.length))
+                {
+                    chunked = index + 1;
+                    break;
+                }
+            }
+        }
+        if ((offsets != nullptr) && (capacity != 0))
+        {
+            offsets[0] = text.offset;
+        }
+        job.write = true;
+        internal::runChunks(job, chunked, workers);
+        uint32_t lines = 1;
+        uint32_t last = text.offset;
+        for (uint32_t index = 0; index < chunked; ++index)
+        {
+            errors |= chunks[index].errors;
+            lines += chunks[index].lines;
+            last = (chunks[index].last ? chunks[index].last : last);
+        }
+        if (errors.error())
+        {   //  the line with the failing code-point is not read
+            --lines;
+        }
+        else if (last < text.length)
+        {   //  the last line is not terminated so reading it reads the end of the text (cp_errors::bits::ReadExhausted)
+            utf_text end = text;
+            end.offset = text.length;
+            unicode_t unicode;
+            uint32_t bytes = 0;
+            errors |= handler.getNLF(end, unicode, bytes);
+        }
+        if ((offsets != nullptr) && (lines > capacity))
+        {   //  a null table only counts the lines
+            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        }
+        count = lines;
+    }
+    return errors;
+}
 
-struct CUTF_CESU8 : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU8; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, true, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, true, false, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, true, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, true, false, true); }
-};
+// ==== line ending normalisation functions ====
 
-struct CUTF_CESU8ns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU8ns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, true, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, true, false, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, true, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, true, false, false); }
-};
+[[nodiscard]] cp_errors normalizeLineEndings(const IUTFTK& handler, utf_text& src, utf_text& dst, const NLF_TYPE terminator) noexcept
+{   //  misaligned buffers fail before a span is copied, as the first getNLF() would
+    cp_errors errors = get_errors(src, (handler.unitSize() - 1));
+    errors |= get_errors(dst, (handler.unitSize() - 1));
+    if (errors.no_error())
+    {
+        uint8_t sequence[16];
+        uint32_t size = 0;
+        errors |= internal::encodeNLF(handler, terminator, sequence, size);
+        if (errors.no_error())
+        {
+            errors |= internal::normalizeNLF(handler, src, dst, sequence, size);
+        }
+    }
+    return errors;
+}
 
-struct CUTF_CESU8st : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU8st; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, true, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, true, false, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, true, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, true, true, false); }
-};
+[[nodiscard]] cp_errors normalizeLineEndings(const IUTFTK& handler, utf_text& text, const NLF_TYPE terminator) noexcept
+{   //  misaligned buffers fail before a span is copied, as the first getNLF() would
+    cp_errors errors = get_errors(text, (handler.unitSize() - 1));
+    if (errors.no_error())
+    {
+        uint8_t sequence[16];
+        uint32_t size = 0;
+        errors |= internal::encodeNLF(handler, terminator, sequence, size);
+        if (errors.no_error() && (size > handler.len(0x000au)))
+        {   //  every line terminator is at least as long as a line-feed, so a longer replacement could overtake the reads
+            errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+        }
+        if (errors.no_error())
+        {
+            utf_text src = text;
+            utf_text dst = text;
+            errors |= internal::normalizeNLF(handler, src, dst, sequence, size);
+            ::memmove(&text.buffer[dst.offset], &text.buffer[src.offset], (text.length - src.offset));
+            text.length -= (src.offset - dst.offset);
+            text.offset = dst.offset;
+        }
+    }
+    return errors;
+}
 
-struct CUTF_JCESU8 : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::JCESU8; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, true, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, true, true, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, true, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, true, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, true, false, true); }
-};
+[[nodiscard]] cp_errors normalizeLineEndings(const IUTFTK& handler, utf_text& src, utf_text& dst, borrow_result& result, const NLF_TYPE terminator) noexcept
+{   //  the source is scanned first, nothing is written unless a line terminator would be changed (misaligned buffers fail before
+    //  anything is scanned or copied, as the first getNLF() would)
+    result.text = dst;
+    result.text.length = dst.offset;
+    result.borrowed = false;
+    cp_errors errors = get_errors(src, (handler.unitSize() - 1));
+    if (errors.no_error())
+    {
+        uint8_t sequence[16];
+        uint32_t size = 0;
+        errors |= internal::encodeNLF(handler, terminator, sequence, size);
+        if (errors.no_error())
+        {
+            cp_errors warnings = cp_errors();
+            const uint32_t verbatim = internal::verbatimNLF(handler, src, sequence, size, warnings);
+            if (verbatim >= src.length)
+            {
+                result.text = src;
+                result.borrowed = true;
+                src.offset = src.length;
+                return warnings;
+            }
+            errors |= get_errors(dst, (handler.unitSize() - 1));
+            if (errors.no_error())
+            {
+                const uint32_t start = src.offset;
+                internal::copyVerbatim(src, dst, verbatim);
+                if (src.offset != start)
+                {   //  the warnings of the code-points copied are reported as normalizeNLF() would
+                    errors |= warnings;
+                }
+                errors |= internal::normalizeNLF(handler, src, dst, sequence, size);
+                result.text.length = dst.offset;
+            }
+        }
+    }
+    else
+    {   //  reported as the copying overload would
+        errors |= get_errors(dst, (handler.unitSize() - 1));
+    }
+    return errors;
+}
 
-struct CUTF_JCESU8ns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::JCESU8ns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, true, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, true, true, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, true, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, true, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, true, false, false); }
-};
+// ==== sanitising transcoder ====
 
-struct CUTF_JCESU8st : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF8; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::JCESU8st; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF8(unicode, true, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF8(text, unicode, bytes, true, true, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF8(text, unicode, bytes, true, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF8(text, count, true, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF8(text, count, true, true, false); }
-};
+[[nodiscard]] cp_errors sanitize(const IUTFTK& srcHandler, const IUTFTK& dstHandler, utf_text& src, utf_text& dst, const sanitize_policy& policy, sanitize_stats* const stats) noexcept
+{   //  clean spans are copied or converted by the bulk kernels, the diagnostic decoder only runs from where they stop
+    sanitize_stats counts = {};
+    cp_errors errors = get_errors(src);
+    errors |= get_errors(dst);
+    if (errors.no_error())
+    {
+        const UTF_SUB_TYPE srcType = srcHandler.utfSubType();
+        const UTF_SUB_TYPE dstType = dstHandler.utfSubType();
+        const uint32_t misaligned = ((src.length | src.offset) & (srcHandler.unitSize() - 1)) | ((dst.length | dst.offset) & (dstHandler.unitSize() - 1));
+        const bool bulk = (internal::hasSanitizeSpan(srcType, dstType) && (misaligned == 0));     //  get() and set() report misaligned buffers
+        internal::sanitize_replacement replacement;
+        internal::encodeReplacement(dstHandler, policy, replacement);
+        internal::sanitize_scan scan = { src.offset, src.offset };
+        while (src.offset < src.length)
+        {
+            if (bulk)
+            {
+                internal::sanitizeSpan(srcType, dstType, src, dst, scan);
+                if (src.offset >= src.length)
+                {
+                    break;
+                }
+            }
+            errors |= internal::sanitizeStep(srcHandler, dstHandler, src, dst, policy, replacement, counts);
+            if (errors.error())
+            {
+                break;
+            }
+        }
+    }
+    if (stats != nullptr)
+    {
+        *stats = counts;
+    }
+    return errors;
+}
 
-struct CUTF_UTF16le : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF16le; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF16le; }
-    virtual uint32_t                unitSize(void) const noexcept { return 2; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF16(unicode, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 2; }
-    virtual uint32_t                lenNull() const noexcept { return 2; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF16(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF16(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_BOM(text, bytes, true); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF16(text, count, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF16(text, count, true, false); }
-};
+[[nodiscard]] cp_errors sanitize(const IUTFTK& handler, utf_text& src, utf_text& dst, borrow_result& result, const sanitize_policy& policy, sanitize_stats* const stats) noexcept
+{   //  the source is validated first, nothing is written unless a code-point would be changed
+    result.text = dst;
+    result.text.length = dst.offset;
+    result.borrowed = false;
+    cp_errors errors = get_errors(src);
+    if (errors.no_error())
+    {
+        const uint32_t verbatim = internal::verbatimSanitize(handler, src, policy);
+        if (verbatim >= src.length)
+        {
+            result.text = src;
+            result.borrowed = true;
+            src.offset = src.length;
+            if (stats != nullptr)
+            {
+                *stats = sanitize_stats();
+            }
+            return errors;
+        }
+        errors |= get_errors(dst);
+        if (errors.no_error())
+        {
+            if (((dst.length | dst.offset) & (handler.unitSize() - 1)) == 0)
+            {   //  set() reports misaligned buffers before anything is written
+                internal::copyVerbatim(src, dst, verbatim);
+            }
+            errors |= sanitize(handler, handler, src, dst, policy, stats);
+            result.text.length = dst.offset;
+            return errors;
+        }
+    }
+    if (stats != nullptr)
+    {
+        *stats = sanitize_stats();
+    }
+    return errors;
+}
 
-struct CUTF_UTF16be : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF16be; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF16be; }
-    virtual uint32_t                unitSize(void) const noexcept { return 2; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF16(unicode, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 2; }
-    virtual uint32_t                lenNull() const noexcept { return 2; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF16(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF16(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_BOM(text, bytes, false); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF16(text, count, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF16(text, count, false, false); }
-};
+// ==== streaming decoder ====
 
-struct CUTF_UCS2le : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF16le; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UCS2le; }
-    virtual uint32_t                unitSize(void) const noexcept { return 2; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF16(unicode, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 2; }
-    virtual uint32_t                lenNull() const noexcept { return 2; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF16(text, unicode, bytes, true, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF16(text, unicode, bytes, true, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_BOM(text, bytes, true); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF16(text, count, true, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF16(text, count, true, true); }
-};
+[[nodiscard]] cp_errors stream_decoder::feed(const uint8_t* const data, const uint32_t size, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& consumed) noexcept
+{
+    return decodeChunk(data, size, false, unicodes, capacity, count, consumed);
+}
 
-struct CUTF_UCS2be : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF16be; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UCS2be; }
-    virtual uint32_t                unitSize(void) const noexcept { return 2; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF16(unicode, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 2; }
-    virtual uint32_t                lenNull() const noexcept { return 2; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF16(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF16(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_BOM(text, bytes, false); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF16_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF16(text, count, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF16(text, count, false, true); }
-};
+[[nodiscard]] cp_errors stream_decoder::feed(const uint8_t* const data, const uint32_t size, const IUTFTK& dstHandler, utf_text& dst, uint32_t& consumed) noexcept
+{
+    return transcodeChunk(data, size, false, dstHandler, dst, consumed);
+}
 
-struct CUTF_UTF32le : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32le; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF32le; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, false, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, true, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, true, false, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, true); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, true, false); }
-};
+[[nodiscard]] cp_errors stream_decoder::finish(unicode_t* const unicodes, const uint32_t capacity, uint32_t& count) noexcept
+{
+    uint32_t consumed = 0;
+    return decodeChunk(nullptr, 0, true, unicodes, capacity, count, consumed);
+}
 
-struct CUTF_UTF32be : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32be; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UTF32be; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, false, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, false, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, false, false, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, false); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, false, false); }
-};
+[[nodiscard]] cp_errors stream_decoder::finish(const IUTFTK& dstHandler, utf_text& dst) noexcept
+{
+    uint32_t consumed = 0;
+    return transcodeChunk(nullptr, 0, true, dstHandler, dst, consumed);
+}
 
-struct CUTF_UCS4le : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32le; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UCS4le; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, false, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, true, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, true, false, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, true); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, true, false); }
-};
+[[nodiscard]] cp_errors stream_decoder::decodeChunk(const uint8_t* const data, const uint32_t size, const bool flush, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& consumed) noexcept
+{   //  reads code-points until the chunk or the output is exhausted accumulating warnings and errors
+    count = 0;
+    consumed = 0;
+    cp_errors errors;
+    if (((data == nullptr) && (size != 0)) || ((unicodes == nullptr) && (capacity != 0)))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
+    }
+    if (errors.no_error())
+    {
+        uint32_t offset = 0;
+        bool failing = false;
+        while (((offset < size) || (flush && (held != 0))) && (count < capacity))
+        {
+            unicode_t unicode = 0;
+            uint32_t bytes = 0;
+            bool hold = false;
+            cp_errors check = peek(data, size, offset, flush, unicode, bytes, hold);
+            if (hold)
+            {   //  the rest of the chunk is held until the next call
+                advance(data, size, offset, bytes, hold);
+                break;
+            }
+            if (check.error() && !failing)
+            {   //  first failing sequence (keep its byte index)
+                failing = true;
+            }
+            else
+            {
+                check.set_byte_index(errors.get_byte_index());
+            }
+            errors |= check;
+            if (bytes == 0)
+            {   //  buffer error
+                break;
+            }
+            unicodes[count] = unicode;
+            ++count;
+            advance(data, size, offset, bytes, hold);
+        }
+        consumed = offset;
+    }
+    return errors;
+}
 
-struct CUTF_UCS4be : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32be; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::UCS4be; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, false, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, false, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, false, false, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, false); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, false, false); }
-};
+[[nodiscard]] cp_errors stream_decoder::transcodeChunk(const uint8_t* const data, const uint32_t size, const bool flush, const IUTFTK& dstHandler, utf_text& dst, uint32_t& consumed) noexcept
+{   //  transcodes code-points until the chunk is exhausted accumulating warnings, stops on any errors
+    consumed = 0;
+    cp_errors errors = get_errors(dst);
+    if ((data == nullptr) && (size != 0))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
+    }
+    if (errors.no_error())
+    {
+        uint32_t offset = 0;
+        while ((offset < size) || (flush && (held != 0)))
+        {
+            unicode_t unicode = 0;
+            uint32_t bytes = 0;
+            bool hold = false;
+            cp_errors check = peek(data, size, offset, flush, unicode, bytes, hold);
+            if (hold)
+            {   //  the rest of the chunk is held until the next call
+                advance(data, size, offset, bytes, hold);
+                break;
+            }
+            errors |= check;
+            if (errors.error())
+            {
+                break;
+            }
+            uint32_t written = 0;
+            errors |= dstHandler.set(dst, unicode, written);
+            if (errors.error())
+            {
+                break;
+            }
+            dst.offset += written;
+            advance(data, size, offset, bytes, hold);
+        }
+        consumed = offset;
+    }
+    return errors;
+}
 
-struct CUTF_CESU32le : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32le; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU32le; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, true, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, true, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, true, true, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, true); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, true, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, true, true); }
-};
+[[nodiscard]] cp_errors stream_decoder::peek(const uint8_t* const data, const uint32_t size, const uint32_t offset, const bool flush, unicode_t& unicode, uint32_t& bytes, bool& hold) const noexcept
+{   //  decodes the next code-point from the held bytes followed by the chunk without changing the state
+    const uint32_t unit = decoder->unitSize();
+    const uint8_t* buffer = &data[offset];
+    uint32_t taken = (size - offset);
+    uint8_t scratch[PendingLimit << 1];
+    if (held != 0)
+    {   //  the held bytes are followed by enough of the chunk for any sequence
+        taken = ((taken < PendingLimit) ? taken : PendingLimit);
+        ::memcpy(scratch, carry, held);
+        if (taken != 0)
+        {
+            ::memcpy(&scratch[held], buffer, taken);
+        }
+        buffer = scratch;
+    }
+    const uint32_t available = (held + taken);
+    const uint32_t limit = (available & ~(unit - 1));
+    cp_errors errors;
+    unicode = 0;
+    bytes = 0;
+    hold = false;
+    if (limit != 0)
+    {
+        const utf_text text = { limit, 0, const_cast<uint8_t*>(buffer) };
+        errors = decoder->get(text, unicode, bytes);
+    }
+    if (!flush && ((offset + taken) == size) && (available <= PendingLimit))
+    {   //  hold a partial code-unit or a sequence that ends with the chunk and could be changed by the next chunk
+        hold = ((limit == 0) || errors.any(cp_errors::bits::ReadTruncated) || errors.any(cp_errors::bits::TruncatedPair) ||
+            ((bytes == limit) && (errors.error() || errors.any(cp_errors::bits::HighSurrogate))));
+    }
+    else if (limit == 0)
+    {   //  partial code-unit at the end of the stream (the returned unicode is the lead byte)
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::ReadTruncated);
+        unicode = static_cast<unicode_t>(buffer[0]);
+        bytes = available;
+    }
+    return errors;
+}
 
-struct CUTF_CESU32be : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32be; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU32be; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, true, false); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, false, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, false, true, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, false); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, false, true); }
-};
+void stream_decoder::advance(const uint8_t* const data, const uint32_t size, uint32_t& offset, const uint32_t bytes, const bool hold) noexcept
+{   //  consumes a sequence returned by peek() or holds the rest of the chunk
+    if (hold)
+    {
+        if (offset < size)
+        {
+            ::memcpy(&carry[held], &data[offset], size - offset);
+            held += (size - offset);
+            offset = size;
+        }
+    }
+    else if (bytes < held)
+    {
+        ::memmove(carry, &carry[bytes], held - bytes);
+        held -= bytes;
+    }
+    else
+    {
+        offset += (bytes - held);
+        held = 0;
+    }
+}
 
-struct CUTF_CESU4le : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32le; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU32le; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, true, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, true, true, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, true, true, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, true); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, true, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, true, true); }
-};
+// ==== streaming encoder ====
 
-struct CUTF_CESU4be : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::UTF32be; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CESU32be; }
-    virtual uint32_t                unitSize(void) const noexcept { return 4; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return lenUTF32(unicode, true, true); }
-    virtual uint32_t                lenBOM() const noexcept { return 4; }
-    virtual uint32_t                lenNull() const noexcept { return 4; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeUTF32(text, unicode, bytes, false, true, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeUTF32(text, unicode, bytes, false, true, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_BOM(text, bytes, false); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF32_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backUTF32(text, count, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepUTF32(text, count, false, true); }
-};
+[[nodiscard]] cp_errors stream_encoder::write(const unicode_t unicode) noexcept
+{   //  writes a code-point to the current segment, moving to the next segment if it does not fit
+    cp_errors errors;
+    if ((segment == nullptr) || (deliver == nullptr))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+    }
+    if (errors.no_error())
+    {
+        utf_text text = { capacity, used, segment };
+        uint32_t bytes = 0;
+        errors = encoder->set(text, unicode, bytes);
+        if (errors.any(cp_errors::bits::WriteOverflow))
+        {
+            if (split)
+            {   //  encode to scratch and fill the rest of the segment, the rest of the sequence goes to the next segments
+                uint8_t scratch[16];
+                utf_text buffer = { 16, 0, scratch };
+                errors = encoder->set(buffer, unicode, bytes);
+                uint32_t copied = 0;
+                while (errors.no_error() && (copied < bytes))
+                {
+                    uint32_t part = (bytes - copied);
+                    part = ((part < (capacity - used)) ? part : (capacity - used));
+                    ::memcpy(&segment[used], &scratch[copied], part);
+                    used += part;
+                    copied += part;
+                    if (used == capacity)
+                    {
+                        errors |= advance();
+                    }
+                }
+                bytes = 0;
+            }
+            else if (used != 0)
+            {   //  hand over the segment short and write to the next segment
+                errors = advance();
+                if (errors.no_error())
+                {
+                    text.offset = 0;
+                    text.buffer = segment;
+                    errors = encoder->set(text, unicode, bytes);
+                }
+            }
+        }
+        if (errors.no_error())
+        {
+            used += bytes;
+            if (used == capacity)
+            {
+                errors |= advance();
+            }
+        }
+    }
+    return errors;
+}
 
-struct CUTF_BYTE : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::BYTE; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x000000ffu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeBYTE(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeBYTE(text, unicode, bytes, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backBYTE(text, count, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepBYTE(text, count, false, true); }
-};
+[[nodiscard]] cp_errors stream_encoder::write(const unicode_t* const unicodes, const uint32_t length, uint32_t& count) noexcept
+{   //  writes blocks of code-points with encodeBlock() falling back to write() at the end of each segment
+    count = 0;
+    cp_errors errors;
+    if ((unicodes == nullptr) && (length != 0))
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::InvalidBuffer);
+    }
+    while (errors.no_error() && (count < length))
+    {
+        cp_errors check;
+        if ((segment != nullptr) && (used < capacity))
+        {
+            utf_text text = { capacity, used, segment };
+            uint32_t encoded = 0;
+            uint32_t bytes = 0;
+            check = encoder->encodeBlock(text, &unicodes[count], length - count, encoded, bytes);
+            used += bytes;
+            count += encoded;
+        }
+        if ((count < length) && (check.no_error() || check.any(cp_errors::bits::WriteOverflow)))
+        {   //  the next code-point does not fit in the rest of the segment
+            errors |= check.warnings_only();
+            check = write(unicodes[count]);
+            if (check.no_error())
+            {
+                ++count;
+            }
+        }
+        errors |= check;
+    }
+    return errors;
+}
 
-struct CUTF_BYTEns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::BYTEns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x000000ffu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeBYTE(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeBYTE(text, unicode, bytes, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backBYTE(text, count, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepBYTE(text, count, false, false); }
-};
+[[nodiscard]] cp_errors stream_encoder::flush() noexcept
+{
+    cp_errors errors;
+    if (used != 0)
+    {
+        errors = advance();
+    }
+    return errors;
+}
 
-struct CUTF_ASCII : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::ASCII; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeBYTE(text, unicode, bytes, true, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeBYTE(text, unicode, bytes, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backBYTE(text, count, true, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepBYTE(text, count, true, true); }
-};
+[[nodiscard]] cp_errors stream_encoder::advance() noexcept
+{   //  hands over the current segment and starts the next one
+    cp_errors errors;
+    segment = deliver(context, segment, used);
+    used = 0;
+    if (segment == nullptr)
+    {
+        errors |= (cp_errors::bits::Failed | cp_errors::bits::WriteOverflow);
+    }
+    return errors;
+}
 
-struct CUTF_ASCIIns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::ASCIIns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 3; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeBYTE(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeBYTE(text, unicode, bytes, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_BOM(text, bytes); }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backBYTE(text, count, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepBYTE(text, count, true, false); }
-};
+// ==== sparse code-point offset index ====
 
-struct CUTF_CP1252 : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CP1252; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 0; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeCP1252(text, unicode, bytes, false, true); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeCP1252(text, unicode, bytes, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { (void)text; bytes = 0; return cp_errors::bits::None; }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backCP1252(text, count, false, true); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepCP1252(text, count, false, true); }
-};
+[[nodiscard]] bool cp_index::build(const utf_text& text) noexcept
+{
+    entries = 0;
+    points = 0;
+    indexed = 0;
+    bool valid = (get_errors(text).no_error() && (offsets != nullptr) && (capacity >= 2));
+    if (valid)
+    {
+        offsets[0] = text.offset;
+        entries = 1;
+        index(text);
+    }
+    return valid;
+}
 
-struct CUTF_CP1252ns : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CP1252ns; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 0; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeCP1252(text, unicode, bytes, false, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeCP1252(text, unicode, bytes, false); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { (void)text; bytes = 0; return cp_errors::bits::None; }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backCP1252(text, count, false, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepCP1252(text, count, false, false); }
-};
+[[nodiscard]] bool cp_index::extend(const utf_text& text) noexcept
+{   //  offsets close to the old end can change when the buffer grows (a truncated sequence or surrogate pair completes)
+    bool valid = ((entries != 0) && get_errors(text).no_error() && (text.offset == offsets[0]) && (text.length >= indexed));
+    if (valid)
+    {
+        while ((entries > 1) && ((offsets[entries - 1] + HoldBack) > indexed))
+        {
+            --entries;
+        }
+        index(text);
+    }
+    return valid;
+}
+
+uint32_t cp_index::seek(utf_text& text, const uint32_t point) const noexcept
+{
+    uint32_t found = 0;
+    if (entries != 0)
+    {
+        uint32_t entry = (point / spacing);
+        entry = ((entry < entries) ? entry : (entries - 1));
+        text.offset = offsets[entry];
+        found = (entry * spacing);
+        found += skip(text, point - found);
+    }
+    return found;
+}
+
+uint32_t cp_index::codePointAt(const utf_text& text, const uint32_t offset) const noexcept
+{
+    uint32_t found = 0;
+    if (entries != 0)
+    {
+        uint32_t lower = 0;
+        uint32_t upper = entries;
+        while ((upper - lower) > 1)
+        {   //  last entry at or before offset
+            const uint32_t middle = ((lower + upper) >> 1);
+            if (offsets[middle] <= offset)
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+        utf_text scan = text;
+        scan.offset = offsets[lower];
+        found = (lower * spacing);
+        while (scan.offset < scan.length)
+        {   //  decode one code-point at a time until the code-point that contains offset
+            unicode_t unicode = 0;
+            uint32_t bytes = 0;
+            static_cast<void>(counter->get(scan, unicode, bytes));
+            if ((bytes == 0) || ((scan.offset + bytes) > offset))
+            {
+                break;
+            }
+            scan.offset += bytes;
+            ++found;
+        }
+    }
+    return found;
+}
+
+void cp_index::index(const utf_text& text) noexcept
+{   //  counts an interval at a time from the last offset, halving the entries when the storage is full
+    utf_text scan = text;
+    scan.offset = offsets[entries - 1];
+    points = ((entries - 1) * spacing);
+    for (;;)
+    {
+        const uint32_t stepped = skip(scan, spacing);
+        points += stepped;
+        if ((stepped < spacing) || (scan.offset >= scan.length))
+        {
+            break;
+        }
+        if (entries == capacity)
+        {   //  keep the even entries and double the interval (capacity is even so the next offset is an even entry)
+            for (uint32_t entry = 1; (entry << 1) < entries; ++entry)
+            {
+                offsets[entry] = offsets[entry << 1];
+            }
+            entries >>= 1;
+            spacing <<= 1;
+        }
+        offsets[entries] = scan.offset;
+        ++entries;
+    }
+    indexed = text.length;
+}
+
+uint32_t cp_index::skip(utf_text& text, const uint32_t count) const noexcept
+{   //  decodes up to count code-points a block at a time, returns the number of code-points decoded
+    unicode_t unicodes[256];
+    uint32_t skipped = 0;
+    while (skipped < count)
+    {
+        const uint32_t capacity = (((count - skipped) < 256) ? (count - skipped) : 256);
+        uint32_t decoded = 0;
+        uint32_t bytes = 0;
+        uint32_t failed = 0;
+        static_cast<void>(counter->decodeBlock(text, unicodes, capacity, decoded, bytes, failed));
+        text.offset += bytes;
+        skipped += decoded;
+        if (decoded < capacity)
+        {
+            break;
+        }
+    }
+    return skipped;
+}
+
+// ==== UTF8 line and UTF16 column position index ====
+
+[[nodiscard]] bool position_index::build(const utf_text& text) noexcept
+{
+    entries = 0;
+    indexed = 0;
+    bool valid = (get_errors(text).no_error() && (anchors != nullptr) && (capacity != 0));
+    if (valid)
+    {
+        anchors[0].offset = text.offset;
+        anchors[0].line = 0;
+        anchors[0].column = 0;
+        entries = 1;
+        valid = index(text, capacity, text.length, 0);
+    }
+    return valid;
+}
+
+[[nodiscard]] bool position_index::update(const utf_text& text, const uint32_t offset, const uint32_t removed, const uint32_t inserted) noexcept
+{   //  the anchors before the edit are kept, the anchors after it are moved to the end of the storage to be re-used when a line start matches
+    bool valid = ((entries != 0) && get_errors(text).no_error() && (text.offset == anchors[0].offset) && (offset >= text.offset) && (offset <= indexed) && (removed <= (indexed - offset)) && (inserted <= text.length) && (text.length == ((indexed - removed) + inserted)));
+    if (valid)
+    {
+        const uint32_t keep = (((offset > anchors[0].offset) ? anchorAt(offset - 1) : 0) + 1);
+        uint32_t first = anchorAt(offset + removed);
+        first += ((anchors[first].offset < (offset + removed)) ? 1 : 0);
+        uint32_t tail = (capacity - (entries - first));
+        if (tail < keep)
+        {   //  the first of the old anchors overlap the kept anchors (resynchronisation at a later line start is just as good)
+            first += (keep - tail);
+            tail = keep;
+        }
+        ::memmove(&anchors[tail], &anchors[first], (capacity - tail) * sizeof(anchor));
+        entries = keep;
+        valid = index(text, tail, (offset + inserted), (inserted - removed));
+    }
+    else
+    {
+        entries = 0;
+        indexed = 0;
+    }
+    return valid;
+}
+
+uint32_t position_index::offsetOf(const utf_text& text, const uint32_t line, const uint32_t column) const noexcept
+{
+    uint32_t offset = text.offset;
+    if (entries != 0)
+    {
+        uint32_t lower = 0;
+        uint32_t upper = entries;
+        while ((upper - lower) > 1)
+        {   //  last anchor at or before {line, column}
+            const uint32_t middle = ((lower + upper) >> 1);
+            if ((anchors[middle].line < line) || ((anchors[middle].line == line) && (anchors[middle].column <= column)))
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+        const anchor& start = anchors[lower];
+        if ((start.line < line) || (start.offset >= text.length))
+        {   //  beyond the last line
+            offset = text.length;
+        }
+        else
+        {
+            uint32_t reached = start.column;
+            offset = internal::columnUTF8(text.buffer, start.offset, text.length, column, text.length, reached);
+        }
+    }
+    return offset;
+}
+
+uint32_t position_index::positionOf(const utf_text& text, const uint32_t offset, uint32_t& line, uint32_t& column) const noexcept
+{
+    uint32_t found = text.offset;
+    line = 0;
+    column = 0;
+    if (entries != 0)
+    {
+        const uint32_t target = ((offset < text.length) ? offset : text.length);
+        const anchor& start = anchors[anchorAt(target)];
+        line = start.line;
+        column = start.column;
+        found = start.offset;
+        if (found < target)
+        {
+            found = internal::columnUTF8(text.buffer, found, target, 0xffffffffu, text.length, column);
+        }
+    }
+    return found;
+}
+
+[[nodiscard]] bool position_index::index(const utf_text& text, uint32_t tail, const uint32_t resume, const uint32_t shift) noexcept
+{   //  scans a line at a time from the last anchor, the old anchors from tail are re-used from the first line start they share
+    const uint8_t* const buffer = text.buffer;
+    const uint32_t end = text.length;
+    uint32_t offset = anchors[entries - 1].offset;
+    uint32_t line = anchors[entries - 1].line;
+    uint32_t column = anchors[entries - 1].column;
+    bool full = false;
+    for (;;)
+    {
+        const uint32_t limit = (offset + simd::findLineBreakUTF8(&buffer[offset], end - offset));
+        while ((limit - offset) > spacing)
+        {   //  anchor long lines at the first lead byte after each interval
+            uint32_t cut = (offset + spacing);
+            while ((cut < limit) && ((buffer[cut] & 0xc0u) == 0x80u))
+            {
+                ++cut;
+            }
+            if (cut == limit)
+            {
+                break;
+            }
+            column += internal::unitsUTF8(&buffer[offset], cut - offset);
+            offset = cut;
+            if (entries == tail)
+            {   //  drop an old anchor to make room (no more old anchors means the storage is full)
+                full = (tail == capacity);
+                if (full)
+                {
+                    break;
+                }
+                ++tail;
+            }
+            anchors[entries].offset = offset;
+            anchors[entries].line = line;
+            anchors[entries].column = column;
+            ++entries;
+        }
+        if (full || (limit == end))
+        {
+            break;
+        }
+        offset = (limit + (((buffer[limit] == 0x0du) && ((limit + 1) < end) && (buffer[limit + 1] == 0x0au)) ? 2 : 1));
+        ++line;
+        column = 0;
+        if (offset >= resume)
+        {
+            while ((tail < capacity) && ((anchors[tail].offset + shift) < offset))
+            {
+                ++tail;
+            }
+            if ((tail < capacity) && ((anchors[tail].offset + shift) == offset) && (anchors[tail].column == 0))
+            {   //  the rest of the text is unchanged, move the old anchors down
+                const uint32_t lines = (line - anchors[tail].line);
+                for (; tail < capacity; ++tail, ++entries)
+                {
+                    anchors[entries].offset = (anchors[tail].offset + shift);
+                    anchors[entries].line = (anchors[tail].line + lines);
+                    anchors[entries].column = anchors[tail].column;
+                }
+                break;
+            }
+        }
+        if (entries == tail)
+        {
+            full = (tail == capacity);
+            if (full)
+            {
+                break;
+            }
+            ++tail;
+        }
+        anchors[entries].offset = offset;
+        anchors[entries].line = line;
+        anchors[entries].column = 0;
+        ++entries;
+    }
+    entries = (full ? 0 : entries);
+    indexed = (full ? 0 : end);
+    return !full;
+}
+
+uint32_t position_index::anchorAt(const uint32_t offset) const noexcept
+{   //  last anchor at or before offset
+    uint32_t lower = 0;
+    uint32_t upper = entries;
+    while ((upper - lower) > 1)
+    {
+        const uint32_t middle = ((lower + upper) >> 1);
+        if (anchors[middle].offset <= offset)
+        {
+            lower = middle;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+    return lower;
+}
+
+// ==== concrete classes for encoded unicode code-point handling ====
 
-struct CUTF_CP1252st : public IUTFTK
-{
-    virtual UTF_TYPE                utfType(void) const noexcept { return UTF_TYPE::OTHER; }
-    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return UTF_SUB_TYPE::CP1252st; }
-    virtual uint32_t                unitSize(void) const noexcept { return 1; }
-    virtual uint32_t                len(const unicode_t unicode) const noexcept { return (static_cast<unicode_t>(unicode & 0x0000007fu) == unicode) ? 1 : 0; }
-    virtual uint32_t                lenBOM() const noexcept { return 0; }
-    virtual uint32_t                lenNull() const noexcept { return 1; }
-    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return decodeCP1252(text, unicode, bytes, true, false); }
-    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return encodeCP1252(text, unicode, bytes, true); }
-    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { (void)text; bytes = 0; return cp_errors::bits::None; }
-    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return encodeUTF8_NULL(text, bytes); }
-    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return backCP1252(text, count, true, false); }
-    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return stepCP1252(text, count, true, false); }
+template<UTF_SUB_TYPE sub_type>
+struct CUTF : public IUTFTK
+{
+    using codec_type = codec<sub_type>;
+    virtual UTF_TYPE                utfType(void) const noexcept { return codec_type::utfType(); }
+    virtual UTF_SUB_TYPE            utfSubType(void) const noexcept { return codec_type::utfSubType(); }
+    virtual uint32_t                unitSize(void) const noexcept { return codec_type::unitSize(); }
+    virtual uint32_t                len(const unicode_t unicode) const noexcept { return codec_type::len(unicode); }
+    virtual uint32_t                lenBOM() const noexcept { return codec_type::lenBOM(); }
+    virtual uint32_t                lenNull() const noexcept { return codec_type::lenNull(); }
+    virtual [[nodiscard]] cp_errors get(const utf_text& text, unicode_t& unicode, uint32_t& bytes) const noexcept { return codec_type::get(text, unicode, bytes); }
+    virtual [[nodiscard]] cp_errors set(utf_text& text, const unicode_t unicode, uint32_t& bytes) const noexcept { return codec_type::set(text, unicode, bytes); }
+    virtual [[nodiscard]] cp_errors setBOM(utf_text& text, uint32_t& bytes) const noexcept { return codec_type::setBOM(text, bytes); }
+    virtual [[nodiscard]] cp_errors setNull(utf_text& text, uint32_t& bytes) const noexcept { return codec_type::setNull(text, bytes); }
+    virtual uint32_t                back(utf_text& text, const uint32_t count) const noexcept { return codec_type::back(text, count); }
+    virtual uint32_t                step(utf_text& text, const uint32_t count) const noexcept { return codec_type::step(text, count); }
+    virtual [[nodiscard]] cp_errors decodeBlock(const utf_text& text, unicode_t* const unicodes, const uint32_t capacity, uint32_t& count, uint32_t& bytes, uint32_t& failed) const noexcept { return internal::decodeBlock<&codec_type::get, (codec_type::unitSize() == 1)>(text, unicodes, capacity, count, bytes, failed); }
+    virtual [[nodiscard]] cp_errors encodeBlock(utf_text& text, const unicode_t* const unicodes, const uint32_t length, uint32_t& count, uint32_t& bytes) const noexcept { return internal::encodeBlock<&codec_type::set>(text, unicodes, length, count, bytes); }
 };
 
 // ==== encoded unicode code-point handler request functions ====
@@ -2916,38 +3991,38 @@ const IUTFTK& IUTFTK::getHandler(const UTF_SUB_TYPE utfSubType) noexcept
 {
     switch (utfSubType)
     {
-        case(UTF_SUB_TYPE::UTF8):       { static const CUTF_UTF8     handler; return handler; }
-        case(UTF_SUB_TYPE::UTF8ns):     { static const CUTF_UTF8ns   handler; return handler; }
-        case(UTF_SUB_TYPE::UTF8st):     { static const CUTF_UTF8st   handler; return handler; }
-        case(UTF_SUB_TYPE::JUTF8):      { static const CUTF_JUTF8    handler; return handler; }
-        case(UTF_SUB_TYPE::JUTF8ns):    { static const CUTF_JUTF8ns  handler; return handler; }
-        case(UTF_SUB_TYPE::JUTF8st):    { static const CUTF_JUTF8st  handler; return handler; }
-        case(UTF_SUB_TYPE::CESU8):      { static const CUTF_CESU8    handler; return handler; }
-        case(UTF_SUB_TYPE::CESU8ns):    { static const CUTF_CESU8ns  handler; return handler; }
-        case(UTF_SUB_TYPE::CESU8st):    { static const CUTF_CESU8st  handler; return handler; }
-        case(UTF_SUB_TYPE::JCESU8):     { static const CUTF_JCESU8   handler; return handler; }
-        case(UTF_SUB_TYPE::JCESU8ns):   { static const CUTF_JCESU8ns handler; return handler; }
-        case(UTF_SUB_TYPE::JCESU8st):   { static const CUTF_JCESU8st handler; return handler; }
-        case(UTF_SUB_TYPE::UTF16le):    { static const CUTF_UTF16le  handler; return handler; }
-        case(UTF_SUB_TYPE::UTF16be):    { static const CUTF_UTF16be  handler; return handler; }
-        case(UTF_SUB_TYPE::UCS2le):     { static const CUTF_UCS2le   handler; return handler; }
-        case(UTF_SUB_TYPE::UCS2be):     { static const CUTF_UCS2be   handler; return handler; }
-        case(UTF_SUB_TYPE::UTF32le):    { static const CUTF_UTF32le  handler; return handler; }
-        case(UTF_SUB_TYPE::UTF32be):    { static const CUTF_UTF32be  handler; return handler; }
-        case(UTF_SUB_TYPE::UCS4le):     { static const CUTF_UCS4le   handler; return handler; }
-        case(UTF_SUB_TYPE::UCS4be):     { static const CUTF_UCS4be   handler; return handler; }
-        case(UTF_SUB_TYPE::CESU32le):   { static const CUTF_CESU32le handler; return handler; }
-        case(UTF_SUB_TYPE::CESU32be):   { static const CUTF_CESU32be handler; return handler; }
-        case(UTF_SUB_TYPE::CESU4le):    { static const CUTF_CESU4le  handler; return handler; }
-        case(UTF_SUB_TYPE::CESU4be):    { static const CUTF_CESU4be  handler; return handler; }
-        case(UTF_SUB_TYPE::BYTE):       { static const CUTF_BYTE     handler; return handler; }
-        case(UTF_SUB_TYPE::BYTEns):     { static const CUTF_BYTEns   handler; return handler; }
-        case(UTF_SUB_TYPE::ASCII):      { static const CUTF_ASCII    handler; return handler; }
-        case(UTF_SUB_TYPE::ASCIIns):    { static const CUTF_ASCIIns  handler; return handler; }
-        case(UTF_SUB_TYPE::CP1252):     { static const CUTF_CP1252   handler; return handler; }
-        case(UTF_SUB_TYPE::CP1252ns):   { static const CUTF_CP1252ns handler; return handler; }
-        case(UTF_SUB_TYPE::CP1252st):   { static const CUTF_CP1252st handler; return handler; }
-        default:                        { static const CUTF_JUTF8st  handler; return handler; }
+        case(UTF_SUB_TYPE::UTF8):       { static const CUTF<UTF_SUB_TYPE::UTF8>     handler; return handler; }
+        case(UTF_SUB_TYPE::UTF8ns):     { static const CUTF<UTF_SUB_TYPE::UTF8ns>   handler; return handler; }
+        case(UTF_SUB_TYPE::UTF8st):     { static const CUTF<UTF_SUB_TYPE::UTF8st>   handler; return handler; }
+        case(UTF_SUB_TYPE::JUTF8):      { static const CUTF<UTF_SUB_TYPE::JUTF8>    handler; return handler; }
+        case(UTF_SUB_TYPE::JUTF8ns):    { static const CUTF<UTF_SUB_TYPE::JUTF8ns>  handler; return handler; }
+        case(UTF_SUB_TYPE::JUTF8st):    { static const CUTF<UTF_SUB_TYPE::JUTF8st>  handler; return handler; }
+        case(UTF_SUB_TYPE::CESU8):      { static const CUTF<UTF_SUB_TYPE::CESU8>    handler; return handler; }
+        case(UTF_SUB_TYPE::CESU8ns):    { static const CUTF<UTF_SUB_TYPE::CESU8ns>  handler; return handler; }
+        case(UTF_SUB_TYPE::CESU8st):    { static const CUTF<UTF_SUB_TYPE::CESU8st>  handler; return handler; }
+        case(UTF_SUB_TYPE::JCESU8):     { static const CUTF<UTF_SUB_TYPE::JCESU8>   handler; return handler; }
+        case(UTF_SUB_TYPE::JCESU8ns):   { static const CUTF<UTF_SUB_TYPE::JCESU8ns> handler; return handler; }
+        case(UTF_SUB_TYPE::JCESU8st):   { static const CUTF<UTF_SUB_TYPE::JCESU8st> handler; return handler; }
+        case(UTF_SUB_TYPE::UTF16le):    { static const CUTF<UTF_SUB_TYPE::UTF16le>  handler; return handler; }
+        case(UTF_SUB_TYPE::UTF16be):    { static const CUTF<UTF_SUB_TYPE::UTF16be>  handler; return handler; }
+        case(UTF_SUB_TYPE::UCS2le):     { static const CUTF<UTF_SUB_TYPE::UCS2le>   handler; return handler; }
+        case(UTF_SUB_TYPE::UCS2be):     { static const CUTF<UTF_SUB_TYPE::UCS2be>   handler; return handler; }
+        case(UTF_SUB_TYPE::UTF32le):    { static const CUTF<UTF_SUB_TYPE::UTF32le>  handler; return handler; }
+        case(UTF_SUB_TYPE::UTF32be):    { static const CUTF<UTF_SUB_TYPE::UTF32be>  handler; return handler; }
+        case(UTF_SUB_TYPE::UCS4le):     { static const CUTF<UTF_SUB_TYPE::UCS4le>   handler; return handler; }
+        case(UTF_SUB_TYPE::UCS4be):     { static const CUTF<UTF_SUB_TYPE::UCS4be>   handler; return handler; }
+        case(UTF_SUB_TYPE::CESU32le):   { static const CUTF<UTF_SUB_TYPE::CESU32le> handler; return handler; }
+        case(UTF_SUB_TYPE::CESU32be):   { static const CUTF<UTF_SUB_TYPE::CESU32be> handler; return handler; }
+        case(UTF_SUB_TYPE::CESU4le):    { static const CUTF<UTF_SUB_TYPE::CESU4le>  handler; return handler; }
+        case(UTF_SUB_TYPE::CESU4be):    { static const CUTF<UTF_SUB_TYPE::CESU4be>  handler; return handler; }
+        case(UTF_SUB_TYPE::BYTE):       { static const CUTF<UTF_SUB_TYPE::BYTE>     handler; return handler; }
+        case(UTF_SUB_TYPE::BYTEns):     { static const CUTF<UTF_SUB_TYPE::BYTEns>   handler; return handler; }
+        case(UTF_SUB_TYPE::ASCII):      { static const CUTF<UTF_SUB_TYPE::ASCII>    handler; return handler; }
+        case(UTF_SUB_TYPE::ASCIIns):    { static const CUTF<UTF_SUB_TYPE::ASCIIns>  handler; return handler; }
+        case(UTF_SUB_TYPE::CP1252):     { static const CUTF<UTF_SUB_TYPE::CP1252>   handler; return handler; }
+        case(UTF_SUB_TYPE::CP1252ns):   { static const CUTF<UTF_SUB_TYPE::CP1252ns> handler; return handler; }
+        case(UTF_SUB_TYPE::CP1252st):   { static const CUTF<UTF_SUB_TYPE::CP1252st> handler; return handler; }
+        default:                        { static const CUTF<UTF_SUB_TYPE::JUTF8st>  handler; return handler; }
     }
 }
 
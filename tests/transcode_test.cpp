@@ -0,0 +1,105 @@
+//  Copyright (c) 2010-2026 Ritchie Brannan
+//  License: MIT (see LICENSE file in repository root)
+//
+//  SuiteUTF
+//
+//  File:   transcode_test.cpp
+//  Author: Ritchie Brannan
+//  Date:   16 Oct 26
+//  
+//  Description:
+//  
+//      Regression test for the multi-threaded transcode() function.
+//  
+//      Every source and destination sub-type pair is transcoded from a text large enough to be split into several chunks,
+//      with 1 thread and with several threads, and the results must be identical byte for byte. The text mixes long ASCII
+//      runs (copied a block at a time by the bulk kernels) with 0x80 to 0xff, the CP1252 code-points above 0xff, the rest
+//      of the BMP and supplementary code-points, so the chunk boundaries fall inside bulk kernel writes.
+//  
+//      Build (with the library sources):
+//  
+//          g++ -std=c++17 -O2 -Iinclude tests/transcode_test.cpp src/utf_toolkit.cpp src/utf_std.cpp src/utf_simd.cpp
+//              src/unicode_utilities.cpp src/unicode_classification.cpp -pthread
+//  
+//      The exit code is the number of pairs with different results.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "utf_toolkit.h"
+
+using unicode::unicode_t;
+using unicode::utf::utf_text;
+using namespace unicode::utf::toolkit;
+
+static uint32_t nextRandom(uint32_t& seed, const uint32_t range) noexcept
+{
+    seed = ((seed * 1664525u) + 1013904223u);
+    return ((seed >> 8) % range);
+}
+
+static unicode_t pick(uint32_t& seed, const uint32_t run) noexcept
+{   //  mostly ASCII runs of varying length separated by other code-points
+    if (run != 0)
+    {
+        return static_cast<unicode_t>(0x20u + nextRandom(seed, 0x5fu));
+    }
+    static const unicode_t others[] = { 0x0080u, 0x0081u, 0x00a0u, 0x00e9u, 0x00ffu, 0x0152u, 0x20acu, 0x2122u, 0x0416u, 0x4e2du, 0xfffdu, 0x1f600u };
+    return others[nextRandom(seed, static_cast<uint32_t>(sizeof(others) / sizeof(others[0])))];
+}
+
+static ::std::vector<uint8_t> generate(const IUTFTK& handler, const uint32_t size, uint32_t seed)
+{   //  encodes code-points with handler until size bytes are written, code-points that are not encoded without errors are skipped
+    ::std::vector<uint8_t> text(size + 16);
+    utf_text fill;
+    fill.length = static_cast<uint32_t>(text.size());
+    fill.offset = 0;
+    fill.buffer = text.data();
+    uint32_t run = 0;
+    while (fill.offset < size)
+    {
+        run = ((run != 0) ? (run - 1) : nextRandom(seed, 48));
+        uint32_t bytes = 0;
+        if (handler.set(fill, pick(seed, run), bytes).no_error())
+        {
+            fill.offset += bytes;
+        }
+    }
+    text.resize(fill.offset);
+    return text;
+}
+
+int main()
+{
+    int failures = 0;
+    const int32_t count = static_cast<int32_t>(UTF_SUB_TYPE::COUNT);
+    for (int32_t srcType = 0; srcType < count; ++srcType)
+    {
+        const IUTFTK& srcHandler = IUTFTK::getHandler(static_cast<UTF_SUB_TYPE>(srcType));
+        ::std::vector<uint8_t> text = generate(srcHandler, (1u << 20), static_cast<uint32_t>(srcType + 1));
+        for (int32_t dstType = 0; dstType < count; ++dstType)
+        {
+            const IUTFTK& dstHandler = IUTFTK::getHandler(static_cast<UTF_SUB_TYPE>(dstType));
+            ::std::vector<uint8_t> expected((text.size() * 4) + 64, 0xeeu);
+            ::std::vector<uint8_t> output(expected.size(), 0xeeu);
+            utf_text serialSrc = { static_cast<uint32_t>(text.size()), 0, text.data() };
+            utf_text serialDst = { static_cast<uint32_t>(expected.size()), 0, expected.data() };
+            const cp_errors serialErrors = transcode(srcHandler, dstHandler, serialSrc, serialDst, 1);
+            for (uint32_t threads = 2; threads <= 8; threads <<= 1)
+            {
+                utf_text src = { static_cast<uint32_t>(text.size()), 0, text.data() };
+                utf_text dst = { static_cast<uint32_t>(output.size()), 0, output.data() };
+                const cp_errors errors = transcode(srcHandler, dstHandler, src, dst, threads);
+                if ((errors.raw() != serialErrors.raw()) || (src.offset != serialSrc.offset) || (dst.offset != serialDst.offset) ||
+                    (::memcmp(output.data(), expected.data(), dst.offset) != 0))
+                {
+                    ::printf("sub-types %d to %d with %u threads: results differ\n", srcType, dstType, threads);
+                    ++failures;
+                    break;
+                }
+            }
+        }
+    }
+    ::printf("%s\n", ((failures == 0) ? "transcode: passed" : "transcode: FAILED"));
+    return failures;
+}